@@ -5,11 +5,18 @@
 
 #include "floppy_float.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
 #include <bit>
 #include <bitset>
 #include <cassert>
 #include <cmath>
 #include <stdexcept>
+#include <utility>
 
 using namespace FfUtils;
 
@@ -36,6 +43,18 @@ constexpr FT FastTwoSum(FT a, FT b, FT c) {
   return r;
 }
 
+// Below this magnitude, the FMA-based residuals of f64 and f128 may not be exact (the residual could be subnormal).
+template <typename FT>
+constexpr FT FmaResidualLimit() {
+  if constexpr (std::is_same_v<FT, f64>) {
+    return 4.008336720017946e-292;  // 2**-968
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    return std::bit_cast<f128>(static_cast<u128>(115) << 112);  // 2**-16268
+  } else {
+    static_assert(false, "Unsupported data type");
+  }
+}
+
 template <typename FT>
 constexpr FT UpMulFma(FT a, FT b, FT c) {
   auto r = std::fma(-a, b, c);
@@ -44,12 +63,12 @@ constexpr FT UpMulFma(FT a, FT b, FT c) {
 
 template <typename FT, FloppyFloat::RoundingMode rm>
 constexpr auto FloppyFloat::UpMul(FT a, FT b, FT& c) {
-  if constexpr (std::is_same_v<FT, f64>) {
-    f64 r;
-    if (std::abs(c) > 4.008336720017946e-292) [[likely]] {
+  if constexpr (std::is_same_v<FT, f64> || std::is_same_v<FT, f128>) {
+    FT r;
+    if (std::abs(c) > FmaResidualLimit<FT>()) [[likely]] {
       r = UpMulFma<FT>(a, b, c);
     } else {
-      r = 0.f64;
+      r = static_cast<FT>(0);
       RmGuard rg(this, rm);
       c = SoftFloat::Mul(a, b);
     }
@@ -71,12 +90,12 @@ constexpr FT UpDivFma(FT a, FT b, FT c) {
 
 template <typename FT, FloppyFloat::RoundingMode rm>
 constexpr auto FloppyFloat::UpDiv(FT a, FT b, FT& c) {
-  if constexpr (std::is_same_v<FT, f64>) {
-    f64 r;
-    if (std::abs(a) > 4.008336720017946e-292) [[likely]] {
+  if constexpr (std::is_same_v<FT, f64> || std::is_same_v<FT, f128>) {
+    FT r;
+    if (std::abs(a) > FmaResidualLimit<FT>()) [[likely]] {
       r = UpDivFma<FT>(a, b, c);
     } else {
-      r = 0.f64;
+      r = static_cast<FT>(0);
       RmGuard rg(this, rm);
       c = SoftFloat::Div(a, b);
     }
@@ -98,12 +117,12 @@ constexpr FT UpSqrtFma(FT a, FT b) {
 
 template <typename FT, FloppyFloat::RoundingMode rm>
 constexpr auto FloppyFloat::UpSqrt(FT a, FT& b) {
-  if constexpr (std::is_same_v<FT, f64>) {
-    f64 r;
-    if (std::abs(a) > 4.008336720017946e-292) [[likely]] {
+  if constexpr (std::is_same_v<FT, f64> || std::is_same_v<FT, f128>) {
+    FT r;
+    if (std::abs(a) > FmaResidualLimit<FT>()) [[likely]] {
       r = UpSqrtFma<FT>(a, b);
     } else {
-      r = 0.f64;
+      r = static_cast<FT>(0);
       RmGuard rg(this, rm);
       b = SoftFloat::Sqrt(a);
     }
@@ -116,12 +135,25 @@ constexpr auto FloppyFloat::UpSqrt(FT a, FT& b) {
   }
 }
 
+// Only an exact zero sum becomes -0 when rounding downward, not a positive result that underflowed to zero.
+// The product is exact in twice the width, and a sum that rounds to zero is exact due to gradual underflow.
+// For f64 and f128, UpFma recomputes the result anyway.
+template <typename FT>
+constexpr bool IsExactZeroFma(FT a, FT b, FT c) {
+  if constexpr (std::is_same_v<FT, f64> || std::is_same_v<FT, f128>) {
+    return true;
+  } else {
+    using TFT = TwiceWidthType<FT>::type;
+    return static_cast<TFT>(a) * static_cast<TFT>(b) + static_cast<TFT>(c) == static_cast<TFT>(0);
+  }
+}
+
 template <typename FT, FloppyFloat::RoundingMode rm>
 constexpr auto FloppyFloat::UpFma(FT a, FT b, FT c, FT& d) {
-  if constexpr (std::is_same_v<FT, f64>) {
+  if constexpr (std::is_same_v<FT, f64> || std::is_same_v<FT, f128>) {
     RmGuard rg(this, rm);
     d = SoftFloat::Fma(a, b, c);
-    return 0.f64;
+    return static_cast<FT>(0);
   } else {
     auto da = static_cast<TwiceWidthType<FT>::type>(a);
     auto db = static_cast<TwiceWidthType<FT>::type>(b);
@@ -140,6 +172,11 @@ void FloppyFloat::SetQnan<f16>(u16 val) {
   qnan16_ = std::bit_cast<f16>(val);
 }
 
+template <>
+void FloppyFloat::SetQnan<bf16>(u16 val) {
+  qnanbf16_ = std::bit_cast<bf16>(val);
+}
+
 template <>
 void FloppyFloat::SetQnan<f32>(u32 val) {
   qnan32_ = std::bit_cast<f32>(val);
@@ -150,11 +187,21 @@ void FloppyFloat::SetQnan<f64>(u64 val) {
   qnan64_ = std::bit_cast<f64>(val);
 }
 
+template <>
+void FloppyFloat::SetQnan<f128>(u128 val) {
+  qnan128_ = std::bit_cast<f128>(val);
+}
+
 template <>
 constexpr f16 FloppyFloat::GetQnan<f16>() {
   return qnan16_;
 }
 
+template <>
+constexpr bf16 FloppyFloat::GetQnan<bf16>() {
+  return qnanbf16_;
+}
+
 template <>
 constexpr f32 FloppyFloat::GetQnan<f32>() {
   return qnan32_;
@@ -165,12 +212,79 @@ constexpr f64 FloppyFloat::GetQnan<f64>() {
   return qnan64_;
 }
 
+template <>
+constexpr f128 FloppyFloat::GetQnan<f128>() {
+  return qnan128_;
+}
+
 FloppyFloat::FloppyFloat() : SoftFloat() {
   SetQnan<f16>(0x7e00u);
+  SetQnan<bf16>(0x7fc0u);
   SetQnan<f32>(0x7fc00000u);
   SetQnan<f64>(0x7ff8000000000000ull);
+  SetQnan<f128>(static_cast<u128>(0x7fff800000000000ull) << 64);
   ClearFlags();
   tininess_before_rounding = false;
+  host_f16_ = DetectHostF16();
+}
+
+FloppyFloat::HostF16 FloppyFloat::DetectHostF16() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();  // Needed if this runs during static initialization, e.g., for a global FloppyFloat object.
+  if (__builtin_cpu_supports("avx512fp16"))
+    return kHostF16Avx512Fp16;
+  if (__builtin_cpu_supports("f16c"))
+    return kHostF16F16c;
+#endif
+  return kHostF16None;
+}
+
+void FloppyFloat::SetHostF16(HostF16 host_f16) {
+  host_f16_ = std::min(host_f16, DetectHostF16());
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// "flatten" inlines the whole operation, so that its f16 arithmetic is compiled to native AVX512-FP16 instructions
+// (e.g., "vaddsh") or to F16C conversions around f32 instructions (e.g., "vcvtph2ps" and "vcvtps2ph").
+template <typename OP>
+[[gnu::target("avx512fp16"), gnu::flatten]] auto CallAvx512Fp16(OP op) {
+  return op();
+}
+
+template <typename OP>
+[[gnu::target("f16c"), gnu::flatten]] auto CallF16c(OP op) {
+  return op();
+}
+
+// std::fma has no f16 overload, so the native FMA ("vfmadd132sh") is called directly.
+[[gnu::target("avx512fp16")]] inline f16 FmaAvx512Fp16(f16 a, f16 b, f16 c) {
+  return _mm_cvtsh_h(_mm_fmadd_sh(_mm_set_sh(a), _mm_set_sh(b), _mm_set_sh(c)));
+}
+#endif
+
+template <typename FT>
+inline FT HostFma(FT a, FT b, FT c) {
+#if defined(__x86_64__) || defined(__i386__)
+  if constexpr (std::is_same_v<FT, f16>)
+    return FmaAvx512Fp16(a, b, c);
+  else
+#endif
+    return std::fma(a, b, c);
+}
+
+template <typename OP>
+auto FloppyFloat::CallHostF16(OP op) {
+#if defined(__x86_64__) || defined(__i386__)
+  switch (host_f16_) {
+  case kHostF16Avx512Fp16:
+    return CallAvx512Fp16(op);
+  case kHostF16F16c:
+    return CallF16c(op);
+  default:
+    break;
+  }
+#endif
+  return op();
 }
 
 template <typename FT, FloppyFloat::RoundingMode rm>
@@ -294,6 +408,8 @@ FT GetRScaled(FT r) {
     r_scaled = r * 16777216.0f32;  // 2**24
   } else if constexpr (std::is_same_v<FT, f64>) {
     r_scaled = r * 9007199254740992.0f64;  // 2**53
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    r_scaled = r * std::bit_cast<f128>(static_cast<u128>(0x4070) << 112);  // 2**113
   } else {
     static_assert(false, "Unsupported data type");
   }
@@ -308,6 +424,8 @@ constexpr FT ResidualLimit() {
     return 20282409603651670423947251286016.f32;  // 2**104
   } else if constexpr (std::is_same_v<FT, f64>) {
     return std::bit_cast<f64>(0x7de0000100000000ull);  // 2**991
+  } else if constexpr (std::is_same_v<FT, f128>) {
+    return std::bit_cast<f128>(static_cast<u128>(0x7f8e) << 112);  // 2**16271
   }
 }
 
@@ -359,9 +477,10 @@ FT FloppyFloat::Add(FT a, FT b) {
 template f16 FloppyFloat::Add<f16>(f16 a, f16 b);
 template f32 FloppyFloat::Add<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Add<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Add<f128>(f128 a, f128 b);
 
 template <typename FT, FloppyFloat::RoundingMode rm>
-FT FloppyFloat::Add(FT a, FT b) {
+FT FloppyFloat::AddImpl(FT a, FT b) {
   FT c = a + b;
 
   if (IsInfOrNan(c)) [[unlikely]] {
@@ -426,6 +545,14 @@ FT FloppyFloat::Add(FT a, FT b) {
   return c;
 }
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::Add(FT a, FT b) {
+  if constexpr (std::is_same_v<FT, f16>)
+    return CallHostF16([&] { return AddImpl<FT, rm>(a, b); });
+  else
+    return AddImpl<FT, rm>(a, b);
+}
+
 template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
 template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b);
 template f16 FloppyFloat::Add<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
@@ -444,6 +571,12 @@ template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
 template f64 FloppyFloat::Add<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
 
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 FloppyFloat::Add<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b);
+
 template <typename FT>
 FT FloppyFloat::Sub(FT a, FT b) {
   switch (rounding_mode) {
@@ -465,9 +598,10 @@ FT FloppyFloat::Sub(FT a, FT b) {
 template f16 FloppyFloat::Sub<f16>(f16 a, f16 b);
 template f32 FloppyFloat::Sub<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Sub<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Sub<f128>(f128 a, f128 b);
 
 template <typename FT, FloppyFloat::RoundingMode rm>
-FT FloppyFloat::Sub(FT a, FT b) {
+FT FloppyFloat::SubImpl(FT a, FT b) {
   FT c = a - b;
 
   if (IsInfOrNan(c)) [[unlikely]] {
@@ -532,6 +666,14 @@ FT FloppyFloat::Sub(FT a, FT b) {
   return c;
 }
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::Sub(FT a, FT b) {
+  if constexpr (std::is_same_v<FT, f16>)
+    return CallHostF16([&] { return SubImpl<FT, rm>(a, b); });
+  else
+    return SubImpl<FT, rm>(a, b);
+}
+
 template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
 template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b);
 template f16 FloppyFloat::Sub<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
@@ -550,6 +692,12 @@ template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
 template f64 FloppyFloat::Sub<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
 
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 FloppyFloat::Sub<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b);
+
 template <typename FT>
 FT FloppyFloat::Mul(FT a, FT b) {
   switch (rounding_mode) {
@@ -571,9 +719,10 @@ FT FloppyFloat::Mul(FT a, FT b) {
 template f16 FloppyFloat::Mul<f16>(f16 a, f16 b);
 template f32 FloppyFloat::Mul<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Mul<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Mul<f128>(f128 a, f128 b);
 
 template <typename FT, FloppyFloat::RoundingMode rm>
-FT FloppyFloat::Mul(FT a, FT b) {
+FT FloppyFloat::MulImpl(FT a, FT b) {
   if constexpr (rm == kRoundTiesToAway) {
     RmGuard rg(this, rm);
     return SoftFloat::Mul<FT>(a, b);
@@ -618,7 +767,7 @@ FT FloppyFloat::Mul(FT a, FT b) {
     auto r = UpMul<FT, rm>(a, b, c);
     if (!IsZero(r)) {
       SetInexact();
-      c = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, c);
+      c = RoundResult<FT, decltype(r), rm>(r, c);
       if (!underflow && MayResultFromUnderflow(c)) [[unlikely]] {
         if (IsTiny(c)) [[likely]] {
           if (!IsZero(r))
@@ -633,6 +782,14 @@ FT FloppyFloat::Mul(FT a, FT b) {
   return c;
 }
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::Mul(FT a, FT b) {
+  if constexpr (std::is_same_v<FT, f16>)
+    return CallHostF16([&] { return MulImpl<FT, rm>(a, b); });
+  else
+    return MulImpl<FT, rm>(a, b);
+}
+
 template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
 template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b);
 template f16 FloppyFloat::Mul<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
@@ -651,6 +808,12 @@ template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
 template f64 FloppyFloat::Mul<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
 
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 FloppyFloat::Mul<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b);
+
 template <typename FT>
 FT FloppyFloat::Div(FT a, FT b) {
   switch (rounding_mode) {
@@ -672,9 +835,10 @@ FT FloppyFloat::Div(FT a, FT b) {
 template f16 FloppyFloat::Div<f16>(f16 a, f16 b);
 template f32 FloppyFloat::Div<f32>(f32 a, f32 b);
 template f64 FloppyFloat::Div<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Div<f128>(f128 a, f128 b);
 
 template <typename FT, FloppyFloat::RoundingMode rm>
-FT FloppyFloat::Div(FT a, FT b) {
+FT FloppyFloat::DivImpl(FT a, FT b) {
   if constexpr (rm == kRoundTiesToAway) {
     RmGuard rg(this, rm);
     return SoftFloat::Div<FT>(a, b);
@@ -726,7 +890,7 @@ FT FloppyFloat::Div(FT a, FT b) {
     auto r = UpDiv<FT, rm>(a, b, c);
     if (!IsZero(r)) {
       SetInexact();
-      c = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, c);
+      c = RoundResult<FT, decltype(r), rm>(r, c);
       if (!underflow && MayResultFromUnderflow(c)) [[unlikely]] {
         if (IsTiny(c)) [[likely]] {
           if (!IsZero(r))
@@ -742,6 +906,14 @@ FT FloppyFloat::Div(FT a, FT b) {
   return c;
 }
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::Div(FT a, FT b) {
+  if constexpr (std::is_same_v<FT, f16>)
+    return CallHostF16([&] { return DivImpl<FT, rm>(a, b); });
+  else
+    return DivImpl<FT, rm>(a, b);
+}
+
 template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b);
 template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b);
 template f16 FloppyFloat::Div<f16, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b);
@@ -760,6 +932,12 @@ template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b);
 template f64 FloppyFloat::Div<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b);
 
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b);
+template f128 FloppyFloat::Div<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b);
+
 template <typename FT>
 FT FloppyFloat::Sqrt(FT a) {
   switch (rounding_mode) {
@@ -781,9 +959,10 @@ FT FloppyFloat::Sqrt(FT a) {
 template f16 FloppyFloat::Sqrt<f16>(f16 a);
 template f32 FloppyFloat::Sqrt<f32>(f32 a);
 template f64 FloppyFloat::Sqrt<f64>(f64 a);
+template f128 FloppyFloat::Sqrt<f128>(f128 a);
 
 template <typename FT, FloppyFloat::RoundingMode rm>
-FT FloppyFloat::Sqrt(FT a) {
+FT FloppyFloat::SqrtImpl(FT a) {
   if constexpr (rm == kRoundTiesToAway) {
     RmGuard rg(this, rm);
     return SoftFloat::Sqrt(a);
@@ -814,13 +993,21 @@ FT FloppyFloat::Sqrt(FT a) {
     auto r = UpSqrt<FT, rm>(a, b);
     if (!IsZero(r)) {
       SetInexact();
-      b = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, b);
+      b = RoundResult<FT, decltype(r), rm>(r, b);
     }
   }
 
   return b;
 }
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::Sqrt(FT a) {
+  if constexpr (std::is_same_v<FT, f16>)
+    return CallHostF16([&] { return SqrtImpl<FT, rm>(a); });
+  else
+    return SqrtImpl<FT, rm>(a);
+}
+
 template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTiesToEven>(f16 a);
 template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardPositive>(f16 a);
 template f16 FloppyFloat::Sqrt<f16, FloppyFloat::kRoundTowardNegative>(f16 a);
@@ -839,6 +1026,12 @@ template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardNegative>(f64 a);
 template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTowardZero>(f64 a);
 template f64 FloppyFloat::Sqrt<f64, FloppyFloat::kRoundTiesToAway>(f64 a);
 
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToEven>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardPositive>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardNegative>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTowardZero>(f128 a);
+template f128 FloppyFloat::Sqrt<f128, FloppyFloat::kRoundTiesToAway>(f128 a);
+
 template <typename FT>
 FT FloppyFloat::Fma(FT a, FT b, FT c) {
   switch (rounding_mode) {
@@ -860,16 +1053,29 @@ FT FloppyFloat::Fma(FT a, FT b, FT c) {
 template f16 FloppyFloat::Fma<f16>(f16 a, f16 b, f16 c);
 template f32 FloppyFloat::Fma<f32>(f32 a, f32 b, f32 c);
 template f64 FloppyFloat::Fma<f64>(f64 a, f64 b, f64 c);
+template f128 FloppyFloat::Fma<f128>(f128 a, f128 b, f128 c);
 
 template <typename FT, FloppyFloat::RoundingMode rm>
 FT FloppyFloat::Fma(FT a, FT b, FT c) {
-  if constexpr (std::is_same_v<FT, f16> || (rm == kRoundTiesToAway)) {
-    // TODO: Remove once the f16 FMA issue of the standard library is solved.
+  if constexpr (rm == kRoundTiesToAway) {
+    RmGuard rg(this, rm);
+    return SoftFloat::Fma<FT>(a, b, c);
+  } else if constexpr (std::is_same_v<FT, f16>) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (host_f16_ == kHostF16Avx512Fp16)
+      return CallAvx512Fp16([&] { return FmaImpl<FT, rm>(a, b, c); });
+#endif
+    // Without a native f16 FMA, the f16 FMA is emulated in f32 with double rounding, so use the soft float.
     RmGuard rg(this, rm);
     return SoftFloat::Fma<FT>(a, b, c);
+  } else {
+    return FmaImpl<FT, rm>(a, b, c);
   }
+}
 
-  FT d = std::fma(a, b, c);
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::FmaImpl(FT a, FT b, FT c) {
+  FT d = HostFma(a, b, c);
 
   if (IsInfOrNan(d)) [[unlikely]] {
     if (IsInf(d)) {
@@ -897,7 +1103,7 @@ FT FloppyFloat::Fma(FT a, FT b, FT c) {
 
   if constexpr (rm == kRoundTowardNegative) {
     if (IsZero(d) && !std::signbit(d)) [[unlikely]] {
-      if ((std::signbit(a) != std::signbit(b)) || std::signbit(c))
+      if (((std::signbit(a) != std::signbit(b)) || std::signbit(c)) && IsExactZeroFma(a, b, c))
         d = -d;
     }
   }
@@ -918,7 +1124,7 @@ FT FloppyFloat::Fma(FT a, FT b, FT c) {
     auto r = UpFma<FT, rm>(a, b, c, d);
     if (!IsZero(r)) {
       SetInexact();
-      d = RoundResult<FT, typename TwiceWidthType<FT>::type, rm>(r, d);
+      d = RoundResult<FT, decltype(r), rm>(r, d);
       if (!underflow && MayResultFromUnderflow(d)) [[unlikely]] {
         if (IsTiny(d)) [[likely]] {
           if (!IsZero(r))
@@ -952,6 +1158,773 @@ template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardNegative>(f64 a, f64
 template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTowardZero>(f64 a, f64 b, f64 c);
 template f64 FloppyFloat::Fma<f64, FloppyFloat::kRoundTiesToAway>(f64 a, f64 b, f64 c);
 
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToEven>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardPositive>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardNegative>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTowardZero>(f128 a, f128 b, f128 c);
+template f128 FloppyFloat::Fma<f128, FloppyFloat::kRoundTiesToAway>(f128 a, f128 b, f128 c);
+
+// Widens without quieting signaling NaNs (unlike a host conversion), so that they still raise invalid later on.
+// Half-precision inputs are widened with integer operations, since their host conversions are libgcc calls without
+// F16C. The significand of an f16 is shifted into place and scaled by 2**(127 - 15), which also normalizes subnormals.
+template <typename FTIN, typename FTACC>
+constexpr FTACC WidenExact(FTIN a) {
+  if constexpr (std::is_same_v<FTIN, bf16>) {
+    static_assert(std::is_same_v<FTACC, f32>);
+    return std::bit_cast<f32>(static_cast<u32>(std::bit_cast<u16>(a)) << 16);
+  } else if constexpr (std::is_same_v<FTIN, f16>) {
+    static_assert(std::is_same_v<FTACC, f32>);
+    u32 bits = std::bit_cast<u16>(a);
+    u32 sign = (bits & 0x8000u) << 16;
+    u32 mag = (bits & 0x7fffu) << 13;
+    if ((bits & 0x7c00u) == 0x7c00u) [[unlikely]]
+      return std::bit_cast<f32>(sign | 0x7f800000u | mag);
+    return std::bit_cast<f32>(sign | std::bit_cast<u32>(std::bit_cast<f32>(mag) * 0x1p112f));
+  } else {
+    if (!IsNan(a)) [[likely]]
+      return static_cast<FTACC>(a);
+    using UTIN = typename FloatToUint<FTIN>::type;
+    using UTACC = typename FloatToUint<FTACC>::type;
+    constexpr int kShift = NumSignificandBits<FTACC>() - NumSignificandBits<FTIN>();
+    UTACC sign = std::signbit(a) ? SignMask<FTACC>() : 0;
+    UTACC sig = static_cast<UTACC>(std::bit_cast<UTIN>(a) & MaxSignificand<FTIN>()) << kShift;
+    return std::bit_cast<FTACC>(static_cast<UTACC>(sign | ExponentMask<FTACC>() | sig));
+  }
+}
+
+// The product of two FTIN values is exact in FTACC if FTACC holds twice the significand bits and the smallest
+// (subnormal) and largest products are still normal.
+template <typename FTIN, typename FTACC>
+constexpr bool IsProductExact() {
+  constexpr int kMinExp = 2 * (1 - Bias<FTIN>() - NumSignificandBits<FTIN>());
+  constexpr int kMaxExp = 2 * (Bias<FTIN>() + 1);
+  return 2 * (NumSignificandBits<FTIN>() + 1) <= NumSignificandBits<FTACC>() + 1 && kMinExp >= 1 - Bias<FTACC>() &&
+         kMaxExp <= Bias<FTACC>();
+}
+
+template <typename FTIN, typename FTACC>
+FTACC FloppyFloat::FmaWiden(FTIN a, FTIN b, FTACC c) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FmaWiden<FTIN, FTACC, kRoundTiesToEven>(a, b, c);
+  case kRoundTiesToAway:
+    return FmaWiden<FTIN, FTACC, kRoundTiesToAway>(a, b, c);
+  case kRoundTowardPositive:
+    return FmaWiden<FTIN, FTACC, kRoundTowardPositive>(a, b, c);
+  case kRoundTowardNegative:
+    return FmaWiden<FTIN, FTACC, kRoundTowardNegative>(a, b, c);
+  case kRoundTowardZero:
+    return FmaWiden<FTIN, FTACC, kRoundTowardZero>(a, b, c);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f32 FloppyFloat::FmaWiden<f16, f32>(f16 a, f16 b, f32 c);
+template f32 FloppyFloat::FmaWiden<bf16, f32>(bf16 a, bf16 b, f32 c);
+template f64 FloppyFloat::FmaWiden<f32, f64>(f32 a, f32 b, f64 c);
+
+// If the product is exact, the FMA is an addition, which is cheaper to check for exactness than an FMA. NaN products
+// (NaN operands and ∞ × 0) take the FMA path for its NaN propagation and invalid_fma.
+template <typename FTIN, typename FTACC, FloppyFloat::RoundingMode rm>
+FTACC FloppyFloat::FmaWiden(FTIN a, FTIN b, FTACC c) {
+  FTACC wa = WidenExact<FTIN, FTACC>(a);
+  FTACC wb = WidenExact<FTIN, FTACC>(b);
+  if constexpr (IsProductExact<FTIN, FTACC>()) {
+    FTACC p = wa * wb;
+    if (!IsNan(p)) [[likely]]
+      return AddImpl<FTACC, rm>(p, c);
+  }
+  return Fma<FTACC, rm>(wa, wb, c);
+}
+
+template f32 FloppyFloat::FmaWiden<f16, f32, FloppyFloat::kRoundTiesToEven>(f16 a, f16 b, f32 c);
+template f32 FloppyFloat::FmaWiden<f16, f32, FloppyFloat::kRoundTowardPositive>(f16 a, f16 b, f32 c);
+template f32 FloppyFloat::FmaWiden<f16, f32, FloppyFloat::kRoundTowardNegative>(f16 a, f16 b, f32 c);
+template f32 FloppyFloat::FmaWiden<f16, f32, FloppyFloat::kRoundTowardZero>(f16 a, f16 b, f32 c);
+template f32 FloppyFloat::FmaWiden<f16, f32, FloppyFloat::kRoundTiesToAway>(f16 a, f16 b, f32 c);
+
+template f32 FloppyFloat::FmaWiden<bf16, f32, FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b, f32 c);
+template f32 FloppyFloat::FmaWiden<bf16, f32, FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b, f32 c);
+template f32 FloppyFloat::FmaWiden<bf16, f32, FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b, f32 c);
+template f32 FloppyFloat::FmaWiden<bf16, f32, FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b, f32 c);
+template f32 FloppyFloat::FmaWiden<bf16, f32, FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b, f32 c);
+
+template f64 FloppyFloat::FmaWiden<f32, f64, FloppyFloat::kRoundTiesToEven>(f32 a, f32 b, f64 c);
+template f64 FloppyFloat::FmaWiden<f32, f64, FloppyFloat::kRoundTowardPositive>(f32 a, f32 b, f64 c);
+template f64 FloppyFloat::FmaWiden<f32, f64, FloppyFloat::kRoundTowardNegative>(f32 a, f32 b, f64 c);
+template f64 FloppyFloat::FmaWiden<f32, f64, FloppyFloat::kRoundTowardZero>(f32 a, f32 b, f64 c);
+template f64 FloppyFloat::FmaWiden<f32, f64, FloppyFloat::kRoundTiesToAway>(f32 a, f32 b, f64 c);
+
+f32 FloppyFloat::FmaBF16(bf16 a, bf16 b, f32 c) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FmaBF16<kRoundTiesToEven>(a, b, c);
+  case kRoundTiesToAway:
+    return FmaBF16<kRoundTiesToAway>(a, b, c);
+  case kRoundTowardPositive:
+    return FmaBF16<kRoundTowardPositive>(a, b, c);
+  case kRoundTowardNegative:
+    return FmaBF16<kRoundTowardNegative>(a, b, c);
+  case kRoundTowardZero:
+    return FmaBF16<kRoundTowardZero>(a, b, c);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm>
+f32 FloppyFloat::FmaBF16(bf16 a, bf16 b, f32 c) {
+  return FmaWiden<bf16, f32, rm>(a, b, c);
+}
+
+template f32 FloppyFloat::FmaBF16<FloppyFloat::kRoundTiesToEven>(bf16 a, bf16 b, f32 c);
+template f32 FloppyFloat::FmaBF16<FloppyFloat::kRoundTowardPositive>(bf16 a, bf16 b, f32 c);
+template f32 FloppyFloat::FmaBF16<FloppyFloat::kRoundTowardNegative>(bf16 a, bf16 b, f32 c);
+template f32 FloppyFloat::FmaBF16<FloppyFloat::kRoundTowardZero>(bf16 a, bf16 b, f32 c);
+template f32 FloppyFloat::FmaBF16<FloppyFloat::kRoundTiesToAway>(bf16 a, bf16 b, f32 c);
+
+// Rounding the exact result toward zero and setting its last bit if inexact rounds it to odd. Rounding that again to a
+// format with at least two bits less precision is correct in every rounding mode (see S. Boldo and G. Melquiond,
+// "Emulation of FMA and Correctly Rounded Sums: Proved Algorithms Using Rounding to Odd"). Products and quotients of
+// operands with at most 10 exponent bits can still overflow or underflow in f64, but the exponent limit puts FT's
+// largest finite value (< 2^512) and smallest subnormal (>= 2^-560) far inside f64's normal range. An f64 overflow
+// leaves the largest f64, which is odd and overflows FT like the exact result. An f64 underflow leaves a nonzero value
+// of the right sign (the set last bit keeps it from vanishing) far below half of FT's smallest subnormal, which rounds
+// like the exact result too. The f64 flags are discarded, so only the final rounding sets overflow, underflow, and
+// inexact.
+template <typename FT, FloppyFloat::RoundingMode rm, typename OP>
+FT FloppyFloat::RoundViaF64(OP op) {
+  static_assert(NumExponentBits<FT>() <= 10 && NumSignificandBits<FT>() <= 50);
+  bool old_overflow = overflow;
+  bool old_underflow = underflow;
+  bool old_inexact = inexact;
+  inexact = false;
+  f64 r = op();
+  if (inexact)
+    r = std::bit_cast<f64>(std::bit_cast<u64>(r) | 1ull);
+  overflow = old_overflow;
+  underflow = old_underflow;
+  inexact = old_inexact;
+  RmGuard rg(this, rm);
+  return FToF<f64, FT>(r);
+}
+
+template <typename FT>
+FT FloppyFloat::FormatAdd(FT a, FT b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FormatAdd<FT, kRoundTiesToEven>(a, b);
+  case kRoundTiesToAway:
+    return FormatAdd<FT, kRoundTiesToAway>(a, b);
+  case kRoundTowardPositive:
+    return FormatAdd<FT, kRoundTowardPositive>(a, b);
+  case kRoundTowardNegative:
+    return FormatAdd<FT, kRoundTowardNegative>(a, b);
+  case kRoundTowardZero:
+    return FormatAdd<FT, kRoundTowardZero>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template tf32 FloppyFloat::FormatAdd<tf32>(tf32 a, tf32 b);
+template dlf16 FloppyFloat::FormatAdd<dlf16>(dlf16 a, dlf16 b);
+
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::FormatAdd(FT a, FT b) {
+  f64 da = WidenToF64(a);
+  f64 db = WidenToF64(b);
+  return RoundViaF64<FT, rm>([&] {
+    f64 r = Add<f64, kRoundTowardZero>(da, db);
+    if constexpr (rm == kRoundTowardNegative) {  // See: IEEE 754-2019: 6.3 The sign bit
+      if (IsPosZero(r) && (IsNeg(da) || IsNeg(db)))
+        r = -r;
+    }
+    return r;
+  });
+}
+
+template tf32 FloppyFloat::FormatAdd<tf32, FloppyFloat::kRoundTiesToEven>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatAdd<tf32, FloppyFloat::kRoundTowardPositive>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatAdd<tf32, FloppyFloat::kRoundTowardNegative>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatAdd<tf32, FloppyFloat::kRoundTowardZero>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatAdd<tf32, FloppyFloat::kRoundTiesToAway>(tf32 a, tf32 b);
+
+template dlf16 FloppyFloat::FormatAdd<dlf16, FloppyFloat::kRoundTiesToEven>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatAdd<dlf16, FloppyFloat::kRoundTowardPositive>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatAdd<dlf16, FloppyFloat::kRoundTowardNegative>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatAdd<dlf16, FloppyFloat::kRoundTowardZero>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatAdd<dlf16, FloppyFloat::kRoundTiesToAway>(dlf16 a, dlf16 b);
+
+template <typename FT>
+FT FloppyFloat::FormatSub(FT a, FT b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FormatSub<FT, kRoundTiesToEven>(a, b);
+  case kRoundTiesToAway:
+    return FormatSub<FT, kRoundTiesToAway>(a, b);
+  case kRoundTowardPositive:
+    return FormatSub<FT, kRoundTowardPositive>(a, b);
+  case kRoundTowardNegative:
+    return FormatSub<FT, kRoundTowardNegative>(a, b);
+  case kRoundTowardZero:
+    return FormatSub<FT, kRoundTowardZero>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template tf32 FloppyFloat::FormatSub<tf32>(tf32 a, tf32 b);
+template dlf16 FloppyFloat::FormatSub<dlf16>(dlf16 a, dlf16 b);
+
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::FormatSub(FT a, FT b) {
+  f64 da = WidenToF64(a);
+  f64 db = WidenToF64(b);
+  return RoundViaF64<FT, rm>([&] {
+    f64 r = Sub<f64, kRoundTowardZero>(da, db);
+    if constexpr (rm == kRoundTowardNegative) {  // See: IEEE 754-2019: 6.3 The sign bit
+      if (IsPosZero(r) && (IsNeg(da) || IsPos(db)))
+        r = -r;
+    }
+    return r;
+  });
+}
+
+template tf32 FloppyFloat::FormatSub<tf32, FloppyFloat::kRoundTiesToEven>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatSub<tf32, FloppyFloat::kRoundTowardPositive>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatSub<tf32, FloppyFloat::kRoundTowardNegative>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatSub<tf32, FloppyFloat::kRoundTowardZero>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatSub<tf32, FloppyFloat::kRoundTiesToAway>(tf32 a, tf32 b);
+
+template dlf16 FloppyFloat::FormatSub<dlf16, FloppyFloat::kRoundTiesToEven>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatSub<dlf16, FloppyFloat::kRoundTowardPositive>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatSub<dlf16, FloppyFloat::kRoundTowardNegative>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatSub<dlf16, FloppyFloat::kRoundTowardZero>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatSub<dlf16, FloppyFloat::kRoundTiesToAway>(dlf16 a, dlf16 b);
+
+template <typename FT>
+FT FloppyFloat::FormatMul(FT a, FT b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FormatMul<FT, kRoundTiesToEven>(a, b);
+  case kRoundTiesToAway:
+    return FormatMul<FT, kRoundTiesToAway>(a, b);
+  case kRoundTowardPositive:
+    return FormatMul<FT, kRoundTowardPositive>(a, b);
+  case kRoundTowardNegative:
+    return FormatMul<FT, kRoundTowardNegative>(a, b);
+  case kRoundTowardZero:
+    return FormatMul<FT, kRoundTowardZero>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template tf32 FloppyFloat::FormatMul<tf32>(tf32 a, tf32 b);
+template dlf16 FloppyFloat::FormatMul<dlf16>(dlf16 a, dlf16 b);
+
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::FormatMul(FT a, FT b) {
+  f64 da = WidenToF64(a);
+  f64 db = WidenToF64(b);
+  return RoundViaF64<FT, rm>([&] { return Mul<f64, kRoundTowardZero>(da, db); });
+}
+
+template tf32 FloppyFloat::FormatMul<tf32, FloppyFloat::kRoundTiesToEven>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatMul<tf32, FloppyFloat::kRoundTowardPositive>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatMul<tf32, FloppyFloat::kRoundTowardNegative>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatMul<tf32, FloppyFloat::kRoundTowardZero>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatMul<tf32, FloppyFloat::kRoundTiesToAway>(tf32 a, tf32 b);
+
+template dlf16 FloppyFloat::FormatMul<dlf16, FloppyFloat::kRoundTiesToEven>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatMul<dlf16, FloppyFloat::kRoundTowardPositive>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatMul<dlf16, FloppyFloat::kRoundTowardNegative>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatMul<dlf16, FloppyFloat::kRoundTowardZero>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatMul<dlf16, FloppyFloat::kRoundTiesToAway>(dlf16 a, dlf16 b);
+
+template <typename FT>
+FT FloppyFloat::FormatDiv(FT a, FT b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FormatDiv<FT, kRoundTiesToEven>(a, b);
+  case kRoundTiesToAway:
+    return FormatDiv<FT, kRoundTiesToAway>(a, b);
+  case kRoundTowardPositive:
+    return FormatDiv<FT, kRoundTowardPositive>(a, b);
+  case kRoundTowardNegative:
+    return FormatDiv<FT, kRoundTowardNegative>(a, b);
+  case kRoundTowardZero:
+    return FormatDiv<FT, kRoundTowardZero>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template tf32 FloppyFloat::FormatDiv<tf32>(tf32 a, tf32 b);
+template dlf16 FloppyFloat::FormatDiv<dlf16>(dlf16 a, dlf16 b);
+
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::FormatDiv(FT a, FT b) {
+  f64 da = WidenToF64(a);
+  f64 db = WidenToF64(b);
+  return RoundViaF64<FT, rm>([&] { return Div<f64, kRoundTowardZero>(da, db); });
+}
+
+template tf32 FloppyFloat::FormatDiv<tf32, FloppyFloat::kRoundTiesToEven>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatDiv<tf32, FloppyFloat::kRoundTowardPositive>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatDiv<tf32, FloppyFloat::kRoundTowardNegative>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatDiv<tf32, FloppyFloat::kRoundTowardZero>(tf32 a, tf32 b);
+template tf32 FloppyFloat::FormatDiv<tf32, FloppyFloat::kRoundTiesToAway>(tf32 a, tf32 b);
+
+template dlf16 FloppyFloat::FormatDiv<dlf16, FloppyFloat::kRoundTiesToEven>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatDiv<dlf16, FloppyFloat::kRoundTowardPositive>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatDiv<dlf16, FloppyFloat::kRoundTowardNegative>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatDiv<dlf16, FloppyFloat::kRoundTowardZero>(dlf16 a, dlf16 b);
+template dlf16 FloppyFloat::FormatDiv<dlf16, FloppyFloat::kRoundTiesToAway>(dlf16 a, dlf16 b);
+
+template <typename FT>
+FT FloppyFloat::FormatSqrt(FT a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FormatSqrt<FT, kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return FormatSqrt<FT, kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return FormatSqrt<FT, kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return FormatSqrt<FT, kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return FormatSqrt<FT, kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template tf32 FloppyFloat::FormatSqrt<tf32>(tf32 a);
+template dlf16 FloppyFloat::FormatSqrt<dlf16>(dlf16 a);
+
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::FormatSqrt(FT a) {
+  f64 da = WidenToF64(a);
+  return RoundViaF64<FT, rm>([&] { return Sqrt<f64, kRoundTowardZero>(da); });
+}
+
+template tf32 FloppyFloat::FormatSqrt<tf32, FloppyFloat::kRoundTiesToEven>(tf32 a);
+template tf32 FloppyFloat::FormatSqrt<tf32, FloppyFloat::kRoundTowardPositive>(tf32 a);
+template tf32 FloppyFloat::FormatSqrt<tf32, FloppyFloat::kRoundTowardNegative>(tf32 a);
+template tf32 FloppyFloat::FormatSqrt<tf32, FloppyFloat::kRoundTowardZero>(tf32 a);
+template tf32 FloppyFloat::FormatSqrt<tf32, FloppyFloat::kRoundTiesToAway>(tf32 a);
+
+template dlf16 FloppyFloat::FormatSqrt<dlf16, FloppyFloat::kRoundTiesToEven>(dlf16 a);
+template dlf16 FloppyFloat::FormatSqrt<dlf16, FloppyFloat::kRoundTowardPositive>(dlf16 a);
+template dlf16 FloppyFloat::FormatSqrt<dlf16, FloppyFloat::kRoundTowardNegative>(dlf16 a);
+template dlf16 FloppyFloat::FormatSqrt<dlf16, FloppyFloat::kRoundTowardZero>(dlf16 a);
+template dlf16 FloppyFloat::FormatSqrt<dlf16, FloppyFloat::kRoundTiesToAway>(dlf16 a);
+
+template <typename FT>
+FT FloppyFloat::FormatFma(FT a, FT b, FT c) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return FormatFma<FT, kRoundTiesToEven>(a, b, c);
+  case kRoundTiesToAway:
+    return FormatFma<FT, kRoundTiesToAway>(a, b, c);
+  case kRoundTowardPositive:
+    return FormatFma<FT, kRoundTowardPositive>(a, b, c);
+  case kRoundTowardNegative:
+    return FormatFma<FT, kRoundTowardNegative>(a, b, c);
+  case kRoundTowardZero:
+    return FormatFma<FT, kRoundTowardZero>(a, b, c);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template tf32 FloppyFloat::FormatFma<tf32>(tf32 a, tf32 b, tf32 c);
+template dlf16 FloppyFloat::FormatFma<dlf16>(dlf16 a, dlf16 b, dlf16 c);
+
+template <typename FT, FloppyFloat::RoundingMode rm>
+FT FloppyFloat::FormatFma(FT a, FT b, FT c) {
+  f64 da = WidenToF64(a);
+  f64 db = WidenToF64(b);
+  f64 dc = WidenToF64(c);
+  return RoundViaF64<FT, rm>([&] {
+    f64 r;
+    // With at most 26 significand bits per operand and 9 exponent bits, the product fits into f64 and stays above
+    // 2^-1022, so it is exact and a single rounding remains. With 10 exponent bits, products of subnormals do not.
+    if constexpr (NumSignificandBits<FT>() <= 25 && NumExponentBits<FT>() <= 9) {
+      f64 p = da * db;
+      bool finite = !IsInfOrNan(p) && !IsInfOrNan(dc);
+      r = finite ? Add<f64, kRoundTowardZero>(p, dc) : Fma<f64, kRoundTowardZero>(da, db, dc);
+    } else {
+      r = Fma<f64, kRoundTowardZero>(da, db, dc);
+    }
+    if constexpr (rm == kRoundTowardNegative) {  // See: IEEE 754-2019: 6.3 The sign bit
+      if (IsPosZero(r) && ((IsNeg(da) != IsNeg(db)) || IsNeg(dc)))
+        r = -r;
+    }
+    return r;
+  });
+}
+
+template tf32 FloppyFloat::FormatFma<tf32, FloppyFloat::kRoundTiesToEven>(tf32 a, tf32 b, tf32 c);
+template tf32 FloppyFloat::FormatFma<tf32, FloppyFloat::kRoundTowardPositive>(tf32 a, tf32 b, tf32 c);
+template tf32 FloppyFloat::FormatFma<tf32, FloppyFloat::kRoundTowardNegative>(tf32 a, tf32 b, tf32 c);
+template tf32 FloppyFloat::FormatFma<tf32, FloppyFloat::kRoundTowardZero>(tf32 a, tf32 b, tf32 c);
+template tf32 FloppyFloat::FormatFma<tf32, FloppyFloat::kRoundTiesToAway>(tf32 a, tf32 b, tf32 c);
+
+template dlf16 FloppyFloat::FormatFma<dlf16, FloppyFloat::kRoundTiesToEven>(dlf16 a, dlf16 b, dlf16 c);
+template dlf16 FloppyFloat::FormatFma<dlf16, FloppyFloat::kRoundTowardPositive>(dlf16 a, dlf16 b, dlf16 c);
+template dlf16 FloppyFloat::FormatFma<dlf16, FloppyFloat::kRoundTowardNegative>(dlf16 a, dlf16 b, dlf16 c);
+template dlf16 FloppyFloat::FormatFma<dlf16, FloppyFloat::kRoundTowardZero>(dlf16 a, dlf16 b, dlf16 c);
+template dlf16 FloppyFloat::FormatFma<dlf16, FloppyFloat::kRoundTiesToAway>(dlf16 a, dlf16 b, dlf16 c);
+
+template <typename FT, bool exact>
+FT FloppyFloat::RoundToIntegral(FT a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return RoundToIntegral<FT, kRoundTiesToEven, exact>(a);
+  case kRoundTiesToAway:
+    return RoundToIntegral<FT, kRoundTiesToAway, exact>(a);
+  case kRoundTowardPositive:
+    return RoundToIntegral<FT, kRoundTowardPositive, exact>(a);
+  case kRoundTowardNegative:
+    return RoundToIntegral<FT, kRoundTowardNegative, exact>(a);
+  case kRoundTowardZero:
+    return RoundToIntegral<FT, kRoundTowardZero, exact>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 FloppyFloat::RoundToIntegral<f16, false>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, true>(f16 a);
+template f32 FloppyFloat::RoundToIntegral<f32, false>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, true>(f32 a);
+template f64 FloppyFloat::RoundToIntegral<f64, false>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, true>(f64 a);
+
+template <typename FT, FloppyFloat::RoundingMode rm, bool exact>
+FT FloppyFloat::RoundToIntegral(FT a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      SetInvalid();
+    return PropagateNan<FT>(a, a);
+  }
+
+  // The host functions keep the sign of zero results and never raise invalid for non-NaN inputs.
+  FT b;
+  if constexpr (rm == kRoundTiesToEven) {
+    b = std::nearbyint(a);  // Assumes that the host runs in round-to-nearest-even mode.
+  } else if constexpr (rm == kRoundTowardPositive) {
+    b = std::ceil(a);
+  } else if constexpr (rm == kRoundTowardNegative) {
+    b = std::floor(a);
+  } else if constexpr (rm == kRoundTowardZero) {
+    b = std::trunc(a);
+  } else if constexpr (rm == kRoundTiesToAway) {
+    b = std::round(a);
+  } else {
+    static_assert(false, "Using unsupported rounding mode");
+  }
+
+  if constexpr (exact) {
+    if (b != a)
+      SetInexact();
+  }
+
+  return b;
+}
+
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToEven, false>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardPositive, false>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardNegative, false>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardZero, false>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToAway, false>(f16 a);
+
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToEven, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardPositive, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardNegative, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTowardZero, true>(f16 a);
+template f16 FloppyFloat::RoundToIntegral<f16, FloppyFloat::kRoundTiesToAway, true>(f16 a);
+
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToEven, false>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardPositive, false>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardNegative, false>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardZero, false>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToAway, false>(f32 a);
+
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToEven, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardPositive, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardNegative, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTowardZero, true>(f32 a);
+template f32 FloppyFloat::RoundToIntegral<f32, FloppyFloat::kRoundTiesToAway, true>(f32 a);
+
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToEven, false>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardPositive, false>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardNegative, false>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardZero, false>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToAway, false>(f64 a);
+
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToEven, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardPositive, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardNegative, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTowardZero, true>(f64 a);
+template f64 FloppyFloat::RoundToIntegral<f64, FloppyFloat::kRoundTiesToAway, true>(f64 a);
+
+template <typename FT>
+FT FloppyFloat::RecipEstimateRiscv(FT a) {
+  using UT = FloatToUint<FT>::type;
+  constexpr int kSigBits = NumSignificandBits<FT>();
+  const UT sign = std::bit_cast<UT>(a) & SignMask<FT>();
+
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      SetInvalid();
+    return GetQnan<FT>();
+  }
+  if (IsInf(a)) [[unlikely]]
+    return std::bit_cast<FT>(sign);
+  if (IsZero(a)) [[unlikely]] {
+    SetDivisionByZero();
+    return std::bit_cast<FT>(static_cast<UT>(sign | ExponentMask<FT>()));
+  }
+
+  i32 exp = static_cast<i32>(GetExponent(a));
+  UT sig = GetSignificand(a);
+  if (exp == 0) [[unlikely]] {  // Normalize subnormals.
+    while (!((sig >> (kSigBits - 1)) & 1)) {
+      --exp;
+      sig <<= 1;
+    }
+    sig = (sig << 1) & ((static_cast<UT>(1) << kSigBits) - 1);
+    if (exp < -1) {  // The reciprocal is not representable.
+      SetOverflow();
+      SetInexact();
+      bool to_inf = (rounding_mode == kRoundTiesToEven) || (rounding_mode == kRoundTiesToAway) ||
+                    (rounding_mode == kRoundTowardPositive && !sign) || (rounding_mode == kRoundTowardNegative && sign);
+      UT inf = sign | ExponentMask<FT>();
+      return std::bit_cast<FT>(static_cast<UT>(to_inf ? inf : inf - 1));
+    }
+  }
+
+  i32 out_exp = 2 * Bias<FT>() - 1 - exp;
+  UT out_sig = static_cast<UT>(kRecip7Table[sig >> (kSigBits - 7)]) << (kSigBits - 7);
+  if (out_exp <= 0) [[unlikely]] {  // Subnormal result.
+    out_sig = (out_sig >> 1) | (static_cast<UT>(1) << (kSigBits - 1));
+    if (out_exp < 0) {
+      out_sig >>= 1;
+      out_exp = 0;
+    }
+  }
+  return std::bit_cast<FT>(static_cast<UT>(sign | (static_cast<UT>(out_exp) << kSigBits) | out_sig));
+}
+
+template f16 FloppyFloat::RecipEstimateRiscv<f16>(f16 a);
+template f32 FloppyFloat::RecipEstimateRiscv<f32>(f32 a);
+template f64 FloppyFloat::RecipEstimateRiscv<f64>(f64 a);
+
+template <typename FT>
+FT FloppyFloat::RsqrtEstimateRiscv(FT a) {
+  using UT = FloatToUint<FT>::type;
+  constexpr int kSigBits = NumSignificandBits<FT>();
+
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      SetInvalid();
+    return GetQnan<FT>();
+  }
+  if (IsZero(a)) [[unlikely]] {
+    SetDivisionByZero();
+    return std::bit_cast<FT>(static_cast<UT>((std::bit_cast<UT>(a) & SignMask<FT>()) | ExponentMask<FT>()));
+  }
+  if (std::signbit(a)) [[unlikely]] {
+    SetInvalid();
+    return GetQnan<FT>();
+  }
+  if (IsInf(a)) [[unlikely]]
+    return static_cast<FT>(0.);
+
+  i32 exp = static_cast<i32>(GetExponent(a));
+  UT sig = GetSignificand(a);
+  if (exp == 0) [[unlikely]] {  // Normalize subnormals.
+    while (!((sig >> (kSigBits - 1)) & 1)) {
+      --exp;
+      sig <<= 1;
+    }
+    sig = (sig << 1) & ((static_cast<UT>(1) << kSigBits) - 1);
+  }
+
+  u32 index = ((static_cast<u32>(exp) & 1) << 6) | static_cast<u32>(sig >> (kSigBits - 6));
+  UT out_sig = static_cast<UT>(kRsqrt7Table[index]) << (kSigBits - 7);
+  UT out_exp = static_cast<UT>((3 * Bias<FT>() - 1 - exp) / 2);
+  return std::bit_cast<FT>(static_cast<UT>((out_exp << kSigBits) | out_sig));
+}
+
+template f16 FloppyFloat::RsqrtEstimateRiscv<f16>(f16 a);
+template f32 FloppyFloat::RsqrtEstimateRiscv<f32>(f32 a);
+template f64 FloppyFloat::RsqrtEstimateRiscv<f64>(f64 a);
+
+template <typename FT>
+FT FloppyFloat::RecipEstimateArm(FT a) {
+  using UT = FloatToUint<FT>::type;
+  constexpr int kSigBits = NumSignificandBits<FT>();
+  constexpr int kFracBits = NumSignificandBits<f64>();  // The Arm ARM operates on 52-bit fractions.
+  constexpr u64 kFracMask = (1ull << kFracBits) - 1;
+  const UT sign = std::bit_cast<UT>(a) & SignMask<FT>();
+
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      SetInvalid();
+    return PropagateNan<FT, FT>(a);
+  }
+  if (IsInf(a)) [[unlikely]]
+    return std::bit_cast<FT>(sign);
+  if (IsZero(a)) [[unlikely]] {
+    SetDivisionByZero();
+    return std::bit_cast<FT>(static_cast<UT>(sign | ExponentMask<FT>()));
+  }
+
+  i32 exp = static_cast<i32>(GetExponent(a));
+  u64 frac = static_cast<u64>(GetSignificand(a)) << (kFracBits - kSigBits);
+  if (exp == 0) [[unlikely]] {
+    if (!((frac >> (kFracBits - 2)) & 1) && !((frac >> (kFracBits - 1)) & 1)) {  // |a| < 2^-(bias + 1).
+      SetOverflow();
+      SetInexact();
+      bool to_inf = (rounding_mode == kRoundTiesToEven) || (rounding_mode == kRoundTiesToAway) ||
+                    (rounding_mode == kRoundTowardPositive && !sign) || (rounding_mode == kRoundTowardNegative && sign);
+      UT inf = sign | ExponentMask<FT>();
+      return std::bit_cast<FT>(static_cast<UT>(to_inf ? inf : inf - 1));
+    }
+    if (!((frac >> (kFracBits - 1)) & 1)) {
+      exp = -1;
+      frac = (frac << 2) & kFracMask;
+    } else {
+      frac = (frac << 1) & kFracMask;
+    }
+  }
+
+  u32 scaled = static_cast<u32>(frac >> (kFracBits - 8));
+  i32 result_exp = 2 * Bias<FT>() - 1 - exp;
+  frac = static_cast<u64>(kArmRecipTable[scaled]) << (kFracBits - 8);
+  if (result_exp == 0) [[unlikely]] {
+    frac = (1ull << (kFracBits - 1)) | (frac >> 1);
+  } else if (result_exp == -1) [[unlikely]] {
+    frac = (1ull << (kFracBits - 2)) | (frac >> 2);
+    result_exp = 0;
+  }
+  return std::bit_cast<FT>(
+      static_cast<UT>(sign | (static_cast<UT>(result_exp) << kSigBits) | (frac >> (kFracBits - kSigBits))));
+}
+
+template f16 FloppyFloat::RecipEstimateArm<f16>(f16 a);
+template f32 FloppyFloat::RecipEstimateArm<f32>(f32 a);
+template f64 FloppyFloat::RecipEstimateArm<f64>(f64 a);
+
+template <typename FT>
+FT FloppyFloat::RsqrtEstimateArm(FT a) {
+  using UT = FloatToUint<FT>::type;
+  constexpr int kSigBits = NumSignificandBits<FT>();
+  constexpr int kFracBits = NumSignificandBits<f64>();  // The Arm ARM operates on 52-bit fractions.
+  constexpr u64 kFracMask = (1ull << kFracBits) - 1;
+
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      SetInvalid();
+    return PropagateNan<FT, FT>(a);
+  }
+  if (IsZero(a)) [[unlikely]] {
+    SetDivisionByZero();
+    return std::bit_cast<FT>(static_cast<UT>((std::bit_cast<UT>(a) & SignMask<FT>()) | ExponentMask<FT>()));
+  }
+  if (std::signbit(a)) [[unlikely]] {
+    SetInvalid();
+    return GetQnan<FT>();
+  }
+  if (IsInf(a)) [[unlikely]]
+    return static_cast<FT>(0.);
+
+  i32 exp = static_cast<i32>(GetExponent(a));
+  u64 frac = static_cast<u64>(GetSignificand(a)) << (kFracBits - kSigBits);
+  if (exp == 0) [[unlikely]] {  // Normalize subnormals.
+    while (!((frac >> (kFracBits - 1)) & 1)) {
+      frac <<= 1;
+      --exp;
+    }
+    frac = (frac << 1) & kFracMask;
+  }
+
+  // Scaled input in [128, 512) which represents [0.25, 1.0).
+  u32 scaled = (exp & 1) ? (128u | static_cast<u32>(frac >> (kFracBits - 7)))
+                         : (256u | static_cast<u32>(frac >> (kFracBits - 8)));
+  UT result_exp = static_cast<UT>((3 * Bias<FT>() - 1 - exp) / 2);
+  frac = static_cast<u64>(kArmRsqrtTable[scaled - 128]) << (kFracBits - 8);
+  return std::bit_cast<FT>(static_cast<UT>((result_exp << kSigBits) | (frac >> (kFracBits - kSigBits))));
+}
+
+template f16 FloppyFloat::RsqrtEstimateArm<f16>(f16 a);
+template f32 FloppyFloat::RsqrtEstimateArm<f32>(f32 a);
+template f64 FloppyFloat::RsqrtEstimateArm<f64>(f64 a);
+
+template <typename FT>
+FT FloppyFloat::RecipExponentArm(FT a) {
+  using UT = FloatToUint<FT>::type;
+  constexpr int kSigBits = NumSignificandBits<FT>();
+
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      SetInvalid();
+    return PropagateNan<FT, FT>(a);
+  }
+
+  // Zeros and subnormals yield the maximum finite exponent, all other values the inverted exponent.
+  const UT sign = std::bit_cast<UT>(a) & SignMask<FT>();
+  UT exp = GetExponent(a);
+  UT max_exp = ExponentMask<FT>() >> kSigBits;
+  UT out_exp = (exp == 0) ? max_exp - 1 : (~exp & max_exp);
+  return std::bit_cast<FT>(static_cast<UT>(sign | (out_exp << kSigBits)));
+}
+
+template f16 FloppyFloat::RecipExponentArm<f16>(f16 a);
+template f32 FloppyFloat::RecipExponentArm<f32>(f32 a);
+template f64 FloppyFloat::RecipExponentArm<f64>(f64 a);
+
+// The Arm ARM negates a before processing NaNs, so a NaN in a is returned with inverted sign.
+// FMA yields the same behavior when called with -a.
+template <typename FT>
+FT FloppyFloat::RecipStepArm(FT a, FT b) {
+  if ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b))) [[unlikely]]
+    return static_cast<FT>(2.0);
+  return Fma<FT>(-a, b, static_cast<FT>(2.0));
+}
+
+template f16 FloppyFloat::RecipStepArm<f16>(f16 a, f16 b);
+template f32 FloppyFloat::RecipStepArm<f32>(f32 a, f32 b);
+template f64 FloppyFloat::RecipStepArm<f64>(f64 a, f64 b);
+
+// Computes 1.5 - (a / 2) * b, halving the operand with the larger magnitude.
+// If halving is inexact, both operands are tiny and the product only matters for rounding and
+// inexact, which do not depend on the factor of 2.
+template <typename FT>
+FT FloppyFloat::RsqrtStepArm(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]]
+    return Fma<FT>(-a, b, static_cast<FT>(1.5));
+  if ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b))) [[unlikely]]
+    return static_cast<FT>(1.5);
+
+  if (std::abs(a) < std::abs(b))
+    std::swap(a, b);
+  FT half = a / static_cast<FT>(2.0);
+  if (half * static_cast<FT>(2.0) == a) [[likely]]
+    a = half;
+  return Fma<FT>(-a, b, static_cast<FT>(1.5));
+}
+
+template f16 FloppyFloat::RsqrtStepArm<f16>(f16 a, f16 b);
+template f32 FloppyFloat::RsqrtStepArm<f32>(f32 a, f32 b);
+template f64 FloppyFloat::RsqrtStepArm<f64>(f64 a, f64 b);
+
 template <typename FT>
 bool FloppyFloat::EqQuiet(FT a, FT b) {
   if (IsNan(a) || IsNan(b)) [[unlikely]] {
@@ -966,6 +1939,7 @@ bool FloppyFloat::EqQuiet(FT a, FT b) {
 template bool FloppyFloat::EqQuiet<f16>(f16 a, f16 b);
 template bool FloppyFloat::EqQuiet<f32>(f32 a, f32 b);
 template bool FloppyFloat::EqQuiet<f64>(f64 a, f64 b);
+template bool FloppyFloat::EqQuiet<f128>(f128 a, f128 b);
 
 template <typename FT>
 bool FloppyFloat::EqSignaling(FT a, FT b) {
@@ -980,6 +1954,7 @@ bool FloppyFloat::EqSignaling(FT a, FT b) {
 template bool FloppyFloat::EqSignaling<f16>(f16 a, f16 b);
 template bool FloppyFloat::EqSignaling<f32>(f32 a, f32 b);
 template bool FloppyFloat::EqSignaling<f64>(f64 a, f64 b);
+template bool FloppyFloat::EqSignaling<f128>(f128 a, f128 b);
 
 template <typename FT>
 bool FloppyFloat::LeQuiet(FT a, FT b) {
@@ -995,6 +1970,7 @@ bool FloppyFloat::LeQuiet(FT a, FT b) {
 template bool FloppyFloat::LeQuiet<f16>(f16 a, f16 b);
 template bool FloppyFloat::LeQuiet<f32>(f32 a, f32 b);
 template bool FloppyFloat::LeQuiet<f64>(f64 a, f64 b);
+template bool FloppyFloat::LeQuiet<f128>(f128 a, f128 b);
 
 template <typename FT>
 bool FloppyFloat::LeSignaling(FT a, FT b) {
@@ -1009,6 +1985,7 @@ bool FloppyFloat::LeSignaling(FT a, FT b) {
 template bool FloppyFloat::LeSignaling<f16>(f16 a, f16 b);
 template bool FloppyFloat::LeSignaling<f32>(f32 a, f32 b);
 template bool FloppyFloat::LeSignaling<f64>(f64 a, f64 b);
+template bool FloppyFloat::LeSignaling<f128>(f128 a, f128 b);
 
 template <typename FT>
 bool FloppyFloat::LtQuiet(FT a, FT b) {
@@ -1024,6 +2001,7 @@ bool FloppyFloat::LtQuiet(FT a, FT b) {
 template bool FloppyFloat::LtQuiet<f16>(f16 a, f16 b);
 template bool FloppyFloat::LtQuiet<f32>(f32 a, f32 b);
 template bool FloppyFloat::LtQuiet<f64>(f64 a, f64 b);
+template bool FloppyFloat::LtQuiet<f128>(f128 a, f128 b);
 
 template <typename FT>
 bool FloppyFloat::LtSignaling(FT a, FT b) {
@@ -1035,9 +2013,52 @@ bool FloppyFloat::LtSignaling(FT a, FT b) {
   return a < b;
 }
 
-template bool FloppyFloat::LtSignaling<f16>(f16 a, f16 b);
-template bool FloppyFloat::LtSignaling<f32>(f32 a, f32 b);
-template bool FloppyFloat::LtSignaling<f64>(f64 a, f64 b);
+template bool FloppyFloat::LtSignaling<f16>(f16 a, f16 b);
+template bool FloppyFloat::LtSignaling<f32>(f32 a, f32 b);
+template bool FloppyFloat::LtSignaling<f64>(f64 a, f64 b);
+template bool FloppyFloat::LtSignaling<f128>(f128 a, f128 b);
+
+template <typename FT, bool signaling>
+u8 FloppyFloat::CompareArm(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (signaling || IsSnan(a) || IsSnan(b))
+      SetInvalid();
+    return kArmC | kArmV;
+  }
+
+  if (a < b)
+    return kArmN;
+  if (a == b)
+    return kArmZ | kArmC;
+  return kArmC;
+}
+
+template u8 FloppyFloat::CompareArm<f16, false>(f16 a, f16 b);
+template u8 FloppyFloat::CompareArm<f32, false>(f32 a, f32 b);
+template u8 FloppyFloat::CompareArm<f64, false>(f64 a, f64 b);
+template u8 FloppyFloat::CompareArm<f16, true>(f16 a, f16 b);
+template u8 FloppyFloat::CompareArm<f32, true>(f32 a, f32 b);
+template u8 FloppyFloat::CompareArm<f64, true>(f64 a, f64 b);
+
+template <typename FT, bool signaling>
+u8 FloppyFloat::CompareX86(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (signaling || IsSnan(a) || IsSnan(b))
+      SetInvalid();
+    return kX86Zf | kX86Pf | kX86Cf;
+  }
+
+  if (a < b)
+    return kX86Cf;
+  if (a == b)
+    return kX86Zf;
+  return 0;
+}
+
+template u8 FloppyFloat::CompareX86<f32, false>(f32 a, f32 b);
+template u8 FloppyFloat::CompareX86<f64, false>(f64 a, f64 b);
+template u8 FloppyFloat::CompareX86<f32, true>(f32 a, f32 b);
+template u8 FloppyFloat::CompareX86<f64, true>(f64 a, f64 b);
 
 template <typename FT>
 FT FloppyFloat::Maxx86(FT a, FT b) {
@@ -1092,6 +2113,7 @@ FT FloppyFloat::MaximumNumber(FT a, FT b) {
 template f16 FloppyFloat::MaximumNumber<f16>(f16 a, f16 b);
 template f32 FloppyFloat::MaximumNumber<f32>(f32 a, f32 b);
 template f64 FloppyFloat::MaximumNumber<f64>(f64 a, f64 b);
+template f128 FloppyFloat::MaximumNumber<f128>(f128 a, f128 b);
 
 template <typename FT>
 FT FloppyFloat::MinimumNumber(FT a, FT b) {
@@ -1112,8 +2134,54 @@ FT FloppyFloat::MinimumNumber(FT a, FT b) {
 template f16 FloppyFloat::MinimumNumber<f16>(f16 a, f16 b);
 template f32 FloppyFloat::MinimumNumber<f32>(f32 a, f32 b);
 template f64 FloppyFloat::MinimumNumber<f64>(f64 a, f64 b);
+template f128 FloppyFloat::MinimumNumber<f128>(f128 a, f128 b);
+
+// Maps a non-NaN value onto a signed integer whose order equals the total order of the values.
+// Negative values get their magnitude bits flipped, which also orders -0 below +0.
+template <typename FT>
+constexpr auto TotalOrderKey(FT a) {
+  using IT = FloatToInt<FT>::type;
+  IT ia = std::bit_cast<IT>(a);
+  return ia ^ ((ia >> (NumBits<FT>() - 1)) & nl<IT>::max());
+}
+
+template <typename FT>
+FT FloppyFloat::Maximum(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      SetInvalid();
+    return PropagateNan<FT>(a, b);
+  }
+
+  return (TotalOrderKey(a) > TotalOrderKey(b)) ? a : b;
+}
+
+template f16 FloppyFloat::Maximum<f16>(f16 a, f16 b);
+template f32 FloppyFloat::Maximum<f32>(f32 a, f32 b);
+template f64 FloppyFloat::Maximum<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Maximum<f128>(f128 a, f128 b);
+
+template <typename FT>
+FT FloppyFloat::Minimum(FT a, FT b) {
+  if (IsNan(a) || IsNan(b)) [[unlikely]] {
+    if (IsSnan(a) || IsSnan(b))
+      SetInvalid();
+    return PropagateNan<FT>(a, b);
+  }
+
+  return (TotalOrderKey(a) < TotalOrderKey(b)) ? a : b;
+}
+
+template f16 FloppyFloat::Minimum<f16>(f16 a, f16 b);
+template f32 FloppyFloat::Minimum<f32>(f32 a, f32 b);
+template f64 FloppyFloat::Minimum<f64>(f64 a, f64 b);
+template f128 FloppyFloat::Minimum<f128>(f128 a, f128 b);
 
 f32 FloppyFloat::F16ToF32(f16 a) {
+  return CallHostF16([&] { return F16ToF32Impl(a); });
+}
+
+f32 FloppyFloat::F16ToF32Impl(f16 a) {
   if (IsNan(a)) [[unlikely]] {
     if (!GetQuietBit(a))
       SetInvalid();
@@ -1133,6 +2201,16 @@ f64 FloppyFloat::F16ToF64(f16 a) {
   return static_cast<f64>(a);
 }
 
+f32 FloppyFloat::BF16ToF32(bf16 a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      SetInvalid();
+    return PropagateNan<bf16, f32>(a);
+  }
+
+  return std::bit_cast<f32>(static_cast<u32>(std::bit_cast<u16>(a)) << 16);
+}
+
 // Assumes that "result" was calculated with "kRoundTowardZero"
 template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
 constexpr IT RoundIntegerResult(FT residual, FT source, IT result) {
@@ -1436,6 +2514,11 @@ f16 FloppyFloat::F32ToF16(f32 a) {
 
 template <FloppyFloat::RoundingMode rm>
 f16 FloppyFloat::F32ToF16(f32 a) {
+  return CallHostF16([&] { return F32ToF16Impl<rm>(a); });
+}
+
+template <FloppyFloat::RoundingMode rm>
+f16 FloppyFloat::F32ToF16Impl(f32 a) {
   if constexpr (rm == kRoundTiesToAway) {
     return SoftFloat::F32ToF16(a);
   }
@@ -1483,6 +2566,206 @@ template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTowardNegative>(f32 a);
 template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTowardZero>(f32 a);
 template f16 FloppyFloat::F32ToF16<FloppyFloat::kRoundTiesToAway>(f32 a);
 
+bf16 FloppyFloat::F32ToBF16(f32 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F32ToBF16<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F32ToBF16<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F32ToBF16<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F32ToBF16<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F32ToBF16<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <FloppyFloat::RoundingMode rm>
+bf16 FloppyFloat::F32ToBF16(f32 a) {
+  if constexpr (rm == kRoundTiesToAway) {
+    RmGuard rg(this, rm);
+    return SoftFloat::F32ToBF16(a);
+  }
+
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      SetInvalid();
+    return PropagateNan<f32, bf16>(a);
+  }
+
+  bf16 result = static_cast<bf16>(a);
+
+  if (IsInfOrNan(result)) [[unlikely]] {  // Infinity case. NaN already handled before.
+    if (!IsInf(a)) {
+      SetInexact();
+      result = RoundInf<bf16, rm>(result);
+      if (IsInf(result))  // Same exponent range as f32, so clamping to the largest finite value is not an overflow.
+        SetOverflow();
+    }
+    return result;
+  }
+
+  f32 residual = static_cast<f32>(result) - a;
+  if (residual != 0.f32)
+    SetInexact();
+
+  result = RoundResult<bf16, f32, rm>(residual, result);
+
+  if (!underflow) {
+    if (std::abs(result) <= nl<bf16>::min()) [[unlikely]] {
+      if (std::abs(result) == nl<bf16>::min()) {
+        RmGuard rg(this, rm);
+        result = SoftFloat::F32ToBF16(a);
+      } else {
+        if (residual != 0.f32)
+          SetUnderflow();
+      }
+    }
+  }
+
+  return result;
+}
+
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTiesToEven>(f32 a);
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTowardPositive>(f32 a);
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTowardNegative>(f32 a);
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTowardZero>(f32 a);
+template bf16 FloppyFloat::F32ToBF16<FloppyFloat::kRoundTiesToAway>(f32 a);
+
+// Rounds the non-NaN value "a" on its binary representation, as there is no host type to cast to.
+// The discarded significand bits play the role of the residual.
+template <typename MT, bool saturate, bool stochastic>
+u8 FloppyFloat::RoundToMiniFloat(f32 a, u32 random) {
+  constexpr int kSigBits = MiniFloatFormat<MT>::kSigBits;
+  constexpr u32 kMinNormalExp = 127 + 1 - MiniFloatFormat<MT>::kBias;  // As biased f32 exponent.
+  u32 ua = std::bit_cast<u32>(a);
+  u8 sign = static_cast<u8>((ua >> 31) << (MiniFloatFormat<MT>::kNumBits - 1));
+  u32 mag = ua & 0x7fffffffu;
+
+  if (mag == 0x7f800000u) [[unlikely]] {
+    if constexpr (saturate) {
+      return sign | MiniFloatFormat<MT>::kMaxCode;
+    } else {
+      if constexpr (std::is_same_v<MT, fp8e4m3>)
+        SetInvalid();
+      return sign | MiniFloatFormat<MT>::kOverflowCode;
+    }
+  }
+
+  u32 exp = mag >> 23;
+  u32 sig = (mag & 0x7fffffu) | (exp != 0 ? 0x800000u : 0u);
+  u32 shift = 23 - kSigBits + (exp < kMinNormalExp ? kMinNormalExp - exp : 0);
+  u32 kept = shift < 32 ? sig >> shift : 0;
+  u32 rem = shift < 32 ? sig & ((1u << shift) - 1) : sig;
+
+  if constexpr (stochastic) {
+    u32 scaled = shift <= 32 ? rem << (32 - shift) : (shift < 64 ? rem >> (shift - 32) : 0);
+    kept += static_cast<u32>(scaled + random) < scaled;
+  } else {
+    u32 half = shift <= 32 ? 1u << (shift - 1) : 0xffffffffu;
+    kept += (rem > half) || (rem == half && (kept & 1));
+  }
+
+  u32 code = ((exp > kMinNormalExp ? exp - kMinNormalExp : 0) << kSigBits) + kept;
+
+  if (rem != 0) {
+    SetInexact();
+    if (exp < kMinNormalExp) {
+      bool tiny = true;
+      if constexpr (!stochastic) {
+        if (!tininess_before_rounding && code == (1u << kSigBits)) {
+          // Rounded up to the smallest normal number. It is only tiny if it had not with an unbounded exponent.
+          u32 wide_rem = sig & ((1u << (shift - 1)) - 1);
+          u32 wide_half = 1u << (shift - 2);
+          u32 wide = (sig >> (shift - 1)) + ((wide_rem > wide_half) || (wide_rem == wide_half && ((sig >> (shift - 1)) & 1)));
+          tiny = wide < (2u << kSigBits);
+        }
+      }
+      if (tiny)
+        SetUnderflow();
+    }
+  }
+
+  if (code > MiniFloatFormat<MT>::kMaxCode) [[unlikely]] {
+    SetOverflow();
+    SetInexact();
+    return sign | (saturate ? MiniFloatFormat<MT>::kMaxCode : MiniFloatFormat<MT>::kOverflowCode);
+  }
+
+  return sign | static_cast<u8>(code);
+}
+
+// Used by the MX block conversions, which only pass finite values.
+template u8 FloppyFloat::RoundToMiniFloat<fp6e3m2, true, false>(f32 a, u32 random);
+template u8 FloppyFloat::RoundToMiniFloat<fp6e3m2, true, true>(f32 a, u32 random);
+template u8 FloppyFloat::RoundToMiniFloat<fp6e2m3, true, false>(f32 a, u32 random);
+template u8 FloppyFloat::RoundToMiniFloat<fp6e2m3, true, true>(f32 a, u32 random);
+template u8 FloppyFloat::RoundToMiniFloat<fp4e2m1, true, false>(f32 a, u32 random);
+template u8 FloppyFloat::RoundToMiniFloat<fp4e2m1, true, true>(f32 a, u32 random);
+
+template <typename FP8, bool saturate, typename FT>
+FP8 FloppyFloat::FToFp8(FT a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      SetInvalid();
+    return FP8{static_cast<u8>((std::signbit(a) ? 0x80 : 0x00) | MiniFloatFormat<FP8>::kNanCode)};
+  }
+
+  return FP8{RoundToMiniFloat<FP8, saturate, false>(static_cast<f32>(a), 0)};
+}
+
+template fp8e4m3 FloppyFloat::FToFp8<fp8e4m3, true, f16>(f16 a);
+template fp8e4m3 FloppyFloat::FToFp8<fp8e4m3, true, bf16>(bf16 a);
+template fp8e4m3 FloppyFloat::FToFp8<fp8e4m3, true, f32>(f32 a);
+template fp8e4m3 FloppyFloat::FToFp8<fp8e4m3, false, f16>(f16 a);
+template fp8e4m3 FloppyFloat::FToFp8<fp8e4m3, false, bf16>(bf16 a);
+template fp8e4m3 FloppyFloat::FToFp8<fp8e4m3, false, f32>(f32 a);
+template fp8e5m2 FloppyFloat::FToFp8<fp8e5m2, true, f16>(f16 a);
+template fp8e5m2 FloppyFloat::FToFp8<fp8e5m2, true, bf16>(bf16 a);
+template fp8e5m2 FloppyFloat::FToFp8<fp8e5m2, true, f32>(f32 a);
+template fp8e5m2 FloppyFloat::FToFp8<fp8e5m2, false, f16>(f16 a);
+template fp8e5m2 FloppyFloat::FToFp8<fp8e5m2, false, bf16>(bf16 a);
+template fp8e5m2 FloppyFloat::FToFp8<fp8e5m2, false, f32>(f32 a);
+
+template <typename FP8, bool saturate, typename FT>
+FP8 FloppyFloat::FToFp8Stochastic(FT a, u32 random) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      SetInvalid();
+    return FP8{static_cast<u8>((std::signbit(a) ? 0x80 : 0x00) | MiniFloatFormat<FP8>::kNanCode)};
+  }
+
+  return FP8{RoundToMiniFloat<FP8, saturate, true>(static_cast<f32>(a), random)};
+}
+
+template fp8e4m3 FloppyFloat::FToFp8Stochastic<fp8e4m3, true, f16>(f16 a, u32 random);
+template fp8e4m3 FloppyFloat::FToFp8Stochastic<fp8e4m3, true, bf16>(bf16 a, u32 random);
+template fp8e4m3 FloppyFloat::FToFp8Stochastic<fp8e4m3, true, f32>(f32 a, u32 random);
+template fp8e4m3 FloppyFloat::FToFp8Stochastic<fp8e4m3, false, f16>(f16 a, u32 random);
+template fp8e4m3 FloppyFloat::FToFp8Stochastic<fp8e4m3, false, bf16>(bf16 a, u32 random);
+template fp8e4m3 FloppyFloat::FToFp8Stochastic<fp8e4m3, false, f32>(f32 a, u32 random);
+template fp8e5m2 FloppyFloat::FToFp8Stochastic<fp8e5m2, true, f16>(f16 a, u32 random);
+template fp8e5m2 FloppyFloat::FToFp8Stochastic<fp8e5m2, true, bf16>(bf16 a, u32 random);
+template fp8e5m2 FloppyFloat::FToFp8Stochastic<fp8e5m2, true, f32>(f32 a, u32 random);
+template fp8e5m2 FloppyFloat::FToFp8Stochastic<fp8e5m2, false, f16>(f16 a, u32 random);
+template fp8e5m2 FloppyFloat::FToFp8Stochastic<fp8e5m2, false, bf16>(bf16 a, u32 random);
+template fp8e5m2 FloppyFloat::FToFp8Stochastic<fp8e5m2, false, f32>(f32 a, u32 random);
+
+template <typename FP8>
+f32 FloppyFloat::Fp8ToF32(FP8 a) {
+  if constexpr (std::is_same_v<FP8, fp8e5m2>) {
+    if ((a.v & 0x7f) == 0x7d) [[unlikely]]  // The only signaling NaN encoding of E5M2.
+      SetInvalid();
+  }
+  return MiniFloatDecodeTable<FP8>()[a.v];
+}
+
+template f32 FloppyFloat::Fp8ToF32<fp8e4m3>(fp8e4m3 a);
+template f32 FloppyFloat::Fp8ToF32<fp8e5m2>(fp8e5m2 a);
+
 template <FloppyFloat::RoundingMode rm>
 constexpr f64 F64ToI32NegLimit() {
   if constexpr (rm == FloppyFloat::kRoundTiesToEven) {
@@ -1631,6 +2914,52 @@ template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTowardNegative>(f64 a);
 template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTowardZero>(f64 a);
 template i32 FloppyFloat::F64ToI32<FloppyFloat::kRoundTiesToAway>(f64 a);
 
+// Rounds "a" within the i64 range to an integer. Also returns the residual, which is zero iff the result is exact.
+template <FloppyFloat::RoundingMode rm>
+std::pair<i64, f64> RoundF64ToI64(f64 a) {
+  i64 ia;
+  if constexpr (rm == FloppyFloat::kRoundTiesToAway) {
+    ia = std::lround(a);
+  } else if (rm == FloppyFloat::kRoundTiesToEven) {
+    ia = std::lrint(a);
+  } else {
+    ia = static_cast<i64>(a);  // C++ always truncates (i.e., rounds to zero).
+  }
+
+  f64 r = static_cast<f64>(ia) - a;
+  if constexpr (rm == FloppyFloat::kRoundTowardNegative) {
+    if (r > 0)
+      ia -= 1;
+  } else if constexpr (rm == FloppyFloat::kRoundTowardPositive) {
+    if (r < 0)
+      ia += 1;
+  }
+  return {ia, r};
+}
+
+// Rounds toward zero and keeps the low 32 bits of the integral result.
+// Invalid is raised for NaN, infinities, and values whose truncation does not fit into 32 bits;
+// inexact is only raised for valid conversions. NaN and infinities yield 0.
+i32 FloppyFloat::F64ToI32Modular(f64 a) {
+  if (std::abs(a) < 9223372036854775808.0f64) [[likely]] {
+    auto [ia, r] = RoundF64ToI64<kRoundTowardZero>(a);
+    i32 res = static_cast<i32>(ia);
+    if (res != ia) [[unlikely]] {
+      SetInvalid();
+    } else if (!IsZero(r)) {
+      SetInexact();
+    }
+    return res;
+  }
+
+  SetInvalid();
+  if (IsInfOrNan(a)) [[unlikely]]
+    return 0;
+
+  // |a| >= 2**63 is always integral, and so is its remainder modulo 2**32, which fmod computes exactly.
+  return static_cast<i32>(static_cast<u32>(static_cast<i64>(std::fmod(a, 0x1p32f64))));
+}
+
 i64 FloppyFloat::F64ToI64(f64 a) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
@@ -1661,27 +2990,9 @@ i64 FloppyFloat::F64ToI64(f64 a) {
     return min_limit_i64_;
   }
 
-  i64 ia;
-  if constexpr (rm == kRoundTiesToAway) {
-    ia = std::lround(a);
-  } else if (rm == kRoundTiesToEven) {
-    ia = std::lrint(a);
-  } else {
-    ia = static_cast<i64>(a);  // C++ always truncates (i.e., rounds to zero).
-  }
-
-  f64 r = static_cast<f64>(ia) - a;
+  auto [ia, r] = RoundF64ToI64<rm>(a);
   if (!IsZero(r))
     SetInexact();
-
-  if constexpr (rm == kRoundTowardNegative) {
-    if (r > 0)
-      ia -= 1;
-  } else if constexpr (rm == kRoundTowardPositive) {
-    if (r < 0)
-      ia += 1;
-  }
-
   return ia;
 }
 
@@ -1811,7 +3122,7 @@ u64 FloppyFloat::F64ToU64(f64 a) {
   if (IsNan(a)) [[unlikely]] {
     SetInvalid();
     return nan_limit_u64_;
-  } else if (a > 18446744073709551616.f64) [[unlikely]] {
+  } else if (a >= 18446744073709551616.f64) [[unlikely]] {
     SetInvalid();
     return max_limit_u64_;
   } else if (a < 0.f64) [[unlikely]] {
@@ -1839,6 +3150,136 @@ template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardNegative>(f64 a);
 template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTowardZero>(f64 a);
 template u64 FloppyFloat::F64ToU64<FloppyFloat::kRoundTiesToAway>(f64 a);
 
+f128 FloppyFloat::F32ToF128(f32 a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      SetInvalid();
+    return PropagateNan<f32, f128>(a);
+  }
+
+  return static_cast<f128>(a);
+}
+
+f128 FloppyFloat::F64ToF128(f64 a) {
+  if (IsNan(a)) [[unlikely]] {
+    if (!GetQuietBit(a))
+      SetInvalid();
+    return PropagateNan<f64, f128>(a);
+  }
+
+  return static_cast<f128>(a);
+}
+
+f32 FloppyFloat::F128ToF32(f128 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F128ToF32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F128ToF32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F128ToF32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F128ToF32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F128ToF32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+// The host conversion rounds to nearest even, and the residual is exact as long as the result is normal.
+template <FloppyFloat::RoundingMode rm>
+f32 FloppyFloat::F128ToF32(f128 a) {
+  if constexpr (rm == kRoundTiesToAway) {
+    RmGuard rg(this, rm);
+    return SoftFloat::F128ToF32(a);
+  }
+
+  f32 b = static_cast<f32>(a);
+
+  if (IsInfOrNan(b) || MayResultFromUnderflow(b)) [[unlikely]] {
+    RmGuard rg(this, rm);
+    return SoftFloat::F128ToF32(a);
+  }
+
+  f128 r = static_cast<f128>(b) - a;
+  if (!IsZero(r)) {
+    SetInexact();
+    b = RoundResult<f32, f128, rm>(r, b);
+  }
+
+  return b;
+}
+
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTiesToEven>(f128 a);
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTowardPositive>(f128 a);
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTowardNegative>(f128 a);
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTowardZero>(f128 a);
+template f32 FloppyFloat::F128ToF32<FloppyFloat::kRoundTiesToAway>(f128 a);
+
+f64 FloppyFloat::F128ToF64(f128 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F128ToF64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F128ToF64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F128ToF64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F128ToF64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F128ToF64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+// The host conversion rounds to nearest even, and the residual is exact as long as the result is normal.
+template <FloppyFloat::RoundingMode rm>
+f64 FloppyFloat::F128ToF64(f128 a) {
+  if constexpr (rm == kRoundTiesToAway) {
+    RmGuard rg(this, rm);
+    return SoftFloat::F128ToF64(a);
+  }
+
+  f64 b = static_cast<f64>(a);
+
+  if (IsInfOrNan(b) || MayResultFromUnderflow(b)) [[unlikely]] {
+    RmGuard rg(this, rm);
+    return SoftFloat::F128ToF64(a);
+  }
+
+  f128 r = static_cast<f128>(b) - a;
+  if (!IsZero(r)) {
+    SetInexact();
+    b = RoundResult<f64, f128, rm>(r, b);
+  }
+
+  return b;
+}
+
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTiesToEven>(f128 a);
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTowardPositive>(f128 a);
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTowardNegative>(f128 a);
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTowardZero>(f128 a);
+template f64 FloppyFloat::F128ToF64<FloppyFloat::kRoundTiesToAway>(f128 a);
+
+f128 FloppyFloat::I32ToF128(i32 a) {
+  return static_cast<f128>(a);
+}
+
+f128 FloppyFloat::U32ToF128(u32 a) {
+  return static_cast<f128>(a);
+}
+
+f128 FloppyFloat::I64ToF128(i64 a) {
+  return static_cast<f128>(a);
+}
+
+f128 FloppyFloat::U64ToF128(u64 a) {
+  return static_cast<f128>(a);
+}
+
 f16 FloppyFloat::I32ToF16(i32 a) {
   switch (rounding_mode) {
   case kRoundTiesToEven:
@@ -1974,7 +3415,7 @@ f32 FloppyFloat::I32ToF32(i32 a) {
     } else if constexpr (rm == kRoundTiesToAway) {
       if ((a > 0) && (r == 128) && !even)
         af = NextUpNoNegZero(af);
-      if ((a < 0) && (r == 128) && even)
+      if ((a < 0) && (r == 128) && !even)
         af = NextDownNoPosZero(af);
     }
   }
@@ -2106,6 +3547,40 @@ f64 FloppyFloat::U32ToF64(u32 a) {
   return static_cast<f64>(a);
 }
 
+// Immediates of the RISC-V Zfa "fli" instructions. Entry 1 is the minimum positive normal value,
+// entries 30 and 31 are +∞ and the canonical NaN. 2**16 is not representable as f16 and becomes +∞.
+template <typename FT>
+constexpr std::array<FT, 32> CreateFliTable() {
+  constexpr std::array<f64, 32> kValues = {
+      -1.0,    0.0,  0x1p-16, 0x1p-15, 0x1p-8,  0x1p-7, 0.0625, 0.125,   0.25,    0.3125, 0.375,
+      0.4375,  0.5,  0.625,   0.75,    0.875,   1.0,    1.25,   1.5,     1.75,    2.0,    2.5,
+      3.0,     4.0,  8.0,     16.0,    128.0,   256.0,  32768.0, 65536.0, 0.0,    0.0};
+  std::array<FT, 32> table{};
+  for (size_t i = 0; i < kValues.size(); ++i) {
+    if (kValues[i] <= static_cast<f64>(nl<FT>::max()))
+      table[i] = static_cast<FT>(kValues[i]);
+    else
+      table[i] = nl<FT>::infinity();
+  }
+  table[1] = nl<FT>::min();
+  table[30] = nl<FT>::infinity();
+  table[31] = nl<FT>::quiet_NaN();
+  return table;
+}
+
+template <typename FT>
+FT FloppyFloat::Fli(u32 index) {
+  static constexpr std::array<FT, 32> kFliTable = CreateFliTable<FT>();
+  index &= 31;
+  if (index == 31) [[unlikely]]
+    return GetQnan<FT>();
+  return kFliTable[index];
+}
+
+template f16 FloppyFloat::Fli<f16>(u32 index);
+template f32 FloppyFloat::Fli<f32>(u32 index);
+template f64 FloppyFloat::Fli<f64>(u32 index);
+
 template <typename FT>
 u32 FloppyFloat::Class(FT a) {
   u32 res;
@@ -2138,3 +3613,4 @@ u32 FloppyFloat::Class(FT a) {
 template u32 FloppyFloat::Class<f16>(f16 a);
 template u32 FloppyFloat::Class<f32>(f32 a);
 template u32 FloppyFloat::Class<f64>(f64 a);
+template u32 FloppyFloat::Class<f128>(f128 a);
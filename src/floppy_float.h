@@ -11,8 +11,17 @@
 #include "utils.h"
 class FloppyFloat : public SoftFloat {
  public:
+  // Host instruction set extensions used for the f16 arithmetic and conversions. Without them, every f16 operation is
+  // emulated in f32 by libgcc calls. Set to DetectHostF16() on construction; lower values select the slower paths.
+  // SetHostF16 clamps to DetectHostF16(), as higher values would execute instructions the host does not have.
+  enum HostF16 { kHostF16None, kHostF16F16c, kHostF16Avx512Fp16 };
+
   FloppyFloat();
 
+  static HostF16 DetectHostF16();
+  HostF16 GetHostF16() const { return host_f16_; }
+  void SetHostF16(HostF16 host_f16);
+
   template <typename FT>
   void SetQnan(typename FfUtils::FloatToUint<FT>::type val);
   template <typename FT>
@@ -48,6 +57,64 @@ class FloppyFloat : public SoftFloat {
   template <typename FT>
   FT Fma(FT a, FT b, FT c);
 
+  // Arithmetic on generic formats (see FfUtils::FloatFormat) with at most 10 exponent and 50 significand bits.
+  // Operands are widened to f64 and the f64 operations are reused with rounding to odd (see RoundViaF64).
+  template <typename FT, RoundingMode rm>
+  FT FormatAdd(FT a, FT b);
+  template <typename FT>
+  FT FormatAdd(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT FormatSub(FT a, FT b);
+  template <typename FT>
+  FT FormatSub(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT FormatMul(FT a, FT b);
+  template <typename FT>
+  FT FormatMul(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT FormatDiv(FT a, FT b);
+  template <typename FT>
+  FT FormatDiv(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT FormatSqrt(FT a);
+  template <typename FT>
+  FT FormatSqrt(FT a);
+  template <typename FT, RoundingMode rm>
+  FT FormatFma(FT a, FT b, FT c);
+  template <typename FT>
+  FT FormatFma(FT a, FT b, FT c);
+
+  // Widening MAC with a single rounding to FTACC (see "vfwmacc/fmlal/bfmlal"). Supports f16 and bf16 into f32 as well
+  // as f32 into f64. Signaling NaN operands raise invalid just like for Fma<FTACC>.
+  template <typename FTIN, typename FTACC, RoundingMode rm>
+  FTACC FmaWiden(FTIN a, FTIN b, FTACC c);
+  template <typename FTIN, typename FTACC>
+  FTACC FmaWiden(FTIN a, FTIN b, FTACC c);
+
+  template <RoundingMode rm>
+  FfUtils::f32 FmaBF16(FfUtils::bf16 a, FfUtils::bf16 b, FfUtils::f32 c);  // Widening MAC (see "vfwmaccbf16/bfmlal").
+  FfUtils::f32 FmaBF16(FfUtils::bf16 a, FfUtils::bf16 b, FfUtils::f32 c);
+
+  template <typename FT, RoundingMode rm, bool exact>
+  FT RoundToIntegral(FT a);  // If "exact" is set, non-integral inputs raise inexact.
+  template <typename FT, bool exact>
+  FT RoundToIntegral(FT a);
+
+  template <typename FT>
+  FT RecipEstimateRiscv(FT a);  // RISC-V "V" 7-bit reciprocal estimate (see "vfrec7.v").
+  template <typename FT>
+  FT RsqrtEstimateRiscv(FT a);  // RISC-V "V" 7-bit reciprocal square root estimate (see "vfrsqrt7.v").
+  template <typename FT>
+  FT RecipEstimateArm(FT a);  // ARM64 8-bit reciprocal estimate (see "frecpe").
+  template <typename FT>
+  FT RsqrtEstimateArm(FT a);  // ARM64 8-bit reciprocal square root estimate (see "frsqrte").
+  template <typename FT>
+  FT RecipExponentArm(FT a);  // ARM64 reciprocal exponent (see "frecpx").
+  template <typename FT>
+  FT RecipStepArm(FT a, FT b);  // ARM64 fused 2 - a * b (see "frecps").
+  template <typename FT>
+  FT RsqrtStepArm(FT a, FT b);  // ARM64 fused (3 - a * b) / 2 (see "frsqrts").
+
   template <typename FT>
   bool EqQuiet(FT a, FT b);
   template <typename FT>
@@ -60,6 +127,10 @@ class FloppyFloat : public SoftFloat {
   bool LeSignaling(FT a, FT b);
   template <typename FT>
   bool LtSignaling(FT a, FT b);
+  template <typename FT, bool signaling>
+  FfUtils::u8 CompareArm(FT a, FT b);  // Returns NZCV in bits 3..0 (see "fcmp/fcmpe").
+  template <typename FT, bool signaling>
+  FfUtils::u8 CompareX86(FT a, FT b);  // Returns ZF, PF, and CF at their EFLAGS positions (see "ucomiss/comiss").
 
   template <typename FT>
   FT Maxx86(FT a, FT b);  // x86 legacy maximum (see "maxss/maxsd");
@@ -69,12 +140,20 @@ class FloppyFloat : public SoftFloat {
   FT MaximumNumber(FT a, FT b);
   template <typename FT>
   FT MinimumNumber(FT a, FT b);
+  template <typename FT>
+  FT Maximum(FT a, FT b);  // NaN-propagating maximum (see IEEE 754-2019 "9.6 Minimum and maximum operations").
+  template <typename FT>
+  FT Minimum(FT a, FT b);  // NaN-propagating minimum (see IEEE 754-2019 "9.6 Minimum and maximum operations").
 
   template <typename FT>
   FfUtils::u32 Class(FT a);
 
+  template <typename FT>
+  FT Fli(FfUtils::u32 index);  // RISC-V Zfa floating-point load immediate (see "fli.h/fli.s/fli.d").
+
   FfUtils::f32 F16ToF32(FfUtils::f16 a);
   FfUtils::f64 F16ToF64(FfUtils::f16 a);
+  FfUtils::f32 BF16ToF32(FfUtils::bf16 a);
 
   template <RoundingMode rm>
   FfUtils::i32 F32ToI32(FfUtils::f32 a);
@@ -96,6 +175,19 @@ class FloppyFloat : public SoftFloat {
   FfUtils::f16 F32ToF16(FfUtils::f32 a);
   FfUtils::f16 F32ToF16(FfUtils::f32 a);
 
+  template <RoundingMode rm>
+  FfUtils::bf16 F32ToBF16(FfUtils::f32 a);
+  FfUtils::bf16 F32ToBF16(FfUtils::f32 a);
+
+  // OCP FP8 conversions always round to nearest even (or stochastically) independent of "rounding_mode".
+  // With "saturate", overflows and infinities are clamped to the largest finite value (see "cvt.satfinite").
+  template <typename FP8, bool saturate, typename FT>
+  FP8 FToFp8(FT a);
+  template <typename FP8, bool saturate, typename FT>
+  FP8 FToFp8Stochastic(FT a, FfUtils::u32 random);  // Rounds up if "random" plus the discarded bits carries out.
+  template <typename FP8>
+  FfUtils::f32 Fp8ToF32(FP8 a);
+
   FfUtils::f64 F32ToF64(FfUtils::f32 a);
 
   template <RoundingMode rm>
@@ -110,6 +202,8 @@ class FloppyFloat : public SoftFloat {
   FfUtils::i32 F64ToI32(FfUtils::f64 a);
   FfUtils::i32 F64ToI32(FfUtils::f64 a);
 
+  FfUtils::i32 F64ToI32Modular(FfUtils::f64 a);  // RISC-V Zfa modular conversion (see "fcvtmod.w.d").
+
   template <RoundingMode rm>
   FfUtils::i64 F64ToI64(FfUtils::f64 a);
   FfUtils::i64 F64ToI64(FfUtils::f64 a);
@@ -122,6 +216,22 @@ class FloppyFloat : public SoftFloat {
   FfUtils::u64 F64ToU64(FfUtils::f64 a);
   FfUtils::u64 F64ToU64(FfUtils::f64 a);
 
+  template <RoundingMode rm>
+  FfUtils::f32 F128ToF32(FfUtils::f128 a);
+  FfUtils::f32 F128ToF32(FfUtils::f128 a);
+
+  template <RoundingMode rm>
+  FfUtils::f64 F128ToF64(FfUtils::f128 a);
+  FfUtils::f64 F128ToF64(FfUtils::f128 a);
+
+  // Widening f128 conversions and integer to f128 conversions are always exact.
+  FfUtils::f128 F32ToF128(FfUtils::f32 a);
+  FfUtils::f128 F64ToF128(FfUtils::f64 a);
+  FfUtils::f128 I32ToF128(FfUtils::i32 a);
+  FfUtils::f128 U32ToF128(FfUtils::u32 a);
+  FfUtils::f128 I64ToF128(FfUtils::i64 a);
+  FfUtils::f128 U64ToF128(FfUtils::u64 a);
+
   template <RoundingMode rm>
   FfUtils::f16 I32ToF16(FfUtils::i32 a);
   FfUtils::f16 I32ToF16(FfUtils::i32 a);
@@ -143,6 +253,25 @@ class FloppyFloat : public SoftFloat {
   template <typename FT, typename TFT, RoundingMode rm>
   constexpr FT RoundResult(TFT residual, FT result);
 
+  template <typename OP>
+  auto CallHostF16(OP op);
+
+  template <typename FT, RoundingMode rm>
+  FT AddImpl(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT SubImpl(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT MulImpl(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT DivImpl(FT a, FT b);
+  template <typename FT, RoundingMode rm>
+  FT SqrtImpl(FT a);
+  template <typename FT, RoundingMode rm>
+  FT FmaImpl(FT a, FT b, FT c);
+  template <RoundingMode rm>
+  FfUtils::f16 F32ToF16Impl(FfUtils::f32 a);
+  FfUtils::f32 F16ToF32Impl(FfUtils::f16 a);
+
   template <typename TFROM, typename TTO>
   constexpr TTO PropagateNan(TFROM a);
 
@@ -152,6 +281,12 @@ class FloppyFloat : public SoftFloat {
   template <typename FT>
   constexpr FT PropagateNan(FT a, FT b, FT c);
 
+  template <typename FT, RoundingMode rm, typename OP>
+  FT RoundViaF64(OP op);
+
+  template <typename MT, bool saturate, bool stochastic>
+  FfUtils::u8 RoundToMiniFloat(FfUtils::f32 a, FfUtils::u32 random);
+
   template <typename FT, FloppyFloat::RoundingMode rm>
   constexpr auto UpMul(FT a, FT b, FT& c);
   template <typename FT, FloppyFloat::RoundingMode rm>
@@ -162,4 +297,7 @@ class FloppyFloat : public SoftFloat {
   constexpr auto UpFma(FT a, FT b, FT c, FT& d);
 
   // constexpr FfUtils::f64 PropagateNan(FfUtils::f32 a);
+
+ private:
+  HostF16 host_f16_;
 };
\ No newline at end of file
@@ -0,0 +1,648 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "lut_float.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace FfUtils;
+
+constexpr size_t kTableSize = 1 << 16;  // One entry per 16-bit input.
+
+LutFloat::LutFloat() : FloppyFloat(), host_gather_(DetectHostGather()) {}
+
+LutFloat::HostGather LutFloat::DetectHostGather() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return kHostGatherAvx512;
+  if (__builtin_cpu_supports("avx2"))
+    return kHostGatherAvx2;
+#endif
+  return kHostGatherNone;
+}
+
+void LutFloat::SetHostGather(HostGather host_gather) {
+  host_gather_ = std::min(host_gather, DetectHostGather());
+}
+
+void LutFloat::SetupToArm() {
+  FloppyFloat::SetupToArm();
+  InvalidateTables();
+}
+
+void LutFloat::SetupToRiscv() {
+  FloppyFloat::SetupToRiscv();
+  InvalidateTables();
+}
+
+void LutFloat::SetupToX86() {
+  FloppyFloat::SetupToX86();
+  InvalidateTables();
+}
+
+template <typename FT>
+void LutFloat::SetQnan(typename FloatToUint<FT>::type val) {
+  FloppyFloat::SetQnan<FT>(val);
+  InvalidateTables();
+}
+
+template void LutFloat::SetQnan<f16>(u16 val);
+template void LutFloat::SetQnan<bf16>(u16 val);
+template void LutFloat::SetQnan<f32>(u32 val);
+template void LutFloat::SetQnan<f64>(u64 val);
+template void LutFloat::SetQnan<f128>(u128 val);
+
+void LutFloat::InvalidateTables() {
+  // Also releases the memory.
+  sqrt_ = {};
+  recip_estimate_riscv_ = {};
+  rsqrt_estimate_riscv_ = {};
+  recip_estimate_arm_ = {};
+  rsqrt_estimate_arm_ = {};
+  f16_to_i32_ = {};
+  f16_to_i64_ = {};
+  f16_to_u32_ = {};
+  f16_to_u64_ = {};
+  class_ = {};
+  f16_to_f32_ = {};
+  f16_to_f64_ = {};
+  fp8e4m3_ = {};
+  fp8e5m2_ = {};
+}
+
+void LutFloat::RaiseFlags(u8 flags) {
+  if (flags & 0x10)
+    SetInvalid();
+  if (flags & 0x08)
+    SetDivisionByZero();
+  if (flags & 0x04)
+    SetOverflow();
+  if (flags & 0x02)
+    SetUnderflow();
+  if (flags & 0x01)
+    SetInexact();
+}
+
+// Evaluates "op" for every 16-bit index with cleared flags. The caller's flags are preserved.
+template <typename T, typename OP>
+void LutFloat::BuildTable(Table<T>& table, OP op) {
+  u8 old_flags = GetFlagsRiscv();
+  bool old_flags_dirty = flags_dirty;
+  table.resize(kTableSize);
+  for (size_t i = 0; i < kTableSize; ++i) {
+    ClearFlags();
+    T result = op(static_cast<u16>(i));
+    table[i] = {result, GetFlagsRiscv()};
+  }
+  invalid = old_flags & 0x10;
+  division_by_zero = old_flags & 0x08;
+  overflow = old_flags & 0x04;
+  underflow = old_flags & 0x02;
+  inexact = old_flags & 0x01;
+  flags_dirty = old_flags_dirty;
+}
+
+template <typename T, typename OP>
+T LutFloat::Lookup(Table<T>& table, f16 a, OP op) {
+  if (table.empty()) [[unlikely]]
+    BuildTable(table, [&op](u16 i) { return op(std::bit_cast<f16>(i)); });
+
+  const Entry<T>& entry = table[std::bit_cast<u16>(a)];
+  if (entry.flags) [[unlikely]]
+    RaiseFlags(entry.flags);
+  return entry.result;
+}
+
+template <typename FT, LutFloat::RoundingMode rm>
+FT LutFloat::Sqrt(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    return Lookup(sqrt_[rm], a, [this](f16 x) { return FloppyFloat::Sqrt<f16, rm>(x); });
+  } else {
+    return FloppyFloat::Sqrt<FT, rm>(a);
+  }
+}
+
+template f16 LutFloat::Sqrt<f16, LutFloat::kRoundTiesToEven>(f16 a);
+template f16 LutFloat::Sqrt<f16, LutFloat::kRoundTowardPositive>(f16 a);
+template f16 LutFloat::Sqrt<f16, LutFloat::kRoundTowardNegative>(f16 a);
+template f16 LutFloat::Sqrt<f16, LutFloat::kRoundTowardZero>(f16 a);
+template f16 LutFloat::Sqrt<f16, LutFloat::kRoundTiesToAway>(f16 a);
+
+template f32 LutFloat::Sqrt<f32, LutFloat::kRoundTiesToEven>(f32 a);
+template f32 LutFloat::Sqrt<f32, LutFloat::kRoundTowardPositive>(f32 a);
+template f32 LutFloat::Sqrt<f32, LutFloat::kRoundTowardNegative>(f32 a);
+template f32 LutFloat::Sqrt<f32, LutFloat::kRoundTowardZero>(f32 a);
+template f32 LutFloat::Sqrt<f32, LutFloat::kRoundTiesToAway>(f32 a);
+
+template f64 LutFloat::Sqrt<f64, LutFloat::kRoundTiesToEven>(f64 a);
+template f64 LutFloat::Sqrt<f64, LutFloat::kRoundTowardPositive>(f64 a);
+template f64 LutFloat::Sqrt<f64, LutFloat::kRoundTowardNegative>(f64 a);
+template f64 LutFloat::Sqrt<f64, LutFloat::kRoundTowardZero>(f64 a);
+template f64 LutFloat::Sqrt<f64, LutFloat::kRoundTiesToAway>(f64 a);
+
+template f128 LutFloat::Sqrt<f128, LutFloat::kRoundTiesToEven>(f128 a);
+template f128 LutFloat::Sqrt<f128, LutFloat::kRoundTowardPositive>(f128 a);
+template f128 LutFloat::Sqrt<f128, LutFloat::kRoundTowardNegative>(f128 a);
+template f128 LutFloat::Sqrt<f128, LutFloat::kRoundTowardZero>(f128 a);
+template f128 LutFloat::Sqrt<f128, LutFloat::kRoundTiesToAway>(f128 a);
+
+template <typename FT>
+FT LutFloat::Sqrt(FT a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Sqrt<FT, kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return Sqrt<FT, kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return Sqrt<FT, kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return Sqrt<FT, kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return Sqrt<FT, kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f16 LutFloat::Sqrt<f16>(f16 a);
+template f32 LutFloat::Sqrt<f32>(f32 a);
+template f64 LutFloat::Sqrt<f64>(f64 a);
+template f128 LutFloat::Sqrt<f128>(f128 a);
+
+template <typename T>
+LutFloat::Table<T>& LutFloat::RmTable(RmTables<T>& tables) {
+  if (static_cast<size_t>(rounding_mode) >= kNumRoundingModes) [[unlikely]]
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  return tables[rounding_mode];
+}
+
+// The estimates only depend on the rounding mode for overflows, which is why they read "rounding_mode" directly.
+template <typename FT>
+FT LutFloat::RecipEstimateRiscv(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    return Lookup(RmTable(recip_estimate_riscv_), a, [this](f16 x) { return FloppyFloat::RecipEstimateRiscv<f16>(x); });
+  } else {
+    return FloppyFloat::RecipEstimateRiscv<FT>(a);
+  }
+}
+
+template f16 LutFloat::RecipEstimateRiscv<f16>(f16 a);
+template f32 LutFloat::RecipEstimateRiscv<f32>(f32 a);
+template f64 LutFloat::RecipEstimateRiscv<f64>(f64 a);
+
+template <typename FT>
+FT LutFloat::RsqrtEstimateRiscv(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    return Lookup(RmTable(rsqrt_estimate_riscv_), a, [this](f16 x) { return FloppyFloat::RsqrtEstimateRiscv<f16>(x); });
+  } else {
+    return FloppyFloat::RsqrtEstimateRiscv<FT>(a);
+  }
+}
+
+template f16 LutFloat::RsqrtEstimateRiscv<f16>(f16 a);
+template f32 LutFloat::RsqrtEstimateRiscv<f32>(f32 a);
+template f64 LutFloat::RsqrtEstimateRiscv<f64>(f64 a);
+
+template <typename FT>
+FT LutFloat::RecipEstimateArm(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    return Lookup(RmTable(recip_estimate_arm_), a, [this](f16 x) { return FloppyFloat::RecipEstimateArm<f16>(x); });
+  } else {
+    return FloppyFloat::RecipEstimateArm<FT>(a);
+  }
+}
+
+template f16 LutFloat::RecipEstimateArm<f16>(f16 a);
+template f32 LutFloat::RecipEstimateArm<f32>(f32 a);
+template f64 LutFloat::RecipEstimateArm<f64>(f64 a);
+
+template <typename FT>
+FT LutFloat::RsqrtEstimateArm(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    return Lookup(RmTable(rsqrt_estimate_arm_), a, [this](f16 x) { return FloppyFloat::RsqrtEstimateArm<f16>(x); });
+  } else {
+    return FloppyFloat::RsqrtEstimateArm<FT>(a);
+  }
+}
+
+template f16 LutFloat::RsqrtEstimateArm<f16>(f16 a);
+template f32 LutFloat::RsqrtEstimateArm<f32>(f32 a);
+template f64 LutFloat::RsqrtEstimateArm<f64>(f64 a);
+
+template <typename FT>
+u32 LutFloat::Class(FT a) {
+  if constexpr (std::is_same_v<FT, f16>) {
+    return Lookup(class_, a, [this](f16 x) { return FloppyFloat::Class<f16>(x); });
+  } else {
+    return FloppyFloat::Class<FT>(a);
+  }
+}
+
+template u32 LutFloat::Class<f16>(f16 a);
+template u32 LutFloat::Class<f32>(f32 a);
+template u32 LutFloat::Class<f64>(f64 a);
+template u32 LutFloat::Class<f128>(f128 a);
+
+f32 LutFloat::F16ToF32(f16 a) {
+  return Lookup(f16_to_f32_, a, [this](f16 x) { return FloppyFloat::F16ToF32(x); });
+}
+
+f64 LutFloat::F16ToF64(f16 a) {
+  return Lookup(f16_to_f64_, a, [this](f16 x) { return FloppyFloat::F16ToF64(x); });
+}
+
+template <LutFloat::RoundingMode rm>
+i32 LutFloat::F16ToI32(f16 a) {
+  return Lookup(f16_to_i32_[rm], a, [this](f16 x) {
+    RmGuard rg(this, rm);
+    return FloppyFloat::F16ToI32(x);
+  });
+}
+
+template i32 LutFloat::F16ToI32<LutFloat::kRoundTiesToEven>(f16 a);
+template i32 LutFloat::F16ToI32<LutFloat::kRoundTowardPositive>(f16 a);
+template i32 LutFloat::F16ToI32<LutFloat::kRoundTowardNegative>(f16 a);
+template i32 LutFloat::F16ToI32<LutFloat::kRoundTowardZero>(f16 a);
+template i32 LutFloat::F16ToI32<LutFloat::kRoundTiesToAway>(f16 a);
+
+i32 LutFloat::F16ToI32(f16 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F16ToI32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F16ToI32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F16ToI32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F16ToI32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F16ToI32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <LutFloat::RoundingMode rm>
+i64 LutFloat::F16ToI64(f16 a) {
+  return Lookup(f16_to_i64_[rm], a, [this](f16 x) {
+    RmGuard rg(this, rm);
+    return FloppyFloat::F16ToI64(x);
+  });
+}
+
+template i64 LutFloat::F16ToI64<LutFloat::kRoundTiesToEven>(f16 a);
+template i64 LutFloat::F16ToI64<LutFloat::kRoundTowardPositive>(f16 a);
+template i64 LutFloat::F16ToI64<LutFloat::kRoundTowardNegative>(f16 a);
+template i64 LutFloat::F16ToI64<LutFloat::kRoundTowardZero>(f16 a);
+template i64 LutFloat::F16ToI64<LutFloat::kRoundTiesToAway>(f16 a);
+
+i64 LutFloat::F16ToI64(f16 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F16ToI64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F16ToI64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F16ToI64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F16ToI64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F16ToI64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <LutFloat::RoundingMode rm>
+u32 LutFloat::F16ToU32(f16 a) {
+  return Lookup(f16_to_u32_[rm], a, [this](f16 x) {
+    RmGuard rg(this, rm);
+    return FloppyFloat::F16ToU32(x);
+  });
+}
+
+template u32 LutFloat::F16ToU32<LutFloat::kRoundTiesToEven>(f16 a);
+template u32 LutFloat::F16ToU32<LutFloat::kRoundTowardPositive>(f16 a);
+template u32 LutFloat::F16ToU32<LutFloat::kRoundTowardNegative>(f16 a);
+template u32 LutFloat::F16ToU32<LutFloat::kRoundTowardZero>(f16 a);
+template u32 LutFloat::F16ToU32<LutFloat::kRoundTiesToAway>(f16 a);
+
+u32 LutFloat::F16ToU32(f16 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F16ToU32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F16ToU32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F16ToU32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F16ToU32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F16ToU32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template <LutFloat::RoundingMode rm>
+u64 LutFloat::F16ToU64(f16 a) {
+  return Lookup(f16_to_u64_[rm], a, [this](f16 x) {
+    RmGuard rg(this, rm);
+    return FloppyFloat::F16ToU64(x);
+  });
+}
+
+template u64 LutFloat::F16ToU64<LutFloat::kRoundTiesToEven>(f16 a);
+template u64 LutFloat::F16ToU64<LutFloat::kRoundTowardPositive>(f16 a);
+template u64 LutFloat::F16ToU64<LutFloat::kRoundTowardNegative>(f16 a);
+template u64 LutFloat::F16ToU64<LutFloat::kRoundTowardZero>(f16 a);
+template u64 LutFloat::F16ToU64<LutFloat::kRoundTiesToAway>(f16 a);
+
+u64 LutFloat::F16ToU64(f16 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F16ToU64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F16ToU64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F16ToU64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F16ToU64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F16ToU64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+// Computes the result exactly in f64 and rounds only once. This works because f64 holds every sum and product of two
+// FP8 values exactly. The conversion to f32 rounds to odd, which does not change the final rounding to FP8.
+template <typename FP8>
+u8 LutFloat::Fp8Compute(Fp8Op op, FP8 a, FP8 b) {
+  f32 fa = Fp8ToF32<FP8>(a);  // Raises invalid for signaling NaNs.
+  f32 fb = Fp8ToF32<FP8>(b);
+  f64 r;
+  switch (op) {
+  case kFp8Add:
+  case kFp8AddSaturate:
+    r = static_cast<f64>(fa) + static_cast<f64>(fb);
+    break;
+  case kFp8Sub:
+  case kFp8SubSaturate:
+    r = static_cast<f64>(fa) - static_cast<f64>(fb);
+    break;
+  case kFp8Mul:
+  case kFp8MulSaturate:
+    r = static_cast<f64>(fa) * static_cast<f64>(fb);
+    break;
+  case kFp8MaximumNumber:
+    r = MaximumNumber<f32>(fa, fb);
+    break;
+  case kFp8MinimumNumber:
+    r = MinimumNumber<f32>(fa, fb);
+    break;
+  case kFp8EqQuiet:
+    return EqQuiet<f32>(fa, fb);
+  case kFp8LtQuiet:
+    return LtQuiet<f32>(fa, fb);
+  case kFp8LeQuiet:
+    return LeQuiet<f32>(fa, fb);
+  default:
+    throw std::runtime_error(std::string("Unknown FP8 operation"));
+  }
+
+  if (std::isnan(r)) [[unlikely]] {
+    if (!std::isnan(fa) && !std::isnan(fb))  // ∞ - ∞ or 0 × ∞
+      SetInvalid();
+    return MiniFloatFormat<FP8>::kNanCode;
+  }
+
+  f32 rf = static_cast<f32>(r);
+  if (static_cast<f64>(rf) != r) {
+    if (std::abs(static_cast<f64>(rf)) > std::abs(r))
+      rf = std::nextafter(rf, 0.f32);
+    rf = std::bit_cast<f32>(std::bit_cast<u32>(rf) | 1u);
+  }
+
+  if (op == kFp8AddSaturate || op == kFp8SubSaturate || op == kFp8MulSaturate)
+    return FToFp8<FP8, true, f32>(rf).v;
+  else
+    return FToFp8<FP8, false, f32>(rf).v;
+}
+
+template <typename FP8>
+const LutFloat::Entry<u8>* LutFloat::Fp8Table(Fp8Op op) {
+  Table<u8>& table = std::is_same_v<FP8, fp8e4m3> ? fp8e4m3_[op] : fp8e5m2_[op];
+  if (table.empty()) [[unlikely]] {
+    BuildTable(table, [this, op](u16 i) {
+      return Fp8Compute<FP8>(op, FP8{static_cast<u8>(i >> 8)}, FP8{static_cast<u8>(i)});
+    });
+    table.push_back({0, 0});  // The 32-bit gathers of the last entry also read this one.
+  }
+  return table.data();
+}
+
+template <typename FP8>
+u8 LutFloat::Fp8Lookup(Fp8Op op, FP8 a, FP8 b) {
+  const Entry<u8>& entry = Fp8Table<FP8>(op)[(a.v << 8) | b.v];
+  if (entry.flags) [[unlikely]]
+    RaiseFlags(entry.flags);
+  return entry.result;
+}
+
+template <typename FP8, bool saturate>
+FP8 LutFloat::Fp8Add(FP8 a, FP8 b) {
+  return FP8{Fp8Lookup(saturate ? kFp8AddSaturate : kFp8Add, a, b)};
+}
+
+template fp8e4m3 LutFloat::Fp8Add<fp8e4m3, false>(fp8e4m3 a, fp8e4m3 b);
+template fp8e4m3 LutFloat::Fp8Add<fp8e4m3, true>(fp8e4m3 a, fp8e4m3 b);
+template fp8e5m2 LutFloat::Fp8Add<fp8e5m2, false>(fp8e5m2 a, fp8e5m2 b);
+template fp8e5m2 LutFloat::Fp8Add<fp8e5m2, true>(fp8e5m2 a, fp8e5m2 b);
+
+template <typename FP8, bool saturate>
+FP8 LutFloat::Fp8Sub(FP8 a, FP8 b) {
+  return FP8{Fp8Lookup(saturate ? kFp8SubSaturate : kFp8Sub, a, b)};
+}
+
+template fp8e4m3 LutFloat::Fp8Sub<fp8e4m3, false>(fp8e4m3 a, fp8e4m3 b);
+template fp8e4m3 LutFloat::Fp8Sub<fp8e4m3, true>(fp8e4m3 a, fp8e4m3 b);
+template fp8e5m2 LutFloat::Fp8Sub<fp8e5m2, false>(fp8e5m2 a, fp8e5m2 b);
+template fp8e5m2 LutFloat::Fp8Sub<fp8e5m2, true>(fp8e5m2 a, fp8e5m2 b);
+
+template <typename FP8, bool saturate>
+FP8 LutFloat::Fp8Mul(FP8 a, FP8 b) {
+  return FP8{Fp8Lookup(saturate ? kFp8MulSaturate : kFp8Mul, a, b)};
+}
+
+template fp8e4m3 LutFloat::Fp8Mul<fp8e4m3, false>(fp8e4m3 a, fp8e4m3 b);
+template fp8e4m3 LutFloat::Fp8Mul<fp8e4m3, true>(fp8e4m3 a, fp8e4m3 b);
+template fp8e5m2 LutFloat::Fp8Mul<fp8e5m2, false>(fp8e5m2 a, fp8e5m2 b);
+template fp8e5m2 LutFloat::Fp8Mul<fp8e5m2, true>(fp8e5m2 a, fp8e5m2 b);
+
+template <typename FP8>
+FP8 LutFloat::Fp8MaximumNumber(FP8 a, FP8 b) {
+  return FP8{Fp8Lookup(kFp8MaximumNumber, a, b)};
+}
+
+template fp8e4m3 LutFloat::Fp8MaximumNumber<fp8e4m3>(fp8e4m3 a, fp8e4m3 b);
+template fp8e5m2 LutFloat::Fp8MaximumNumber<fp8e5m2>(fp8e5m2 a, fp8e5m2 b);
+
+template <typename FP8>
+FP8 LutFloat::Fp8MinimumNumber(FP8 a, FP8 b) {
+  return FP8{Fp8Lookup(kFp8MinimumNumber, a, b)};
+}
+
+template fp8e4m3 LutFloat::Fp8MinimumNumber<fp8e4m3>(fp8e4m3 a, fp8e4m3 b);
+template fp8e5m2 LutFloat::Fp8MinimumNumber<fp8e5m2>(fp8e5m2 a, fp8e5m2 b);
+
+template <typename FP8>
+bool LutFloat::Fp8EqQuiet(FP8 a, FP8 b) {
+  return Fp8Lookup(kFp8EqQuiet, a, b);
+}
+
+template bool LutFloat::Fp8EqQuiet<fp8e4m3>(fp8e4m3 a, fp8e4m3 b);
+template bool LutFloat::Fp8EqQuiet<fp8e5m2>(fp8e5m2 a, fp8e5m2 b);
+
+template <typename FP8>
+bool LutFloat::Fp8LtQuiet(FP8 a, FP8 b) {
+  return Fp8Lookup(kFp8LtQuiet, a, b);
+}
+
+template bool LutFloat::Fp8LtQuiet<fp8e4m3>(fp8e4m3 a, fp8e4m3 b);
+template bool LutFloat::Fp8LtQuiet<fp8e5m2>(fp8e5m2 a, fp8e5m2 b);
+
+template <typename FP8>
+bool LutFloat::Fp8LeQuiet(FP8 a, FP8 b) {
+  return Fp8Lookup(kFp8LeQuiet, a, b);
+}
+
+template bool LutFloat::Fp8LeQuiet<fp8e4m3>(fp8e4m3 a, fp8e4m3 b);
+template bool LutFloat::Fp8LeQuiet<fp8e5m2>(fp8e5m2 a, fp8e5m2 b);
+
+#if defined(__x86_64__) || defined(__i386__)
+// Each 32-bit gather at byte offset 2 * index loads the result and flags of an entry into its low 16 bits, and the next
+// entry into the high 16 bits, which are discarded. Returns the number of processed elements and ORs the flags into
+// "flags".
+[[gnu::target("avx512f")]] static size_t Fp8GatherAvx512(const void* table, const u8* a, const u8* b, u8* dest,
+                                                         size_t len, u8& flags) {
+  __m512i acc = _mm512_setzero_si512();
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512i va = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+    __m512i vb = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    __m512i entries = _mm512_i32gather_epi32(_mm512_or_si512(_mm512_slli_epi32(va, 8), vb), table, 2);
+    acc = _mm512_or_si512(acc, entries);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm512_cvtepi32_epi8(entries));
+  }
+  flags |= static_cast<u8>(_mm512_reduce_or_epi32(acc) >> 8);
+  return i;
+}
+
+[[gnu::target("avx2")]] static size_t Fp8GatherAvx2(const void* table, const u8* a, const u8* b, u8* dest, size_t len,
+                                                    u8& flags) {
+  const __m256i results = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+                                           0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  __m256i acc = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256i va = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i)));
+    __m256i vb = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + i)));
+    __m256i entries =
+        _mm256_i32gather_epi32(static_cast<const int*>(table), _mm256_or_si256(_mm256_slli_epi32(va, 8), vb), 2);
+    acc = _mm256_or_si256(acc, entries);
+    __m256i packed = _mm256_shuffle_epi8(entries, results);  // Result bytes in the low 4 bytes of each 128-bit lane.
+    u64 bytes = static_cast<u32>(_mm256_extract_epi32(packed, 0)) |
+                (static_cast<u64>(static_cast<u32>(_mm256_extract_epi32(packed, 4))) << 32);
+    std::memcpy(dest + i, &bytes, sizeof(bytes));
+  }
+  __m128i acc128 = _mm_or_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  acc128 = _mm_or_si128(acc128, _mm_shuffle_epi32(acc128, 0x4e));
+  acc128 = _mm_or_si128(acc128, _mm_shuffle_epi32(acc128, 0xb1));
+  flags |= static_cast<u8>(_mm_cvtsi128_si32(acc128) >> 8);
+  return i;
+}
+#endif
+
+// The flags of all elements are OR-reduced, so they are raised with a single (unlikely) branch.
+template <typename FP8>
+void LutFloat::VFp8Lookup(Fp8Op op, FP8* a, FP8* b, FP8* dest, size_t len) {
+  static_assert(sizeof(FP8) == 1 && sizeof(Entry<u8>) == 2);
+  const Entry<u8>* table = Fp8Table<FP8>(op);
+  u8 flags = 0;
+  size_t i = 0;
+#if defined(__x86_64__) || defined(__i386__)
+  auto pa = reinterpret_cast<const u8*>(a);
+  auto pb = reinterpret_cast<const u8*>(b);
+  auto pd = reinterpret_cast<u8*>(dest);
+  if (host_gather_ == kHostGatherAvx512)
+    i = Fp8GatherAvx512(table, pa, pb, pd, len, flags);
+  else if (host_gather_ == kHostGatherAvx2)
+    i = Fp8GatherAvx2(table, pa, pb, pd, len, flags);
+#endif
+  for (; i < len; ++i) {
+    Entry<u8> entry = table[(a[i].v << 8) | b[i].v];
+    dest[i].v = entry.result;
+    flags |= entry.flags;
+  }
+  if (flags) [[unlikely]]
+    RaiseFlags(flags);
+}
+
+template <typename FP8, bool saturate>
+void LutFloat::VFp8Add(FP8* a, FP8* b, FP8* dest, size_t len) {
+  VFp8Lookup(saturate ? kFp8AddSaturate : kFp8Add, a, b, dest, len);
+}
+
+template void LutFloat::VFp8Add<fp8e4m3, false>(fp8e4m3* a, fp8e4m3* b, fp8e4m3* dest, size_t len);
+template void LutFloat::VFp8Add<fp8e4m3, true>(fp8e4m3* a, fp8e4m3* b, fp8e4m3* dest, size_t len);
+template void LutFloat::VFp8Add<fp8e5m2, false>(fp8e5m2* a, fp8e5m2* b, fp8e5m2* dest, size_t len);
+template void LutFloat::VFp8Add<fp8e5m2, true>(fp8e5m2* a, fp8e5m2* b, fp8e5m2* dest, size_t len);
+
+template <typename FP8, bool saturate>
+void LutFloat::VFp8Sub(FP8* a, FP8* b, FP8* dest, size_t len) {
+  VFp8Lookup(saturate ? kFp8SubSaturate : kFp8Sub, a, b, dest, len);
+}
+
+template void LutFloat::VFp8Sub<fp8e4m3, false>(fp8e4m3* a, fp8e4m3* b, fp8e4m3* dest, size_t len);
+template void LutFloat::VFp8Sub<fp8e4m3, true>(fp8e4m3* a, fp8e4m3* b, fp8e4m3* dest, size_t len);
+template void LutFloat::VFp8Sub<fp8e5m2, false>(fp8e5m2* a, fp8e5m2* b, fp8e5m2* dest, size_t len);
+template void LutFloat::VFp8Sub<fp8e5m2, true>(fp8e5m2* a, fp8e5m2* b, fp8e5m2* dest, size_t len);
+
+template <typename FP8, bool saturate>
+void LutFloat::VFp8Mul(FP8* a, FP8* b, FP8* dest, size_t len) {
+  VFp8Lookup(saturate ? kFp8MulSaturate : kFp8Mul, a, b, dest, len);
+}
+
+template void LutFloat::VFp8Mul<fp8e4m3, false>(fp8e4m3* a, fp8e4m3* b, fp8e4m3* dest, size_t len);
+template void LutFloat::VFp8Mul<fp8e4m3, true>(fp8e4m3* a, fp8e4m3* b, fp8e4m3* dest, size_t len);
+template void LutFloat::VFp8Mul<fp8e5m2, false>(fp8e5m2* a, fp8e5m2* b, fp8e5m2* dest, size_t len);
+template void LutFloat::VFp8Mul<fp8e5m2, true>(fp8e5m2* a, fp8e5m2* b, fp8e5m2* dest, size_t len);
+
+template <typename FP8>
+void LutFloat::VFp8MaximumNumber(FP8* a, FP8* b, FP8* dest, size_t len) {
+  VFp8Lookup(kFp8MaximumNumber, a, b, dest, len);
+}
+
+template void LutFloat::VFp8MaximumNumber<fp8e4m3>(fp8e4m3* a, fp8e4m3* b, fp8e4m3* dest, size_t len);
+template void LutFloat::VFp8MaximumNumber<fp8e5m2>(fp8e5m2* a, fp8e5m2* b, fp8e5m2* dest, size_t len);
+
+template <typename FP8>
+void LutFloat::VFp8MinimumNumber(FP8* a, FP8* b, FP8* dest, size_t len) {
+  VFp8Lookup(kFp8MinimumNumber, a, b, dest, len);
+}
+
+template void LutFloat::VFp8MinimumNumber<fp8e4m3>(fp8e4m3* a, fp8e4m3* b, fp8e4m3* dest, size_t len);
+template void LutFloat::VFp8MinimumNumber<fp8e5m2>(fp8e5m2* a, fp8e5m2* b, fp8e5m2* dest, size_t len);
@@ -0,0 +1,174 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <array>
+#include <vector>
+
+#include "floppy_float.h"
+#include "utils.h"
+
+// Lookup tables for unary f16 operations and binary FP8 operations. With only 2^16 inputs (or input pairs), the result
+// and the exception flags of every input can be precomputed. A table is built from the computed path on the first use
+// of its operation and rounding mode, so it reflects the active profile (see SetupToArm/SetupToRiscv/SetupToX86).
+// Other types use the computed path.
+// Changing the profile via the public fields (e.g., "nan_propagation_scheme") requires a call to InvalidateTables.
+class LutFloat : public FloppyFloat {
+ public:
+  LutFloat();
+
+  void SetupToArm();
+  void SetupToRiscv();
+  void SetupToX86();
+  template <typename FT>
+  void SetQnan(typename FfUtils::FloatToUint<FT>::type val);
+
+  void InvalidateTables();
+
+  template <typename FT, RoundingMode rm>
+  FT Sqrt(FT a);
+  template <typename FT>
+  FT Sqrt(FT a);
+
+  template <typename FT>
+  FT RecipEstimateRiscv(FT a);
+  template <typename FT>
+  FT RsqrtEstimateRiscv(FT a);
+  template <typename FT>
+  FT RecipEstimateArm(FT a);
+  template <typename FT>
+  FT RsqrtEstimateArm(FT a);
+
+  template <typename FT>
+  FfUtils::u32 Class(FT a);
+
+  FfUtils::f32 F16ToF32(FfUtils::f16 a);
+  FfUtils::f64 F16ToF64(FfUtils::f16 a);
+
+  template <RoundingMode rm>
+  FfUtils::i32 F16ToI32(FfUtils::f16 a);
+  FfUtils::i32 F16ToI32(FfUtils::f16 a);
+
+  template <RoundingMode rm>
+  FfUtils::i64 F16ToI64(FfUtils::f16 a);
+  FfUtils::i64 F16ToI64(FfUtils::f16 a);
+
+  template <RoundingMode rm>
+  FfUtils::u32 F16ToU32(FfUtils::f16 a);
+  FfUtils::u32 F16ToU32(FfUtils::f16 a);
+
+  template <RoundingMode rm>
+  FfUtils::u64 F16ToU64(FfUtils::f16 a);
+  FfUtils::u64 F16ToU64(FfUtils::f16 a);
+
+  // Binary operations on the OCP FP8 formats, which have 2^16 operand pairs. The exact result is rounded like FToFp8,
+  // i.e., to nearest even independent of "rounding_mode", and saturated if "saturate" is set. NaN results are the
+  // positive NaN encoding. Comparisons are quiet, so only E5M2's signaling NaN raises invalid.
+  template <typename FP8, bool saturate>
+  FP8 Fp8Add(FP8 a, FP8 b);
+  template <typename FP8, bool saturate>
+  FP8 Fp8Sub(FP8 a, FP8 b);
+  template <typename FP8, bool saturate>
+  FP8 Fp8Mul(FP8 a, FP8 b);
+  template <typename FP8>
+  FP8 Fp8MaximumNumber(FP8 a, FP8 b);
+  template <typename FP8>
+  FP8 Fp8MinimumNumber(FP8 a, FP8 b);
+  template <typename FP8>
+  bool Fp8EqQuiet(FP8 a, FP8 b);
+  template <typename FP8>
+  bool Fp8LtQuiet(FP8 a, FP8 b);
+  template <typename FP8>
+  bool Fp8LeQuiet(FP8 a, FP8 b);
+
+  // Host instructions for the batch FP8 lookups. AVX2 and AVX-512 load 8 and 16 table entries per gather instruction,
+  // which is about three times faster than loading them one by one (see test_performance). SetHostGather clamps to
+  // DetectHostGather(), which is also the level chosen on construction.
+  enum HostGather { kHostGatherNone, kHostGatherAvx2, kHostGatherAvx512 };
+  static HostGather DetectHostGather();
+  HostGather GetHostGather() const { return host_gather_; }
+  void SetHostGather(HostGather host_gather);
+
+  // Element-wise batch versions. The flags of all elements are raised once at the end.
+  template <typename FP8, bool saturate>
+  void VFp8Add(FP8* a, FP8* b, FP8* dest, size_t len);
+  template <typename FP8, bool saturate>
+  void VFp8Sub(FP8* a, FP8* b, FP8* dest, size_t len);
+  template <typename FP8, bool saturate>
+  void VFp8Mul(FP8* a, FP8* b, FP8* dest, size_t len);
+  template <typename FP8>
+  void VFp8MaximumNumber(FP8* a, FP8* b, FP8* dest, size_t len);
+  template <typename FP8>
+  void VFp8MinimumNumber(FP8* a, FP8* b, FP8* dest, size_t len);
+
+ private:
+  static constexpr size_t kNumRoundingModes = 5;
+
+  HostGather host_gather_;
+
+  template <typename T>
+  struct Entry {
+    T result;
+    FfUtils::u8 flags;  // RISC-V "fflags" layout.
+  };
+
+  enum Fp8Op {
+    kFp8Add,
+    kFp8AddSaturate,
+    kFp8Sub,
+    kFp8SubSaturate,
+    kFp8Mul,
+    kFp8MulSaturate,
+    kFp8MaximumNumber,
+    kFp8MinimumNumber,
+    kFp8EqQuiet,
+    kFp8LtQuiet,
+    kFp8LeQuiet,
+    kNumFp8Ops
+  };
+
+  template <typename T>
+  using Table = std::vector<Entry<T>>;  // Empty until first use.
+
+  template <typename T>
+  using RmTables = std::array<Table<T>, kNumRoundingModes>;
+
+  RmTables<FfUtils::f16> sqrt_;
+  RmTables<FfUtils::f16> recip_estimate_riscv_;
+  RmTables<FfUtils::f16> rsqrt_estimate_riscv_;
+  RmTables<FfUtils::f16> recip_estimate_arm_;
+  RmTables<FfUtils::f16> rsqrt_estimate_arm_;
+  RmTables<FfUtils::i32> f16_to_i32_;
+  RmTables<FfUtils::i64> f16_to_i64_;
+  RmTables<FfUtils::u32> f16_to_u32_;
+  RmTables<FfUtils::u64> f16_to_u64_;
+  Table<FfUtils::u32> class_;
+  Table<FfUtils::f32> f16_to_f32_;
+  Table<FfUtils::f64> f16_to_f64_;
+  // Indexed by "(a << 8) | b". An entry is 16 bits, the result code in the low and the flags in the high byte.
+  std::array<Table<FfUtils::u8>, kNumFp8Ops> fp8e4m3_;
+  std::array<Table<FfUtils::u8>, kNumFp8Ops> fp8e5m2_;
+
+  void RaiseFlags(FfUtils::u8 flags);
+
+  template <typename T, typename OP>
+  void BuildTable(Table<T>& table, OP op);
+
+  template <typename T, typename OP>
+  T Lookup(Table<T>& table, FfUtils::f16 a, OP op);
+
+  // Returns the table of the current rounding mode, which is checked as it is used as an index.
+  template <typename T>
+  Table<T>& RmTable(RmTables<T>& tables);
+
+  template <typename FP8>
+  FfUtils::u8 Fp8Compute(Fp8Op op, FP8 a, FP8 b);
+  template <typename FP8>
+  const Entry<FfUtils::u8>* Fp8Table(Fp8Op op);
+  template <typename FP8>
+  FfUtils::u8 Fp8Lookup(Fp8Op op, FP8 a, FP8 b);
+  template <typename FP8>
+  void VFp8Lookup(Fp8Op op, FP8* a, FP8* b, FP8* dest, size_t len);
+};
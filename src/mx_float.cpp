@@ -0,0 +1,256 @@
+#include "mx_float.h"
+
+#include <algorithm>
+#include <experimental/simd>
+
+namespace stdx = std::experimental;
+
+using f32 = float;
+using FfUtils::u32;
+using FfUtils::u8;
+
+template <typename T>
+using fvec = stdx::native_simd<T>;
+
+using uvec = stdx::rebind_simd_t<u32, fvec<f32>>;
+
+static_assert(MxFloat::kMxBlockSize % fvec<f32>::size() == 0);
+
+template <typename ET>
+constexpr int MaxElementExponent() {
+  if constexpr (std::is_same_v<ET, FfUtils::mxint8>)
+    return 0;
+  else
+    return (FfUtils::MiniFloatFormat<ET>::kMaxCode >> FfUtils::MiniFloatFormat<ET>::kSigBits) -
+           FfUtils::MiniFloatFormat<ET>::kBias;
+}
+
+// Power of two for exponents in [-127, 127]; 2^-127 is subnormal.
+constexpr f32 Pow2(int exp) {
+  return std::bit_cast<f32>(exp > -127 ? static_cast<u32>(exp + 127) << 23 : 0x00400000u);
+}
+
+template <int bits>
+void PackElements(u8* codes, u8* dest, size_t len) {
+  u32 acc = 0;
+  int num_bits = 0;
+  for (size_t i = 0; i < len; ++i) {
+    acc |= static_cast<u32>(codes[i] & ((1u << bits) - 1)) << num_bits;
+    num_bits += bits;
+    while (num_bits >= 8) {
+      *dest++ = static_cast<u8>(acc);
+      acc >>= 8;
+      num_bits -= 8;
+    }
+  }
+  if (num_bits > 0)
+    *dest = static_cast<u8>(acc);
+}
+
+template <int bits>
+void UnpackElements(u8* src, u8* codes, size_t len) {
+  u32 acc = 0;
+  int num_bits = 0;
+  for (size_t i = 0; i < len; ++i) {
+    if (num_bits < bits) {
+      acc |= static_cast<u32>(*src++) << num_bits;
+      num_bits += 8;
+    }
+    codes[i] = static_cast<u8>(acc & ((1u << bits) - 1));
+    acc >>= bits;
+    num_bits -= bits;
+  }
+}
+
+template void MxFloat::MxQuantize<FfUtils::fp8e4m3, false>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                          u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::fp8e4m3, true>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                         u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::fp8e5m2, false>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                          u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::fp8e5m2, true>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                         u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::fp6e3m2, false>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                          u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::fp6e3m2, true>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                         u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::fp6e2m3, false>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                          u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::fp6e2m3, true>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                         u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::fp4e2m1, false>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                          u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::fp4e2m1, true>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                         u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::mxint8, false>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                         u8* block_flags);
+template void MxFloat::MxQuantize<FfUtils::mxint8, true>(f32* src, u8* scales, u8* elements, size_t len, u32* random,
+                                                        u8* block_flags);
+
+template <typename ET, bool stochastic>
+void MxFloat::MxQuantize(f32* src, u8* scales, u8* elements, size_t len, u32* random, u8* block_flags) {
+  for (size_t block = 0; block * kMxBlockSize < len; ++block) {
+    size_t first = block * kMxBlockSize;
+    size_t block_len = std::min(kMxBlockSize, len - first);
+    u32* block_random = stochastic ? &random[first] : nullptr;
+    u8* block_elements = &elements[MxElementBytes<ET>(first)];
+
+    if (block_flags == nullptr) {
+      MxQuantizeBlock<ET, stochastic>(&src[first], &scales[block], block_elements, block_len, block_random);
+      continue;
+    }
+
+    u8 old_flags = GetFlagsRiscv();
+    ClearFlags();
+    MxQuantizeBlock<ET, stochastic>(&src[first], &scales[block], block_elements, block_len, block_random);
+    block_flags[block] = GetFlagsRiscv();
+    u8 flags = old_flags | block_flags[block];
+    invalid = flags & 0x10;
+    division_by_zero = flags & 0x08;
+    overflow = flags & 0x04;
+    underflow = flags & 0x02;
+    inexact = flags & 0x01;
+  }
+}
+
+// The shared exponent is derived from the largest exponent field of the block (see "6.3 Conversion from vector of
+// scalar floats to MX"). This makes the largest value land in the top binade of the element format.
+template <typename ET, bool stochastic>
+void MxFloat::MxQuantizeBlock(f32* src, u8* scale, u8* elements, size_t len, u32* random) {
+  constexpr int kBits = MxElementBits<ET>();
+  uvec vmax = 0u;
+  size_t ind = 0;
+  for (; (ind + fvec<f32>::size()) <= len; ind += fvec<f32>::size()) {
+    fvec<f32> a;
+    a.copy_from(&src[ind], stdx::element_aligned);
+    vmax = stdx::max(vmax, stdx::__proposed::simd_bit_cast<uvec>(a) & 0x7f800000u);
+  }
+  u32 max_exp = stdx::hmax(vmax);
+  for (; ind < len; ++ind)
+    max_exp = std::max(max_exp, std::bit_cast<u32>(src[ind]) & 0x7f800000u);
+  max_exp >>= 23;
+
+  if (max_exp == 0xffu) [[unlikely]] {  // Infinities and NaNs cannot be represented by the elements.
+    for (size_t i = 0; i < len; ++i) {
+      if (FfUtils::IsInf(src[i]) || FfUtils::IsSnan(src[i]))
+        SetInvalid();
+    }
+    *scale = 0xff;
+    std::fill(elements, elements + MxElementBytes<ET>(len), 0);
+    return;
+  }
+
+  int shared_exp = std::clamp(static_cast<int>(max_exp) - 127 - MaxElementExponent<ET>(), -127, 127);
+  *scale = static_cast<u8>(shared_exp + 127);
+
+  // Scaling by a power of two is exact unless the product becomes subnormal. Such values are far below the
+  // smallest element, so they only need their flags if the product vanishes completely.
+  alignas(64) f32 scaled[kMxBlockSize];
+  fvec<f32> factor = Pow2(-shared_exp);
+  for (ind = 0; (ind + fvec<f32>::size()) <= len; ind += fvec<f32>::size()) {
+    fvec<f32> a;
+    a.copy_from(&src[ind], stdx::element_aligned);
+    fvec<f32> b = a * factor;
+    if (stdx::any_of(a != 0.f && b == 0.f)) [[unlikely]] {
+      SetInexact();
+      SetUnderflow();
+    }
+    b.copy_to(&scaled[ind], stdx::element_aligned);
+  }
+  for (; ind < len; ++ind) {
+    scaled[ind] = src[ind] * factor[0];
+    if (src[ind] != 0.f && scaled[ind] == 0.f) [[unlikely]] {
+      SetInexact();
+      SetUnderflow();
+    }
+  }
+
+  ET codes[kMxBlockSize];
+  if constexpr (std::is_same_v<ET, FfUtils::mxint8>)
+    RoundToMxInt8<stochastic>(scaled, random, codes, len);
+  else
+    VRoundToMiniFloat<ET, true, stochastic>(scaled, random, codes, len);
+  PackElements<kBits>(reinterpret_cast<u8*>(codes), elements, len);
+}
+
+// Rounds to integers in units of 2^-6 and saturates to ±127 (the symmetric range of MXINT8).
+template <bool stochastic>
+void MxFloat::RoundToMxInt8(f32* pa, u32* random, FfUtils::mxint8* dest, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    f32 a = pa[i] * 64.f;
+    f32 t = std::trunc(a);
+    f32 frac = std::abs(a - t);
+    bool up;
+    if constexpr (stochastic) {
+      u32 scaled = static_cast<u32>(std::ldexp(frac, 32));
+      up = static_cast<u32>(scaled + random[i]) < scaled;
+    } else {
+      up = (frac > 0.5f) || (frac == 0.5f && std::fmod(t, 2.f) != 0.f);
+    }
+    if (frac != 0.f)
+      SetInexact();
+    f32 q = up ? t + std::copysign(1.f, a) : t;
+    if (std::abs(q) > 127.f) [[unlikely]] {
+      SetOverflow();
+      SetInexact();
+      q = std::copysign(127.f, a);
+    }
+    dest[i] = FfUtils::mxint8{static_cast<FfUtils::i8>(q)};
+  }
+}
+
+template void MxFloat::MxDequantize<FfUtils::fp8e4m3>(u8* scales, u8* elements, f32* dest, size_t len);
+template void MxFloat::MxDequantize<FfUtils::fp8e5m2>(u8* scales, u8* elements, f32* dest, size_t len);
+template void MxFloat::MxDequantize<FfUtils::fp6e3m2>(u8* scales, u8* elements, f32* dest, size_t len);
+template void MxFloat::MxDequantize<FfUtils::fp6e2m3>(u8* scales, u8* elements, f32* dest, size_t len);
+template void MxFloat::MxDequantize<FfUtils::fp4e2m1>(u8* scales, u8* elements, f32* dest, size_t len);
+template void MxFloat::MxDequantize<FfUtils::mxint8>(u8* scales, u8* elements, f32* dest, size_t len);
+
+// Products of elements and scales are exact except for overflows of the largest FP8 elements.
+template <typename ET>
+void MxFloat::MxDequantize(u8* scales, u8* elements, f32* dest, size_t len) {
+  constexpr int kBits = MxElementBits<ET>();
+  u8 codes[kMxBlockSize];
+  for (size_t block = 0; block * kMxBlockSize < len; ++block) {
+    size_t first = block * kMxBlockSize;
+    size_t block_len = std::min(kMxBlockSize, len - first);
+    UnpackElements<kBits>(&elements[MxElementBytes<ET>(first)], codes, block_len);
+
+    if (scales[block] == 0xff) [[unlikely]] {
+      std::fill(&dest[first], &dest[first + block_len], qnan32_);
+      continue;
+    }
+
+    f32 factor = Pow2(static_cast<int>(scales[block]) - 127);
+    auto decode = [&](size_t i) {
+      if constexpr (std::is_same_v<ET, FfUtils::mxint8>) {
+        return static_cast<f32>(static_cast<FfUtils::i8>(codes[i])) * 0x1p-6f;
+      } else {
+        if constexpr (std::is_same_v<ET, FfUtils::fp8e5m2>) {
+          if ((codes[i] & 0x7f) == 0x7d) [[unlikely]]  // The only signaling NaN encoding of E5M2.
+            SetInvalid();
+        }
+        return FfUtils::MiniFloatDecodeTable<ET>()[codes[i]];
+      }
+    };
+
+    size_t ind = 0;
+    for (; (ind + fvec<f32>::size()) <= block_len; ind += fvec<f32>::size()) {
+      fvec<f32> a([&](auto i) { return decode(ind + i); });
+      fvec<f32> b = a * factor;
+      if (stdx::any_of((b - b) != 0.f && (a - a) == 0.f)) [[unlikely]] {  // Finite elements that became infinite.
+        SetOverflow();
+        SetInexact();
+      }
+      b.copy_to(&dest[first + ind], stdx::element_aligned);
+    }
+    for (; ind < block_len; ++ind) {
+      f32 a = decode(ind);
+      dest[first + ind] = a * factor;
+      if (FfUtils::IsInf(dest[first + ind]) && !FfUtils::IsInf(a)) [[unlikely]] {
+        SetOverflow();
+        SetInexact();
+      }
+    }
+  }
+}
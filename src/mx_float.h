@@ -0,0 +1,47 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "simd_float.h"
+#include "utils.h"
+
+// Block conversions of the OCP Microscaling formats (see "OCP Microscaling Formats (MX) Specification").
+// Every block of kMxBlockSize values shares one E8M0 scale (a biased power of two, 0xff is NaN).
+// Elements are packed little-endian, i.e., the first element occupies the lowest bits of the first byte.
+class MxFloat : public SimdFloat {
+ public:
+  static constexpr size_t kMxBlockSize = 32;
+
+  template <typename ET>
+  static constexpr int MxElementBits() {
+    if constexpr (std::is_same_v<ET, FfUtils::mxint8>)
+      return 8;
+    else
+      return FfUtils::MiniFloatFormat<ET>::kNumBits;
+  }
+
+  // Number of bytes needed to store "len" packed elements.
+  template <typename ET>
+  static constexpr size_t MxElementBytes(size_t len) {
+    return (len * MxElementBits<ET>() + 7) / 8;
+  }
+
+  // The last block may be partial. Elements always round to nearest even (or stochastically) and saturate.
+  // Blocks that contain infinities or NaNs get a NaN scale and zero elements.
+  // If "block_flags" is given, it receives the exception flags of each block in the RISC-V "fflags" layout.
+  template <typename ET, bool stochastic>
+  void MxQuantize(FfUtils::f32* src, FfUtils::u8* scales, FfUtils::u8* elements, size_t len,
+                  FfUtils::u32* random = nullptr, FfUtils::u8* block_flags = nullptr);
+
+  template <typename ET>
+  void MxDequantize(FfUtils::u8* scales, FfUtils::u8* elements, FfUtils::f32* dest, size_t len);
+
+ private:
+  template <typename ET, bool stochastic>
+  void MxQuantizeBlock(FfUtils::f32* src, FfUtils::u8* scale, FfUtils::u8* elements, size_t len, FfUtils::u32* random);
+
+  template <bool stochastic>
+  void RoundToMxInt8(FfUtils::f32* pa, FfUtils::u32* random, FfUtils::mxint8* dest, size_t len);
+};
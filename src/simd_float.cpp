@@ -1,6 +1,9 @@
 #include "simd_float.h"
 
+#include <algorithm>
 #include <experimental/simd>
+#include <functional>
+#include <vector>
 
 namespace stdx = std::experimental;
 
@@ -17,36 +20,9 @@ using fmask = stdx::native_simd_mask<T>;
 template <typename T>
 using nl = std::numeric_limits<T>;
 
-fvec<f32> vqnan32;
-const fvec<f32> vmin32([](auto i [[maybe_unused]]) { return nl<f32>::min(); });
-
-fvec<f64> vqnan64;
-const fvec<f64> vmin64([](auto i [[maybe_unused]]) { return nl<f64>::min(); });
-
 template <typename FT>
-constexpr auto VGetMin();
-
-template <>
-constexpr auto VGetMin<f32>() {
-  return vmin32;
-}
-
-template <>
-constexpr auto VGetMin<f64>() {
-  return vmin64;
-}
-
-template <typename FT>
-constexpr auto VGetQnan();
-
-template <>
-constexpr auto VGetQnan<f32>() {
-  return vqnan32;
-}
-
-template <>
-constexpr auto VGetQnan<f64>() {
-  return vqnan64;
+fvec<FT> VGetMin() {
+  return fvec<FT>(nl<FT>::min());
 }
 
 template <typename T>
@@ -78,25 +54,43 @@ constexpr auto VIsZero(T a) {
   return a == -a;
 }
 
-template <typename T>
-fmask<typename T::value_type> VIsSnan(T& a);
+template <typename FT>
+using fbits = stdx::rebind_simd_t<typename FfUtils::FloatToUint<FT>::type, fvec<FT>>;
 
-fmask<f32> VIsSnan(fvec<f32>& a) {
-  fmask<f32> m;
-  for (size_t i = 0; i < fmask<f32>::size(); ++i) {
-    FfUtils::f32 af{a[i]};
-    m[i] = FfUtils::IsSnan(af);
-  }
-  return m;
+// Reinterprets the lanes as unsigned integers and clears their sign bits. NaNs are greater than the encoding of
+// infinity, and quiet NaNs additionally have the most significant bit of the significand set.
+template <typename FT>
+fbits<FT> VMagnitudeBits(fvec<FT> a) {
+  using UT = typename FfUtils::FloatToUint<FT>::type;
+  return stdx::__proposed::simd_bit_cast<fbits<FT>>(a) & (nl<UT>::max() >> 1);
 }
 
-fmask<f64> VIsSnan(fvec<f64>& a) {
-  fmask<f64> m;
-  for (size_t i = 0; i < fmask<f64>::size(); ++i) {
-    FfUtils::f64 af{a[i]};
-    m[i] = FfUtils::IsSnan(af);
-  }
-  return m;
+template <typename FT>
+constexpr auto kVInfBits = std::bit_cast<typename FfUtils::FloatToUint<FT>::type>(nl<FT>::infinity());
+
+template <typename FT>
+constexpr auto kVQuietBit = static_cast<typename FfUtils::FloatToUint<FT>::type>(1) << (nl<FT>::digits - 2);
+
+// Both tests are floating-point compares, which avoids 64-bit integer compares that SSE2 does not have and mask
+// conversions. The isolated quiet bit reads as a positive subnormal number.
+template <typename FT>
+fmask<FT> VIsSnan(fvec<FT> a) {
+  auto quiet = stdx::__proposed::simd_bit_cast<fvec<FT>>(stdx::__proposed::simd_bit_cast<fbits<FT>>(a) & kVQuietBit<FT>);
+  return VIsNan(a) && quiet == 0;
+}
+
+template <typename FT>
+fvec<FT> VSetQuietBit(fvec<FT> a) {
+  return stdx::__proposed::simd_bit_cast<fvec<FT>>(stdx::__proposed::simd_bit_cast<fbits<FT>>(a) | kVQuietBit<FT>);
+}
+
+// Vectorized version of the total order key: Reinterprets the lanes as signed integers
+// and flips the magnitude bits of negative values, so that -0 < +0.
+template <typename FT>
+auto VTotalOrderKey(fvec<FT> a) {
+  using IT = typename FfUtils::FloatToInt<FT>::type;
+  auto ia = stdx::__proposed::simd_bit_cast<stdx::rebind_simd_t<IT, fvec<FT>>>(a);
+  return ia ^ ((ia >> (FfUtils::NumBits<FT>() - 1)) & nl<IT>::max());
 }
 
 // Vectorized 2Sum algorithm which determines the exact residual of an addition.
@@ -142,27 +136,144 @@ fvec<f64> VUpMul(fvec<f64>& a, fvec<f64>& b, fvec<f64>& c) {
   return r;
 }
 
-template <>
-void SimdFloat::SetQnan<f32>(typename FfUtils::FloatToUint<f32>::type val) {
-  FloppyFloat::SetQnan<f32>(val);
-  for (size_t i = 0; i < stdx::native_simd<f32>::size(); ++i) {
-    vqnan32[i] = std::bit_cast<f32>(qnan32_);
+constexpr f64 kVFmaResidualLimit = 0x1p-968;  // See FmaResidualLimit.
+constexpr f64 kVUpMulScale = 0x1p590;   // Applied twice, i.e., 2**1180.
+constexpr f64 kVResidualScale = 0x1p600;
+constexpr f64 kVResidualRootScale = 0x1p300;
+
+// Variant of VUpMul for |c| <= 2**-968: The operand with the smaller magnitude is scaled by 2**1180, which is exact
+// and cannot overflow (it is below 2**-484 for such small products). The scaled product is then at least 2**-968, so
+// the residual does not underflow to zero. It is non-zero iff the multiplication was inexact.
+// Additionally returns the scaled product rounded with an unbounded exponent ("ps") and its exact residual ("rs").
+fvec<f64> VUpMulScaled(fvec<f64>& a, fvec<f64>& b, fvec<f64>& c, fvec<f64>& ps, fvec<f64>& rs) {
+  auto swap = abs(a) > abs(b);
+  fvec<f64> x = a;
+  fvec<f64> y = b;
+  stdx::where(swap, x) = b;
+  stdx::where(swap, y) = a;
+  x = x * kVUpMulScale * kVUpMulScale;
+  auto cs = c * kVUpMulScale * kVUpMulScale;
+  ps = x * y;
+  rs = fma(x, y, -ps);
+  auto r = fma(x, y, -cs);
+  return r;
+}
+
+stdx::rebind_simd_t<f64, fvec<f32>> VUpDiv(fvec<f32>& a, fvec<f32>& b, fvec<f32>& c) {
+  auto a64 = stdx::simd_cast<stdx::rebind_simd_t<f64, fvec<f32>>>(a);
+  auto b64 = stdx::simd_cast<stdx::rebind_simd_t<f64, fvec<f32>>>(b);
+  auto c64 = stdx::simd_cast<stdx::rebind_simd_t<f64, fvec<f32>>>(c);
+  auto r = c64 * b64 - a64;
+  return r;
+}
+
+// Like UpDivFma, but without the sign correction for negative divisors. Dividends below the limit of the FMA residual
+// are scaled by 2**600 together with their quotients, which is exact as these quotients cannot exceed 2**106. The scaled
+// residual is representable and has the same sign.
+fvec<f64> VUpDiv(fvec<f64>& a, fvec<f64>& b, fvec<f64>& c) {
+  auto is_small = abs(a) <= fvec<f64>(kVFmaResidualLimit);
+  if (stdx::any_of(is_small)) [[unlikely]] {
+    fvec<f64> as = a;
+    fvec<f64> cs = c;
+    stdx::where(is_small, as) = a * kVResidualScale;
+    stdx::where(is_small, cs) = c * kVResidualScale;
+    return fma(cs, b, -as);
   }
+  auto r = fma(c, b, -a);
+  return r;
 }
 
-template <>
-void SimdFloat::SetQnan<f64>(typename FfUtils::FloatToUint<f64>::type val) {
-  FloppyFloat::SetQnan<f64>(val);
-  for (size_t i = 0; i < stdx::native_simd<f64>::size(); ++i) {
-    vqnan64[i] = std::bit_cast<f64>(qnan64_);
+stdx::rebind_simd_t<f64, fvec<f32>> VUpSqrt(fvec<f32>& a, fvec<f32>& b) {
+  auto a64 = stdx::simd_cast<stdx::rebind_simd_t<f64, fvec<f32>>>(a);
+  auto b64 = stdx::simd_cast<stdx::rebind_simd_t<f64, fvec<f32>>>(b);
+  auto r = b64 * b64 - a64;
+  return r;
+}
+
+// Like UpSqrtFma. Radicands below the limit of the FMA residual are scaled by 2**600 and their roots by 2**300 (see
+// VUpDiv).
+fvec<f64> VUpSqrt(fvec<f64>& a, fvec<f64>& b) {
+  auto is_small = abs(a) <= fvec<f64>(kVFmaResidualLimit);
+  if (stdx::any_of(is_small)) [[unlikely]] {
+    fvec<f64> as = a;
+    fvec<f64> bs = b;
+    stdx::where(is_small, as) = a * kVResidualScale;
+    stdx::where(is_small, bs) = b * kVResidualRootScale;
+    return fma(bs, bs, -as);
+  }
+  auto r = fma(b, b, -a);
+  return r;
+}
+
+// Residual d - (a * b + c) of an FMA like UpFma. The product is exact in double precision and the 2Sum of the
+// product and "c" is exact as well, so the residual only has to be rounded if the 2Sum residual is non-zero.
+// "exact" marks the lanes where this is not the case, which is required for detecting ties.
+stdx::rebind_simd_t<f64, fvec<f32>> VUpFma(fvec<f32>& a, fvec<f32>& b, fvec<f32>& c, fvec<f32>& d,
+                                           fmask<f32>& exact) {
+  using vf64 = stdx::rebind_simd_t<f64, fvec<f32>>;
+  auto p = stdx::simd_cast<vf64>(a) * stdx::simd_cast<vf64>(b);
+  auto c64 = stdx::simd_cast<vf64>(c);
+  auto d64 = stdx::simd_cast<vf64>(d);
+  vf64 s = p + c64;
+  auto t = VTwoSum<vf64>(p, c64, s);
+  exact = stdx::__proposed::static_simd_cast<fmask<f32>>(t == 0);
+  auto r = (d64 - s) + t;
+  return r;
+}
+
+// ErrFma algorithm of Boldo and Muller: a * b + c = d + r2 + r3 holds exactly, unless an intermediate result
+// underflows or overflows. Returns the residual d - (a * b + c) like UpFma, which is exact if "r3" is zero.
+fvec<f64> VUpFma(fvec<f64>& a, fvec<f64>& b, fvec<f64>& c, fvec<f64>& d, fmask<f64>& exact) {
+  fvec<f64> u1 = a * b;
+  fvec<f64> u2 = fma(a, b, -u1);
+  fvec<f64> alpha1 = c + u2;
+  fvec<f64> alpha2 = -VTwoSum(c, u2, alpha1);
+  fvec<f64> beta1 = u1 + alpha1;
+  fvec<f64> beta2 = -VTwoSum(u1, alpha1, beta1);
+  fvec<f64> gamma = (beta1 - d) + beta2;
+  fvec<f64> r2 = gamma + alpha2;
+  fvec<f64> r3 = -VFastTwoSum(gamma, alpha2, r2);
+  exact = r3 == 0;
+  auto r = -(r2 + r3);
+  return r;
+}
+
+template <typename FT, typename MT>
+fmask<FT> VMaskCast(MT m) {
+  if constexpr (std::is_same_v<MT, fmask<FT>>)
+    return m;
+  else
+    return stdx::__proposed::static_simd_cast<fmask<FT>>(m);
+}
+
+// Calls "f" with the index of each lane set in "m", so that lanes which need the scalar implementation are visited
+// without iterating over the whole vector.
+template <typename MT, typename F>
+void VForEachLane(MT m, F f) {
+  while (stdx::any_of(m)) {
+    int i = stdx::find_first_set(m);
+    f(i);
+    m[i] = false;
   }
 }
 
+// The default NaNs are broadcast from the scalar ones of the instance, so that differently configured instances do not
+// interfere with each other.
+template <>
+auto SimdFloat::VGetQnan<f32>() {
+  return fvec<f32>(qnan32_);
+}
+
+template <>
+auto SimdFloat::VGetQnan<f64>() {
+  return fvec<f64>(qnan64_);
+}
+
 template <typename FT>
-constexpr fvec<FT> vfma(fvec<FT>& a) {
+fvec<FT> vfma(fvec<FT>& a, fvec<FT>& b, fvec<FT>& c) {
   fvec<FT> r{};
   for (size_t i = 0; i < fvec<FT>::size(); ++i)
-    r[i] = std::fma(a[i]);
+    r[i] = std::fma(a[i], b[i], c[i]);
   return r;
 }
 
@@ -174,9 +285,98 @@ constexpr fvec<FT> vsqrt(fvec<FT>& a) {
   return r;
 }
 
-SimdFloat::SimdFloat() : FloppyFloat() {
-  SimdFloat::SetQnan<f32>(std::bit_cast<FfUtils::u32>(qnan32_));
-  SimdFloat::SetQnan<f64>(std::bit_cast<FfUtils::u64>(qnan64_));
+SimdFloat::SimdFloat() : FloppyFloat() {}
+
+// Vectorized version of PropagateNan: Replaces the NaN lanes of "c" with the NaN of the propagation scheme. For x86, this
+// is the first NaN operand with its quiet bit set, or the default NaN for invalid operations without NaN operands.
+template <typename VT>
+void SimdFloat::VPropagateNan(VT& c, VT a, VT b) {
+  using FT = typename VT::value_type;
+  switch (nan_propagation_scheme) {
+  case kNanPropX86sse: {
+    VT nan = VGetQnan<FT>();
+    stdx::where(VIsNan(b), nan) = VSetQuietBit<FT>(b);
+    stdx::where(VIsNan(a), nan) = VSetQuietBit<FT>(a);
+    stdx::where(VIsNan(c), c) = nan;
+    break;
+  }
+  case kNanPropRiscv:
+  case kNanPropArm64DefaultNan:
+    stdx::where(VIsNan(c), c) = VGetQnan<FT>();
+    break;
+  default:
+    throw std::runtime_error(std::string("Unknown NaN propagation scheme"));
+  }
+}
+
+// For x86, NaNs in "a" and "b" take precedence over ∞ × 0, which takes precedence over a NaN in "c" (see PropagateNan).
+template <typename VT>
+void SimdFloat::VPropagateNan(VT& d, VT a, VT b, VT c) {
+  using FT = typename VT::value_type;
+  switch (nan_propagation_scheme) {
+  case kNanPropX86sse: {
+    VT nan = VGetQnan<FT>();
+    stdx::where(VIsNan(c) && !((VIsInf(a) && VIsZero(b)) || (VIsZero(a) && VIsInf(b))), nan) = VSetQuietBit<FT>(c);
+    stdx::where(VIsNan(b), nan) = VSetQuietBit<FT>(b);
+    stdx::where(VIsNan(a), nan) = VSetQuietBit<FT>(a);
+    stdx::where(VIsNan(d), d) = nan;
+    break;
+  }
+  case kNanPropRiscv:
+  case kNanPropArm64DefaultNan:
+    stdx::where(VIsNan(d), d) = VGetQnan<FT>();
+    break;
+  default:
+    throw std::runtime_error(std::string("Unknown NaN propagation scheme"));
+  }
+}
+
+// Vectorized version of RoundResult: Steps the round-to-nearest-even results "c" by one ulp according to the sign of
+// their residuals "r" (c - exact result), except for the lanes marked "scalar". For ties-to-away, only lanes marked
+// "maybe_tie" whose residual is exactly half an ulp are stepped away from zero (see AddImpl).
+template <FloppyFloat::RoundingMode rm, typename VT, typename RT, typename MT>
+void SimdFloat::VRoundResult(VT& c, RT r, MT scalar, MT maybe_tie) {
+  using FT = typename VT::value_type;
+  using UT = typename FfUtils::FloatToUint<FT>::type;
+  using uvec = stdx::rebind_simd_t<UT, VT>;
+
+  MT r_neg = VMaskCast<FT>(r < 0) && !scalar;
+  MT r_pos = VMaskCast<FT>(r > 0) && !scalar;
+  if (stdx::none_of(r_neg || r_pos))
+    return;
+  SetInexact();
+
+  // Lanes that are stepped away from zero or toward zero, respectively.
+  MT away(false);
+  MT toward(false);
+  if constexpr (rm == kRoundTowardPositive) {
+    away = r_neg && c > 0;
+    toward = r_neg && c < 0;
+  } else if constexpr (rm == kRoundTowardNegative) {
+    away = r_pos && c < 0;
+    toward = r_pos && c > 0;
+  } else if constexpr (rm == kRoundTowardZero) {
+    toward = (r_pos && c > 0) || (r_neg && c < 0);
+  } else if constexpr (rm == kRoundTiesToAway) {
+    constexpr UT kSignificandMask = (static_cast<UT>(1) << (nl<FT>::digits - 1)) - 1;
+    auto cc = stdx::__proposed::simd_bit_cast<VT>(stdx::__proposed::simd_bit_cast<uvec>(c) & ~kSignificandMask);
+    auto r_scaled = r * static_cast<typename RT::value_type>(2 / nl<FT>::epsilon());
+    MT tie = maybe_tie && VMaskCast<FT>(-stdx::simd_cast<RT>(cc) == r_scaled);
+    away = tie && ((r_neg && c > 0) || (r_pos && c < 0));
+  } else {
+    static_assert(false, "Using unsupported rounding mode");
+  }
+
+  // Steps the integer representation, i.e., NextUpNoNegZero and NextDownNoPosZero. Unsigned, as the unselected lanes
+  // may wrap (e.g., -0).
+  auto ic = stdx::__proposed::simd_bit_cast<uvec>(c);
+  if constexpr (rm != kRoundTiesToAway)
+    stdx::where(toward, c) = stdx::__proposed::simd_bit_cast<VT>(ic - 1);
+  if constexpr (rm != kRoundTowardZero) {
+    stdx::where(away, c) = stdx::__proposed::simd_bit_cast<VT>(ic + 1);
+    if (stdx::any_of(VIsInf(c) && away))
+      SetOverflow();
+  }
 }
 
 template void SimdFloat::VAdd<float>(float* pa, float* pb, float* dest, size_t len);
@@ -184,45 +384,71 @@ template void SimdFloat::VAdd<f64>(f64* pa, f64* pb, f64* dest, size_t len);
 
 template <typename FT>
 void SimdFloat::VAdd(FT* pa, FT* pb, FT* dest, size_t len) {
-  if (rounding_mode != kRoundTiesToEven) [[unlikely]] {
-    for (size_t i = 0; i < len; ++i) {
-      dest[i] = FloppyFloat::Add<FT>(pa[i], pb[i]);
-    }
-    return;
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return VAdd<FT, kRoundTiesToEven>(pa, pb, dest, len);
+  case kRoundTiesToAway:
+    return VAdd<FT, kRoundTiesToAway>(pa, pb, dest, len);
+  case kRoundTowardPositive:
+    return VAdd<FT, kRoundTowardPositive>(pa, pb, dest, len);
+  case kRoundTowardNegative:
+    return VAdd<FT, kRoundTowardNegative>(pa, pb, dest, len);
+  case kRoundTowardZero:
+    return VAdd<FT, kRoundTowardZero>(pa, pb, dest, len);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
   }
+}
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+void SimdFloat::VAdd(FT* pa, FT* pb, FT* dest, size_t len) {
   size_t ind = 0;
-  while ((ind + stdx::native_simd<f32>::size()) <= len) {
+  while ((ind + fvec<FT>::size()) <= len) {
     fvec<FT> a, b, c;
     a.copy_from(&pa[ind], stdx::element_aligned);
     b.copy_from(&pb[ind], stdx::element_aligned);
 
     c = a + b;
 
-    if (stdx::any_of(VIsInfOrNan(c))) [[unlikely]] {
-      if (stdx::any_of(VIsInf(c) && !VIsInf(a) && !VIsInf(b))) {
-        SetOverflow();
-        SetInexact();
+    if constexpr (rm == kRoundTiesToEven) {
+      if (stdx::any_of(VIsInfOrNan(c))) [[unlikely]] {
+        if (stdx::any_of(VIsInf(c) && !VIsInf(a) && !VIsInf(b))) {
+          SetOverflow();
+          SetInexact();
+        }
+        if (stdx::any_of(VIsNan(c) && VIsInf(a) && VIsInf(b)))
+          SetInvalid();
+        if (stdx::any_of(VIsSnan(a) || VIsSnan(b)))
+          SetInvalid();
+        VPropagateNan(c, a, b);
+      }
+      if (!inexact) [[unlikely]] {
+        // If one input is NaN or ±infinity, the residual "r" will be a
+        // qNaN, and no inexact flag is set.
+        auto r = VFastTwoSum<fvec<FT>>(a, b, c);
+        if (stdx::any_of(VIsNonZero(r)))
+          SetInexact();
+      }
+    } else {
+      auto scalar = VIsInfOrNan(c);  // NaN and overflow lanes are left to the scalar implementation.
+      if constexpr (rm == kRoundTowardNegative) {  // See AddImpl.
+        if (stdx::any_of(VIsZero(c))) [[unlikely]]
+          stdx::where(VIsZero(c) && !stdx::signbit(c) && (stdx::signbit(a) || stdx::signbit(b)), c) = -c;
       }
-      if (stdx::any_of(VIsNan(c) && VIsInf(a) && VIsInf(b)))
-        SetInvalid();
-      if (stdx::any_of(VIsSnan(a) || VIsSnan(b)))
-        SetInvalid();
-      stdx::where(c != c, c) = VGetQnan<FT>();
-    }
-    if (!inexact) [[unlikely]] {
-      // If one input is NaN or ±infinity, the residual "r" will be a
-      // qNaN, and no inexact flag is set.
       auto r = VFastTwoSum<fvec<FT>>(a, b, c);
-      if (stdx::any_of(VIsNonZero(r)))
-        SetInexact();
+      VRoundResult<rm>(c, r, scalar, fmask<FT>(true));
+      if (stdx::any_of(scalar)) [[unlikely]] {
+        for (size_t i = 0; i < fvec<FT>::size(); ++i)
+          if (scalar[i])
+            c[i] = FloppyFloat::Add<FT, rm>(pa[ind + i], pb[ind + i]);
+      }
     }
     c.copy_to(&dest[ind], stdx::element_aligned);
     ind += fvec<FT>::size();
   }
 
   for (; ind < len; ind++)
-    dest[ind] = FloppyFloat::Add<FT, kRoundTiesToEven>(pa[ind], pb[ind]);
+    dest[ind] = FloppyFloat::Add<FT, rm>(pa[ind], pb[ind]);
 }
 
 template void SimdFloat::VSub<f32>(f32* pa, f32* pb, f32* dest, size_t len);
@@ -230,93 +456,168 @@ template void SimdFloat::VSub<f64>(f64* pa, f64* pb, f64* dest, size_t len);
 
 template <typename FT>
 void SimdFloat::VSub(FT* pa, FT* pb, FT* dest, size_t len) {
-  if (rounding_mode != kRoundTiesToEven) [[unlikely]] {
-    for (size_t i = 0; i < len; ++i) {
-      dest[i] = FloppyFloat::Sub<FT>(pa[i], pb[i]);
-    }
-    return;
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return VSub<FT, kRoundTiesToEven>(pa, pb, dest, len);
+  case kRoundTiesToAway:
+    return VSub<FT, kRoundTiesToAway>(pa, pb, dest, len);
+  case kRoundTowardPositive:
+    return VSub<FT, kRoundTowardPositive>(pa, pb, dest, len);
+  case kRoundTowardNegative:
+    return VSub<FT, kRoundTowardNegative>(pa, pb, dest, len);
+  case kRoundTowardZero:
+    return VSub<FT, kRoundTowardZero>(pa, pb, dest, len);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
   }
+}
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+void SimdFloat::VSub(FT* pa, FT* pb, FT* dest, size_t len) {
   size_t ind = 0;
-  while ((ind + stdx::native_simd<FT>::size()) <= len) {
+  while ((ind + fvec<FT>::size()) <= len) {
     fvec<FT> a, b, c;
     a.copy_from(&pa[ind], stdx::element_aligned);
     b.copy_from(&pb[ind], stdx::element_aligned);
 
     c = a - b;
-    if (stdx::any_of(VIsInfOrNan(c))) [[unlikely]] {
-      if (stdx::any_of(VIsInf(c) && !VIsInf(a) && !VIsInf(b))) {
-        SetOverflow();
-        SetInexact();
+    if constexpr (rm == kRoundTiesToEven) {
+      if (stdx::any_of(VIsInfOrNan(c))) [[unlikely]] {
+        if (stdx::any_of(VIsInf(c) && !VIsInf(a) && !VIsInf(b))) {
+          SetOverflow();
+          SetInexact();
+        }
+        if (stdx::any_of(VIsNan(c) && VIsInf(a) && VIsInf(b)))
+          SetInvalid();
+        if (stdx::any_of(VIsSnan(a) || VIsSnan(b)))
+          SetInvalid();
+        VPropagateNan(c, a, b);
+      }
+      if (!inexact) [[unlikely]] {
+        // If one input is NaN or ±infinity, the residual "r" will be a
+        // qNaN, and no inexact flag is set.
+        auto r = VTwoSum<fvec<FT>>(a, -b, c);
+        if (stdx::any_of(VIsNonZero(r)))
+          SetInexact();
+      }
+    } else {
+      auto scalar = VIsInfOrNan(c);  // NaN and overflow lanes are left to the scalar implementation.
+      if constexpr (rm == kRoundTowardNegative) {  // See SubImpl.
+        if (stdx::any_of(VIsZero(c))) [[unlikely]]
+          stdx::where(VIsZero(c) && !stdx::signbit(c) && (stdx::signbit(a) || !stdx::signbit(b)), c) = -c;
+      }
+      auto r = VFastTwoSum<fvec<FT>>(a, -b, c);
+      VRoundResult<rm>(c, r, scalar, fmask<FT>(true));
+      if (stdx::any_of(scalar)) [[unlikely]] {
+        for (size_t i = 0; i < fvec<FT>::size(); ++i)
+          if (scalar[i])
+            c[i] = FloppyFloat::Sub<FT, rm>(pa[ind + i], pb[ind + i]);
       }
-      if (stdx::any_of(VIsNan(c) && VIsInf(a) && VIsInf(b)))
-        SetInvalid();
-      if (stdx::any_of(VIsSnan(a) || VIsSnan(b)))
-        SetInvalid();
-      stdx::where(c != c, c) = VGetQnan<FT>();
-    }
-    if (!inexact) [[unlikely]] {
-      // If one input is NaN or ±infinity, the residual "r" will be a
-      // qNaN, and no inexact flag is set.
-      auto r = VTwoSum<fvec<FT>>(a, -b, c);
-      if (stdx::any_of(VIsNonZero(r)))
-        SetInexact();
     }
     c.copy_to(&dest[ind], stdx::element_aligned);
     ind += fvec<FT>::size();
   }
 
   for (; ind < len; ind++)
-    dest[ind] = FloppyFloat::Sub<FT, kRoundTiesToEven>(pa[ind], pb[ind]);
+    dest[ind] = FloppyFloat::Sub<FT, rm>(pa[ind], pb[ind]);
 }
 
 template void SimdFloat::VMul<f32>(f32* pa, f32* pb, f32* dest, size_t len);
-// template void SimdFloat::VMul<f64>(f64* pa, f64* pb, f64* dest, size_t len);
+template void SimdFloat::VMul<f64>(f64* pa, f64* pb, f64* dest, size_t len);
 
 template <typename FT>
 void SimdFloat::VMul(FT* pa, FT* pb, FT* dest, size_t len) {
-  if (rounding_mode != kRoundTiesToEven) [[unlikely]] {
-    for (size_t i = 0; i < len; ++i) {
-      dest[i] = FloppyFloat::Mul<FT>(pa[i], pb[i]);
-    }
-    return;
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return VMul<FT, kRoundTiesToEven>(pa, pb, dest, len);
+  case kRoundTiesToAway:
+    return VMul<FT, kRoundTiesToAway>(pa, pb, dest, len);
+  case kRoundTowardPositive:
+    return VMul<FT, kRoundTowardPositive>(pa, pb, dest, len);
+  case kRoundTowardNegative:
+    return VMul<FT, kRoundTowardNegative>(pa, pb, dest, len);
+  case kRoundTowardZero:
+    return VMul<FT, kRoundTowardZero>(pa, pb, dest, len);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
   }
+}
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+void SimdFloat::VMul(FT* pa, FT* pb, FT* dest, size_t len) {
   size_t ind = 0;
-  while ((ind + stdx::native_simd<f32>::size()) <= len) {
+  while ((ind + fvec<FT>::size()) <= len) {
     fvec<FT> a, b, c;
     a.copy_from(&pa[ind], stdx::element_aligned);
     b.copy_from(&pb[ind], stdx::element_aligned);
 
     c = a * b;
-    if (stdx::any_of(VIsInfOrNan(c))) [[unlikely]] {
-      if (stdx::any_of(VIsInf(c) && !VIsInf(a) && !VIsInf(b))) {
-        SetOverflow();
-        SetInexact();
+    if constexpr (rm == kRoundTiesToEven) {
+      if (stdx::any_of(VIsInfOrNan(c))) [[unlikely]] {
+        if (stdx::any_of(VIsInf(c) && !VIsInf(a) && !VIsInf(b))) {
+          SetOverflow();
+          SetInexact();
+        }
+        if (stdx::any_of(VIsSnan(a) || VIsSnan(b)))
+          SetInvalid();
+        if (stdx::any_of(VIsZero(a) && VIsInf(b)))
+          SetInvalid();
+        if (stdx::any_of(VIsInf(a) && VIsZero(b)))
+          SetInvalid();
+        VPropagateNan(c, a, b);
       }
-      if (stdx::any_of(VIsSnan(a) || VIsSnan(b)))
-        SetInvalid();
-      if (stdx::any_of(VIsZero(a) && VIsInf(b)))
-        SetInvalid();
-      if (stdx::any_of(VIsInf(a) && VIsZero(b)))
-        SetInvalid();
-      stdx::where(c != c, c) = VGetQnan<FT>();
-    }
 
-    // If one input is NaN or ±infinity, the residual "r" will be a qNaN,
-    // and no inexact or underflow flag is set.
-    if (!inexact) [[unlikely]] {
+      // If one input is NaN or ±infinity, the residual "r" will be a qNaN,
+      // and no inexact or underflow flag is set.
+      if constexpr (std::is_same_v<FT, f64>) {
+        auto is_small = abs(c) <= fvec<f64>(kVFmaResidualLimit);
+        bool any_small = stdx::any_of(is_small);
+        if (!inexact || (!underflow && any_small)) [[unlikely]] {
+          auto r = VUpMul(a, b, c);
+          if (any_small) [[unlikely]] {
+            fvec<f64> ps, rs;
+            auto r_scaled = VUpMulScaled(a, b, c, ps, rs);
+            stdx::where(is_small, r) = r_scaled;
+            // Tininess is decided on the scaled product, i.e., as if the exponent range was unbounded.
+            auto min_scaled = VGetMin<f64>() * kVUpMulScale * kVUpMulScale;
+            auto tiny = abs(ps) < min_scaled;
+            if (tininess_before_rounding)
+              tiny = tiny || (abs(ps) == min_scaled && ((ps > 0 && rs < 0) || (ps < 0 && rs > 0)));
+            if (!underflow && stdx::any_of(is_small && tiny && VIsNonZero(r)))
+              SetUnderflow();
+          }
+          if (stdx::any_of(VIsNonZero(r)))
+            SetInexact();
+        }
+      } else {
+        if (!inexact) [[unlikely]] {
+          auto r = VUpMul(a, b, c);
+          if (stdx::any_of(VIsNonZero(r)))
+            SetInexact();
+        }
+        if (!underflow) {
+          auto is_small = abs(c) <= VGetMin<FT>();  // See MayResultFromUnderflow.
+          if (stdx::any_of(is_small)) {
+            auto r = VUpMul(a, b, c);
+            auto tmp = stdx::__proposed::static_simd_cast<stdx::rebind_simd_t<f64, decltype(is_small)>>(is_small);
+            if (stdx::any_of(VIsNonZero(r) && tmp))
+              SetUnderflow();
+          }
+        }
+      }
+    } else {
+      // NaN and overflow lanes as well as lanes that may underflow are left to the scalar implementation. For f64,
+      // the latter includes all lanes below the limit of the FMA residual.
+      fvec<FT> limit = VGetMin<FT>();
+      if constexpr (std::is_same_v<FT, f64>)
+        limit = kVFmaResidualLimit;
+      auto scalar = VIsInfOrNan(c) || (abs(c) <= limit && VIsNonZero(a) && VIsNonZero(b));
       auto r = VUpMul(a, b, c);
-      if (stdx::any_of(VIsNonZero(r)))
-        SetInexact();
-    }
-    if (!underflow) {
-      auto is_small = c < VGetMin<FT>() && c > -VGetMin<FT>();
-      if (stdx::any_of(is_small)) {
-        auto r = VUpMul(a, b, c);
-        auto tmp = stdx::__proposed::static_simd_cast<stdx::rebind_simd_t<f64, decltype(is_small)>>(is_small);
-        if (stdx::any_of(VIsNonZero(r) && tmp))
-          SetUnderflow();
+      VRoundResult<rm>(c, -r, scalar, fmask<FT>(true));
+      if (stdx::any_of(scalar)) [[unlikely]] {
+        for (size_t i = 0; i < fvec<FT>::size(); ++i)
+          if (scalar[i])
+            c[i] = FloppyFloat::Mul<FT, rm>(pa[ind + i], pb[ind + i]);
       }
     }
     c.copy_to(&dest[ind], stdx::element_aligned);
@@ -324,7 +625,7 @@ void SimdFloat::VMul(FT* pa, FT* pb, FT* dest, size_t len) {
   }
 
   for (; ind < len; ++ind)
-    dest[ind] = FloppyFloat::Mul<FT, kRoundTiesToEven>(pa[ind], pb[ind]);
+    dest[ind] = FloppyFloat::Mul<FT, rm>(pa[ind], pb[ind]);
 }
 
 template void SimdFloat::VDiv<f32>(f32* pa, f32* pb, f32* dest, size_t len);
@@ -332,41 +633,78 @@ template void SimdFloat::VDiv<f64>(f64* pa, f64* pb, f64* dest, size_t len);
 
 template <typename FT>
 void SimdFloat::VDiv(FT* pa, FT* pb, FT* dest, size_t len) {
-  if (rounding_mode != kRoundTiesToEven) [[unlikely]] {
-    for (size_t i = 0; i < len; ++i) {
-      dest[i] = FloppyFloat::Div<FT>(pa[i], pb[i]);
-    }
-    return;
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return VDiv<FT, kRoundTiesToEven>(pa, pb, dest, len);
+  case kRoundTiesToAway:
+    return VDiv<FT, kRoundTiesToAway>(pa, pb, dest, len);
+  case kRoundTowardPositive:
+    return VDiv<FT, kRoundTowardPositive>(pa, pb, dest, len);
+  case kRoundTowardNegative:
+    return VDiv<FT, kRoundTowardNegative>(pa, pb, dest, len);
+  case kRoundTowardZero:
+    return VDiv<FT, kRoundTowardZero>(pa, pb, dest, len);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
   }
+}
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+void SimdFloat::VDiv(FT* pa, FT* pb, FT* dest, size_t len) {
   size_t ind = 0;
-  while ((ind + stdx::native_simd<FT>::size()) <= len) {
+  while ((ind + fvec<FT>::size()) <= len) {
     fvec<FT> a, b, c;
     a.copy_from(&pa[ind], stdx::element_aligned);
     b.copy_from(&pb[ind], stdx::element_aligned);
 
     c = a / b;
-    if (stdx::any_of(VIsInfOrNan(c))) [[unlikely]] {
-      if (stdx::any_of(VIsInf(c) && !VIsInf(a) && VIsZero(b)))
-        SetDivisionByZero();
-      if (stdx::any_of(VIsInf(c) && !VIsInf(a) && !VIsInf(b) && !VIsZero(b))) {
-        SetOverflow();
-        SetInexact();
+    if constexpr (rm == kRoundTiesToEven) {
+      if (stdx::any_of(VIsInfOrNan(c))) [[unlikely]] {
+        if (stdx::any_of(VIsInf(c) && !VIsInf(a) && VIsZero(b)))
+          SetDivisionByZero();
+        if (stdx::any_of(VIsInf(c) && !VIsInf(a) && !VIsInf(b) && !VIsZero(b))) {
+          SetOverflow();
+          SetInexact();
+        }
+        if (stdx::any_of(VIsNan(c) && !VIsNan(a) && !VIsNan(b)))
+          SetInvalid();  // 0 / 0 and ∞ / ∞
+        if (stdx::any_of(VIsSnan(a) || VIsSnan(b)))
+          SetInvalid();
+        VPropagateNan(c, a, b);
       }
-      if (stdx::any_of(VIsSnan(a) || VIsSnan(b)))
-        SetInvalid();
-      stdx::where(c != c, c) = VGetQnan<FT>();
-    }
 
-    if (!inexact) [[unlikely]] {
-      for (size_t i = 0; i < fvec<FT>::size(); ++i)
-        FloppyFloat::Div(pa[ind + i], pb[ind + i]);
-    }
-    if (!underflow) {
-      auto is_small = c < VGetMin<FT>() && c > -VGetMin<FT>();
-      if (stdx::any_of(is_small)) {
+      // If one input is NaN or ±infinity, or the divisor is zero, the residual "r" will be a qNaN,
+      // and no inexact or underflow flag is set.
+      if (!inexact) [[unlikely]] {
+        auto r = VUpDiv(a, b, c);
+        if (stdx::any_of(VIsNonZero(r)))
+          SetInexact();
+      }
+      if (!underflow) {
+        auto is_small = abs(c) <= VGetMin<FT>();  // See MayResultFromUnderflow.
+        // The ratio of two p-bit significands cannot lie strictly between 1 - 2^-p and 1 or between 1 and 1 + 2^-p. So a
+        // quotient that rounds to at most the smallest normal number 2^emin is either exact or at most 2^emin (1 - 2^-p),
+        // which may still round to 2^emin in the subnormal range, but stays below 2^emin with an unbounded exponent.
+        // Hence, all inexact quotients of at most that magnitude are tiny in both tininess modes.
+        if (stdx::any_of(is_small)) [[unlikely]] {
+          auto r = VUpDiv(a, b, c);
+          if (stdx::any_of(is_small && VMaskCast<FT>(VIsNonZero(r))))
+            SetUnderflow();
+        }
+      }
+    } else {
+      // NaN, overflow, and division by zero lanes as well as lanes that may underflow are left to the scalar
+      // implementation.
+      auto scalar = VIsInfOrNan(c) || (abs(c) <= VGetMin<FT>() && VIsNonZero(a));
+      // The residual is computed for a positive divisor, so that its sign does not need to be corrected.
+      fvec<FT> an = a;
+      fvec<FT> bn = abs(b);
+      stdx::where(b < 0, an) = -a;
+      VRoundResult<rm>(c, VUpDiv(an, bn, c), scalar, fmask<FT>(false));  // There are no ties for normal quotients.
+      if (stdx::any_of(scalar)) [[unlikely]] {
         for (size_t i = 0; i < fvec<FT>::size(); ++i)
-          FloppyFloat::Div(pa[ind + i], pb[ind + i]);
+          if (scalar[i])
+            c[i] = FloppyFloat::Div<FT, rm>(pa[ind + i], pb[ind + i]);
       }
     }
     c.copy_to(&dest[ind], stdx::element_aligned);
@@ -374,7 +712,7 @@ void SimdFloat::VDiv(FT* pa, FT* pb, FT* dest, size_t len) {
   }
 
   for (; ind < len; ++ind)
-    dest[ind] = FloppyFloat::Div<FT, kRoundTiesToEven>(pa[ind], pb[ind]);
+    dest[ind] = FloppyFloat::Div<FT, rm>(pa[ind], pb[ind]);
 }
 
 template void SimdFloat::VSqrt<f32>(f32* pa, f32* dest, size_t len);
@@ -382,87 +720,1301 @@ template void SimdFloat::VSqrt<f64>(f64* pa, f64* dest, size_t len);
 
 template <typename FT>
 void SimdFloat::VSqrt(FT* pa, FT* dest, size_t len) {
-  if (rounding_mode != kRoundTiesToEven) [[unlikely]] {
-    for (size_t i = 0; i < len; ++i) {
-      dest[i] = FloppyFloat::Sqrt<FT>(pa[i]);
-    }
-    return;
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return VSqrt<FT, kRoundTiesToEven>(pa, dest, len);
+  case kRoundTiesToAway:
+    return VSqrt<FT, kRoundTiesToAway>(pa, dest, len);
+  case kRoundTowardPositive:
+    return VSqrt<FT, kRoundTowardPositive>(pa, dest, len);
+  case kRoundTowardNegative:
+    return VSqrt<FT, kRoundTowardNegative>(pa, dest, len);
+  case kRoundTowardZero:
+    return VSqrt<FT, kRoundTowardZero>(pa, dest, len);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
   }
+}
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+void SimdFloat::VSqrt(FT* pa, FT* dest, size_t len) {
   size_t ind = 0;
-  while ((ind + stdx::native_simd<FT>::size()) <= len) {
+  while ((ind + fvec<FT>::size()) <= len) {
     fvec<FT> a, b;
     a.copy_from(&pa[ind], stdx::element_aligned);
 
     b = vsqrt(a);
-    if (stdx::any_of(VIsNan(b))) [[unlikely]] {
-      if (stdx::any_of(VIsSnan(a)) || stdx::any_of(a < 0))
-        SetInvalid();
-      stdx::where(b != b, b) = VGetQnan<FT>();
-    }
+    if constexpr (rm == kRoundTiesToEven) {
+      if (stdx::any_of(VIsNan(b))) [[unlikely]] {
+        if (stdx::any_of(VIsSnan(a)) || stdx::any_of(a < 0))
+          SetInvalid();
+        VPropagateNan(b, a, a);
+      }
 
-    if (!inexact) [[unlikely]] {
-      for (size_t i = 0; i < fvec<FT>::size(); ++i)
-        FloppyFloat::Sqrt(pa[ind + i]);
+      // Square roots cannot underflow. For NaN and ±infinity, the residual will be a qNaN.
+      if (!inexact) [[unlikely]] {
+        auto r = VUpSqrt(a, b);
+        if (stdx::any_of(VIsNonZero(r)))
+          SetInexact();
+      }
+    } else {
+      auto scalar = VIsInfOrNan(b);  // NaN lanes are left to the scalar implementation.
+      VRoundResult<rm>(b, VUpSqrt(a, b), scalar, fmask<FT>(false));  // There are no ties for square roots.
+      if (stdx::any_of(scalar)) [[unlikely]] {
+        for (size_t i = 0; i < fvec<FT>::size(); ++i)
+          if (scalar[i])
+            b[i] = FloppyFloat::Sqrt<FT, rm>(pa[ind + i]);
+      }
     }
     b.copy_to(&dest[ind], stdx::element_aligned);
     ind += fvec<FT>::size();
   }
 
   for (; ind < len; ++ind)
-    dest[ind] = FloppyFloat::Sqrt(pa[ind]);
+    dest[ind] = FloppyFloat::Sqrt<FT, rm>(pa[ind]);
 }
 
+template void SimdFloat::VFma<f32>(f32* pa, f32* pb, f32* pc, f32* dest, size_t len);
+template void SimdFloat::VFma<f64>(f64* pa, f64* pb, f64* pc, f64* dest, size_t len);
+
 template <typename FT>
 void SimdFloat::VFma(FT* pa, FT* pb, FT* pc, FT* dest, size_t len) {
-  if (rounding_mode != kRoundTiesToEven) [[unlikely]] {
-    for (size_t i = 0; i < len; ++i) {
-      dest[i] = FloppyFloat::Fma<FT>(pa[i], pb[i], pc[i]);
-    }
-    return;
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return VFma<FT, kRoundTiesToEven>(pa, pb, pc, dest, len);
+  case kRoundTiesToAway:
+    return VFma<FT, kRoundTiesToAway>(pa, pb, pc, dest, len);
+  case kRoundTowardPositive:
+    return VFma<FT, kRoundTowardPositive>(pa, pb, pc, dest, len);
+  case kRoundTowardNegative:
+    return VFma<FT, kRoundTowardNegative>(pa, pb, pc, dest, len);
+  case kRoundTowardZero:
+    return VFma<FT, kRoundTowardZero>(pa, pb, pc, dest, len);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
   }
+}
 
+template <typename FT, FloppyFloat::RoundingMode rm>
+void SimdFloat::VFma(FT* pa, FT* pb, FT* pc, FT* dest, size_t len) {
   size_t ind = 0;
-  while ((ind + stdx::native_simd<FT>::size()) <= len) {
+  while ((ind + fvec<FT>::size()) <= len) {
     fvec<FT> a, b, c, d;
     a.copy_from(&pa[ind], stdx::element_aligned);
     b.copy_from(&pb[ind], stdx::element_aligned);
     c.copy_from(&pc[ind], stdx::element_aligned);
 
     d = vfma(a, b, c);
-    if (unlikely(stdx::any_of(VIsInfOrNan(d)))) {
-      if (stdx::any_of(VIsInf(d) && !VIsInf(a) && !VIsInf(b) && !VIsInf(c))) {
+    if constexpr (rm == kRoundTiesToEven) {
+      if (stdx::any_of(VIsInfOrNan(d))) [[unlikely]] {
+        if (stdx::any_of(VIsInf(d) && !VIsInf(a) && !VIsInf(b) && !VIsInf(c))) {
+          SetOverflow();
+          SetInexact();
+        }
+        if (stdx::any_of(VIsSnan(a) || VIsSnan(b) || VIsSnan(c)))
+          SetInvalid();
+        if (stdx::any_of((VIsNan(d) && !VIsNan(a)) && !VIsNan(b) && !VIsNan(c)))
+          SetInvalid();
+        if (invalid_fma && stdx::any_of((VIsInf(a) && VIsZero(b)) || (VIsZero(a) && VIsInf(b))))
+          SetInvalid();  // ∞ × 0 + qNaN
+        VPropagateNan(d, a, b, c);
+      }
+
+      // If one input is NaN or ±infinity, the residual "r" will be a qNaN, and no inexact or underflow flag is set.
+      // For f64, lanes whose product overflows or whose product or result is below the limit of the FMA residual are
+      // left to the scalar implementation. This includes all lanes that may underflow.
+      if (!inexact) [[unlikely]] {
+        fmask<FT> exact;
+        auto r = VUpFma(a, b, c, d, exact);
+        if constexpr (std::is_same_v<FT, f64>) {
+          fvec<f64> p = a * b;
+          auto is_small = abs(p) <= kVFmaResidualLimit || abs(d) <= kVFmaResidualLimit;
+          auto scalar = !VIsInfOrNan(d) && (VIsInfOrNan(p) || (is_small && VIsNonZero(a) && VIsNonZero(b)));
+          if (stdx::any_of(VIsNonZero(r) && !scalar))
+            SetInexact();
+          VForEachLane(scalar, [&](int i) { FloppyFloat::Fma<FT, rm>(pa[ind + i], pb[ind + i], pc[ind + i]); });
+        } else {
+          if (stdx::any_of(VIsNonZero(r)))
+            SetInexact();
+        }
+      }
+      if (!underflow) {
+        auto is_small = abs(d) <= VGetMin<FT>();  // See MayResultFromUnderflow.
+        if (stdx::any_of(is_small)) [[unlikely]] {
+          if constexpr (std::is_same_v<FT, f64>) {
+            VForEachLane(is_small && VIsNonZero(a) && VIsNonZero(b),
+                         [&](int i) { FloppyFloat::Fma<FT, rm>(pa[ind + i], pb[ind + i], pc[ind + i]); });
+          } else {
+            fmask<FT> exact;
+            auto r = VUpFma(a, b, c, d, exact);
+            if (stdx::any_of(abs(d) < VGetMin<FT>() && VMaskCast<FT>(VIsNonZero(r))))
+              SetUnderflow();
+            // Whether a result that was rounded to the smallest normal number is tiny depends on the tininess mode.
+            VForEachLane(abs(d) == VGetMin<FT>(),
+                         [&](int i) { FloppyFloat::Fma<FT, rm>(pa[ind + i], pb[ind + i], pc[ind + i]); });
+          }
+        }
+      }
+    } else {
+      // NaN and overflow lanes as well as lanes that may underflow are left to the scalar implementation. For f64,
+      // the latter includes all lanes whose product or result is below the limit of the FMA residual.
+      auto scalar = VIsInfOrNan(d) || (abs(d) <= VGetMin<FT>() && VIsNonZero(a) && VIsNonZero(b));
+      if constexpr (std::is_same_v<FT, f64>) {
+        fvec<f64> p = a * b;
+        auto is_small = abs(p) <= kVFmaResidualLimit || abs(d) <= kVFmaResidualLimit;
+        scalar = scalar || VIsInfOrNan(p) || (is_small && VIsNonZero(a) && VIsNonZero(b));
+      }
+      if constexpr (rm == kRoundTowardNegative) {  // See Fma.
+        if (stdx::any_of(VIsZero(d))) [[unlikely]]
+          stdx::where(VIsZero(d) && !stdx::signbit(d) && ((stdx::signbit(a) != stdx::signbit(b)) || stdx::signbit(c)),
+                      d) = -d;
+      }
+      fmask<FT> exact;
+      auto r = VUpFma(a, b, c, d, exact);
+      VRoundResult<rm>(d, r, scalar, exact);
+      if (stdx::any_of(scalar)) [[unlikely]] {
+        for (size_t i = 0; i < fvec<FT>::size(); ++i)
+          if (scalar[i])
+            d[i] = FloppyFloat::Fma<FT, rm>(pa[ind + i], pb[ind + i], pc[ind + i]);
+      }
+    }
+    d.copy_to(&dest[ind], stdx::element_aligned);
+    ind += fvec<FT>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::Fma<FT, rm>(pa[ind], pb[ind], pc[ind]);
+}
+
+// Widens fvec<FTACC>::size() elements exactly. Half-precision inputs are widened with integer operations like the
+// scalar version, as their host conversions are libgcc calls without F16C. Sets "special" for f16 infinities and NaNs,
+// which the scaling does not preserve. Other specials propagate to the result.
+template <typename FTIN, typename FTACC>
+fvec<FTACC> VWidenExact(const FTIN* p, bool& special) {
+  if constexpr (std::is_same_v<FTIN, FfUtils::f16> || std::is_same_v<FTIN, FfUtils::bf16>) {
+    using uvec = stdx::rebind_simd_t<FfUtils::u32, fvec<FTACC>>;
+    uvec bits([&](auto i) { return static_cast<FfUtils::u32>(std::bit_cast<FfUtils::u16>(p[i])); });
+    if constexpr (std::is_same_v<FTIN, FfUtils::bf16>)
+      return stdx::__proposed::simd_bit_cast<fvec<FTACC>>(bits << 16);
+    special = special || stdx::any_of((bits & 0x7c00u) == 0x7c00u);
+    auto mag = stdx::__proposed::simd_bit_cast<fvec<FTACC>>((bits & 0x7fffu) << 13) * 0x1p112f;
+    return stdx::__proposed::simd_bit_cast<fvec<FTACC>>(stdx::__proposed::simd_bit_cast<uvec>(mag) |
+                                                        ((bits & 0x8000u) << 16));
+  } else {
+    return fvec<FTACC>([&](auto i) { return static_cast<FTACC>(p[i]); });
+  }
+}
+
+template void SimdFloat::VFmaWiden<FfUtils::f16, f32>(FfUtils::f16* pa, FfUtils::f16* pb, f32* pc, f32* dest,
+                                                      size_t len);
+template void SimdFloat::VFmaWiden<FfUtils::bf16, f32>(FfUtils::bf16* pa, FfUtils::bf16* pb, f32* pc, f32* dest,
+                                                       size_t len);
+template void SimdFloat::VFmaWiden<f32, f64>(f32* pa, f32* pb, f64* pc, f64* dest, size_t len);
+
+// Products of f16 (f32) operands are exact in f32 (f64), so the FMA is an addition whose residual is checked with
+// Fast2Sum. Products of bf16 operands are not, so they use the host FMA and determine inexact and underflow like VFma.
+// Blocks with special cases are redone with the scalar version.
+template <typename FTIN, typename FTACC>
+void SimdFloat::VFmaWiden(FTIN* pa, FTIN* pb, FTACC* pc, FTACC* dest, size_t len) {
+  if (rounding_mode != kRoundTiesToEven) [[unlikely]] {
+    for (size_t i = 0; i < len; ++i)
+      dest[i] = FloppyFloat::FmaWiden<FTIN, FTACC>(pa[i], pb[i], pc[i]);
+    return;
+  }
+
+  constexpr bool kExactProduct = !std::is_same_v<FTIN, FfUtils::bf16>;
+  size_t ind = 0;
+  while ((ind + fvec<FTACC>::size()) <= len) {
+    bool redo = false;
+    fvec<FTACC> a = VWidenExact<FTIN, FTACC>(&pa[ind], redo);
+    fvec<FTACC> b = VWidenExact<FTIN, FTACC>(&pb[ind], redo);
+    fvec<FTACC> c, d;
+    c.copy_from(&pc[ind], stdx::element_aligned);
+
+    if constexpr (kExactProduct) {
+      fvec<FTACC> p = a * b;
+      d = p + c;
+      redo = redo || stdx::any_of(VIsInfOrNan(d));
+      if (!redo && !inexact) [[unlikely]] {
+        if (stdx::any_of(VIsNonZero(VFastTwoSum<fvec<FTACC>>(p, c, d))))
+          SetInexact();
+      }
+    } else {
+      d = vfma(a, b, c);
+      redo = stdx::any_of(VIsInfOrNan(d)) || !inexact || (!underflow && stdx::any_of(abs(d) <= VGetMin<FTACC>()));
+    }
+
+    if (redo) [[unlikely]] {
+      for (size_t i = 0; i < fvec<FTACC>::size(); ++i)
+        dest[ind + i] = FloppyFloat::FmaWiden<FTIN, FTACC, kRoundTiesToEven>(pa[ind + i], pb[ind + i], pc[ind + i]);
+    } else {
+      d.copy_to(&dest[ind], stdx::element_aligned);
+    }
+    ind += fvec<FTACC>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::FmaWiden<FTIN, FTACC, kRoundTiesToEven>(pa[ind], pb[ind], pc[ind]);
+}
+
+// Returns which of the elements [ind, ind + fvec<FT>::size()) are within [vstart, vl).
+template <typename FT>
+fmask<FT> VBodyLanes(size_t ind, size_t vstart, size_t vl) {
+  using UT = typename FfUtils::FloatToUint<FT>::type;
+  const fbits<FT> lanes([](auto i) { return static_cast<UT>(i); });
+  fbits<FT> e = lanes + static_cast<UT>(ind);
+  return stdx::__proposed::static_simd_cast<fmask<FT>>(e >= static_cast<UT>(vstart) && e < static_cast<UT>(vl));
+}
+
+// Returns which of the elements [ind, ind + fvec<FT>::size()) have their bit set in "mask", or all for no mask. As "ind"
+// is a multiple of fvec<FT>::size(), the bits are within a single 64-bit word. Bytes past element vl are not read.
+template <typename FT>
+fmask<FT> VMaskLanes(const FfUtils::u8* mask, size_t ind, size_t vl) {
+  using UT = typename FfUtils::FloatToUint<FT>::type;
+  constexpr size_t kN = fvec<FT>::size();
+  if (mask == nullptr)
+    return fmask<FT>(true);
+  const fbits<FT> lane_bits([](auto i) { return static_cast<UT>(static_cast<UT>(1) << i); });
+  FfUtils::u64 bits = 0;
+  for (size_t j = 0; j < (kN + 7) / 8 && ind / 8 + j <= (vl - 1) / 8; ++j)
+    bits |= static_cast<FfUtils::u64>(mask[ind / 8 + j]) << (8 * j);
+  bits >>= ind % 8;
+  return stdx::__proposed::static_simd_cast<fmask<FT>>((fbits<FT>(static_cast<UT>(bits)) & lane_bits) != 0);
+}
+
+// Runs "op" on blocks of whole chunks, whose inactive elements are replaced by 1. No operation raises an exception for
+// these, so that the flags only reflect active elements. The results are merged into "dest" with vector selects, and
+// masked loads and stores are only used for the partial chunks at vstart and vl. Note: "dest" may alias the sources, as
+// each block is loaded before it is stored. With at most two lanes (f64 on SSE2), the block copies and mask merges cost
+// more than they save, so the active elements go through the scalar operation "sop" instead.
+template <typename FT, size_t nargs, typename OP, typename SOP>
+void SimdFloat::VMasked(std::array<FT*, nargs> srcs, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                        size_t vlmax, FfUtils::u8 policy, OP op, SOP sop) {
+  constexpr size_t kN = fvec<FT>::size();
+  constexpr size_t kBlock = 32 * kN;
+  const auto ones = stdx::__proposed::simd_bit_cast<fvec<FT>>(~fbits<FT>(0));
+  if (vstart >= vl)
+    return;  // No element is updated, not even agnostic tail elements.
+
+  if constexpr (kN <= 2) {
+    for (size_t i = vstart; i < vl; ++i) {
+      if (mask == nullptr || ((mask[i / 8] >> (i % 8)) & 1)) {
+        std::array<FT, nargs> args;
+        for (size_t j = 0; j < nargs; ++j)
+          args[j] = srcs[j][i];
+        dest[i] = sop(args);
+      } else if (policy & kRvvMaskAgnostic) {
+        dest[i] = ones[0];
+      }
+    }
+    if (policy & kRvvTailAgnostic)
+      std::fill(dest + vl, dest + std::max(vl, vlmax), ones[0]);
+    return;
+  }
+
+  std::array<std::array<FT, kBlock>, nargs> args;
+  std::array<FT, kBlock> res;
+  std::array<fmask<FT>, kBlock / kN> active;
+  for (size_t block = vstart / kN * kN; block < vl; block += kBlock) {
+    size_t len = std::min(kBlock, (vl - block + kN - 1) / kN * kN);
+    for (size_t ind = block; ind < block + len; ind += kN) {
+      auto& act = active[(ind - block) / kN];
+      act = VMaskLanes<FT>(mask, ind, vl);
+      bool full = ind >= vstart && ind + kN <= vl;
+      if (!full) [[unlikely]]
+        act = act && VBodyLanes<FT>(ind, vstart, vl);
+      for (size_t j = 0; j < nargs; ++j) {
+        fvec<FT> v(static_cast<FT>(1.));
+        if (full) [[likely]] {
+          v.copy_from(&srcs[j][ind], stdx::element_aligned);
+          stdx::where(!act, v) = static_cast<FT>(1.);
+        } else {
+          stdx::where(act, v).copy_from(&srcs[j][ind], stdx::element_aligned);
+        }
+        v.copy_to(&args[j][ind - block], stdx::element_aligned);
+      }
+    }
+
+    op(args, res.data(), len);
+
+    for (size_t ind = block; ind < block + len; ind += kN) {
+      auto& act = active[(ind - block) / kN];
+      fvec<FT> c;
+      c.copy_from(&res[ind - block], stdx::element_aligned);
+      if (ind >= vstart && ind + kN <= vl) [[likely]] {
+        fvec<FT> d;
+        d.copy_from(&dest[ind], stdx::element_aligned);
+        if (policy & kRvvMaskAgnostic)
+          d = ones;
+        stdx::where(act, d) = c;
+        d.copy_to(&dest[ind], stdx::element_aligned);
+      } else {
+        auto body = VBodyLanes<FT>(ind, vstart, vl);
+        if (policy & kRvvMaskAgnostic) {
+          stdx::where(!act, c) = ones;
+          stdx::where(body, c).copy_to(&dest[ind], stdx::element_aligned);
+        } else {
+          stdx::where(act, c).copy_to(&dest[ind], stdx::element_aligned);
+        }
+      }
+    }
+  }
+
+  if (policy & kRvvTailAgnostic)
+    std::fill(dest + vl, dest + std::max(vl, vlmax), ones[0]);
+}
+
+template void SimdFloat::VAddMasked<f32>(f32* pa, f32* pb, f32* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                         size_t vlmax, FfUtils::u8 policy);
+template void SimdFloat::VAddMasked<f64>(f64* pa, f64* pb, f64* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                         size_t vlmax, FfUtils::u8 policy);
+
+template <typename FT>
+void SimdFloat::VAddMasked(FT* pa, FT* pb, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                           FfUtils::u8 policy) {
+  VMasked<FT, 2>({pa, pb}, dest, mask, vstart, vl, vlmax, policy,
+                 [this](auto& args, FT* res, size_t len) { VAdd<FT>(args[0].data(), args[1].data(), res, len); },
+                 [this](auto& a) { return FloppyFloat::Add<FT>(a[0], a[1]); });
+}
+
+template void SimdFloat::VSubMasked<f32>(f32* pa, f32* pb, f32* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                         size_t vlmax, FfUtils::u8 policy);
+template void SimdFloat::VSubMasked<f64>(f64* pa, f64* pb, f64* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                         size_t vlmax, FfUtils::u8 policy);
+
+template <typename FT>
+void SimdFloat::VSubMasked(FT* pa, FT* pb, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                           FfUtils::u8 policy) {
+  VMasked<FT, 2>({pa, pb}, dest, mask, vstart, vl, vlmax, policy,
+                 [this](auto& args, FT* res, size_t len) { VSub<FT>(args[0].data(), args[1].data(), res, len); },
+                 [this](auto& a) { return FloppyFloat::Sub<FT>(a[0], a[1]); });
+}
+
+template void SimdFloat::VMulMasked<f32>(f32* pa, f32* pb, f32* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                         size_t vlmax, FfUtils::u8 policy);
+template void SimdFloat::VMulMasked<f64>(f64* pa, f64* pb, f64* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                         size_t vlmax, FfUtils::u8 policy);
+
+template <typename FT>
+void SimdFloat::VMulMasked(FT* pa, FT* pb, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                           FfUtils::u8 policy) {
+  VMasked<FT, 2>({pa, pb}, dest, mask, vstart, vl, vlmax, policy,
+                 [this](auto& args, FT* res, size_t len) { VMul<FT>(args[0].data(), args[1].data(), res, len); },
+                 [this](auto& a) { return FloppyFloat::Mul<FT>(a[0], a[1]); });
+}
+
+template void SimdFloat::VDivMasked<f32>(f32* pa, f32* pb, f32* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                         size_t vlmax, FfUtils::u8 policy);
+template void SimdFloat::VDivMasked<f64>(f64* pa, f64* pb, f64* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                         size_t vlmax, FfUtils::u8 policy);
+
+template <typename FT>
+void SimdFloat::VDivMasked(FT* pa, FT* pb, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                           FfUtils::u8 policy) {
+  VMasked<FT, 2>({pa, pb}, dest, mask, vstart, vl, vlmax, policy,
+                 [this](auto& args, FT* res, size_t len) { VDiv<FT>(args[0].data(), args[1].data(), res, len); },
+                 [this](auto& a) { return FloppyFloat::Div<FT>(a[0], a[1]); });
+}
+
+template void SimdFloat::VSqrtMasked<f32>(f32* pa, f32* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                          size_t vlmax, FfUtils::u8 policy);
+template void SimdFloat::VSqrtMasked<f64>(f64* pa, f64* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                                          size_t vlmax, FfUtils::u8 policy);
+
+template <typename FT>
+void SimdFloat::VSqrtMasked(FT* pa, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                            FfUtils::u8 policy) {
+  VMasked<FT, 1>({pa}, dest, mask, vstart, vl, vlmax, policy,
+                 [this](auto& args, FT* res, size_t len) { VSqrt<FT>(args[0].data(), res, len); },
+                 [this](auto& a) { return FloppyFloat::Sqrt<FT>(a[0]); });
+}
+
+template void SimdFloat::VFmaMasked<f32>(f32* pa, f32* pb, f32* pc, f32* dest, const FfUtils::u8* mask, size_t vstart,
+                                         size_t vl, size_t vlmax, FfUtils::u8 policy);
+template void SimdFloat::VFmaMasked<f64>(f64* pa, f64* pb, f64* pc, f64* dest, const FfUtils::u8* mask, size_t vstart,
+                                         size_t vl, size_t vlmax, FfUtils::u8 policy);
+
+template <typename FT>
+void SimdFloat::VFmaMasked(FT* pa, FT* pb, FT* pc, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl,
+                           size_t vlmax, FfUtils::u8 policy) {
+  VMasked<FT, 3>(
+      {pa, pb, pc}, dest, mask, vstart, vl, vlmax, policy,
+      [this](auto& args, FT* res, size_t len) { VFma<FT>(args[0].data(), args[1].data(), args[2].data(), res, len); },
+      [this](auto& a) { return FloppyFloat::Fma<FT>(a[0], a[1], a[2]); });
+}
+
+template void SimdFloat::VMaximum<f32>(f32* pa, f32* pb, f32* dest, size_t len);
+template void SimdFloat::VMaximum<f64>(f64* pa, f64* pb, f64* dest, size_t len);
+
+template <typename FT>
+void SimdFloat::VMaximum(FT* pa, FT* pb, FT* dest, size_t len) {
+  size_t ind = 0;
+  while ((ind + fvec<FT>::size()) <= len) {
+    fvec<FT> a, b;
+    a.copy_from(&pa[ind], stdx::element_aligned);
+    b.copy_from(&pb[ind], stdx::element_aligned);
+
+    if (stdx::any_of(VIsNan(a) || VIsNan(b))) [[unlikely]] {
+      for (size_t i = 0; i < fvec<FT>::size(); ++i)
+        dest[ind + i] = FloppyFloat::Maximum<FT>(pa[ind + i], pb[ind + i]);
+    } else {
+      auto a_greater = VTotalOrderKey<FT>(a) > VTotalOrderKey<FT>(b);
+      stdx::where(stdx::__proposed::static_simd_cast<fmask<FT>>(a_greater), b) = a;
+      b.copy_to(&dest[ind], stdx::element_aligned);
+    }
+    ind += fvec<FT>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::Maximum<FT>(pa[ind], pb[ind]);
+}
+
+template void SimdFloat::VMinimum<f32>(f32* pa, f32* pb, f32* dest, size_t len);
+template void SimdFloat::VMinimum<f64>(f64* pa, f64* pb, f64* dest, size_t len);
+
+template <typename FT>
+void SimdFloat::VMinimum(FT* pa, FT* pb, FT* dest, size_t len) {
+  size_t ind = 0;
+  while ((ind + fvec<FT>::size()) <= len) {
+    fvec<FT> a, b;
+    a.copy_from(&pa[ind], stdx::element_aligned);
+    b.copy_from(&pb[ind], stdx::element_aligned);
+
+    if (stdx::any_of(VIsNan(a) || VIsNan(b))) [[unlikely]] {
+      for (size_t i = 0; i < fvec<FT>::size(); ++i)
+        dest[ind + i] = FloppyFloat::Minimum<FT>(pa[ind + i], pb[ind + i]);
+    } else {
+      auto a_less = VTotalOrderKey<FT>(a) < VTotalOrderKey<FT>(b);
+      stdx::where(stdx::__proposed::static_simd_cast<fmask<FT>>(a_less), b) = a;
+      b.copy_to(&dest[ind], stdx::element_aligned);
+    }
+    ind += fvec<FT>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::Minimum<FT>(pa[ind], pb[ind]);
+}
+
+template void SimdFloat::VRecipEstimateRiscv<f32>(f32* pa, f32* dest, size_t len);
+template void SimdFloat::VRecipEstimateRiscv<f64>(f64* pa, f64* dest, size_t len);
+
+// Normal inputs with normal results are handled with a per-lane table lookup.
+// Chunks that contain zeros, subnormals, infinities, NaNs, or produce subnormals use the scalar version.
+template <typename FT>
+void SimdFloat::VRecipEstimateRiscv(FT* pa, FT* dest, size_t len) {
+  using UT = typename FfUtils::FloatToUint<FT>::type;
+  using uvec = stdx::rebind_simd_t<UT, fvec<FT>>;
+  constexpr int kSigBits = FfUtils::NumSignificandBits<FT>();
+  constexpr UT kMaxExp = 2 * FfUtils::Bias<FT>() - 2;
+  size_t ind = 0;
+  while ((ind + fvec<FT>::size()) <= len) {
+    fvec<FT> a;
+    a.copy_from(&pa[ind], stdx::element_aligned);
+    uvec ua = stdx::__proposed::simd_bit_cast<uvec>(a);
+    uvec exp = (ua & FfUtils::ExponentMask<FT>()) >> kSigBits;
+
+    if (stdx::any_of(exp == 0 || exp > kMaxExp)) [[unlikely]] {
+      for (size_t i = 0; i < fvec<FT>::size(); ++i)
+        dest[ind + i] = FloppyFloat::RecipEstimateRiscv<FT>(pa[ind + i]);
+    } else {
+      uvec index = (ua >> (kSigBits - 7)) & 0x7f;
+      uvec sig([&](auto i) { return static_cast<UT>(static_cast<UT>(FfUtils::kRecip7Table[index[i]]) << (kSigBits - 7)); });
+      uvec res = (ua & FfUtils::SignMask<FT>()) | ((static_cast<UT>(kMaxExp + 1) - exp) << kSigBits) | sig;
+      stdx::__proposed::simd_bit_cast<fvec<FT>>(res).copy_to(&dest[ind], stdx::element_aligned);
+    }
+    ind += fvec<FT>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::RecipEstimateRiscv<FT>(pa[ind]);
+}
+
+template void SimdFloat::VRsqrtEstimateRiscv<f32>(f32* pa, f32* dest, size_t len);
+template void SimdFloat::VRsqrtEstimateRiscv<f64>(f64* pa, f64* dest, size_t len);
+
+// Positive normal inputs are handled with a per-lane table lookup, all other chunks use the scalar version.
+template <typename FT>
+void SimdFloat::VRsqrtEstimateRiscv(FT* pa, FT* dest, size_t len) {
+  using UT = typename FfUtils::FloatToUint<FT>::type;
+  using uvec = stdx::rebind_simd_t<UT, fvec<FT>>;
+  constexpr int kSigBits = FfUtils::NumSignificandBits<FT>();
+  constexpr UT kExpInfNan = FfUtils::ExponentMask<FT>() >> kSigBits;
+  size_t ind = 0;
+  while ((ind + fvec<FT>::size()) <= len) {
+    fvec<FT> a;
+    a.copy_from(&pa[ind], stdx::element_aligned);
+    uvec ua = stdx::__proposed::simd_bit_cast<uvec>(a);
+    uvec exp = ua >> kSigBits;  // Includes the sign bit, so negative values are caught below.
+
+    if (stdx::any_of(exp == 0 || exp >= kExpInfNan)) [[unlikely]] {
+      for (size_t i = 0; i < fvec<FT>::size(); ++i)
+        dest[ind + i] = FloppyFloat::RsqrtEstimateRiscv<FT>(pa[ind + i]);
+    } else {
+      uvec index = ((exp & 1) << 6) | ((ua >> (kSigBits - 6)) & 0x3f);
+      uvec sig([&](auto i) { return static_cast<UT>(static_cast<UT>(FfUtils::kRsqrt7Table[index[i]]) << (kSigBits - 7)); });
+      uvec res = (((static_cast<UT>(3 * FfUtils::Bias<FT>() - 1) - exp) >> 1) << kSigBits) | sig;
+      stdx::__proposed::simd_bit_cast<fvec<FT>>(res).copy_to(&dest[ind], stdx::element_aligned);
+    }
+    ind += fvec<FT>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::RsqrtEstimateRiscv<FT>(pa[ind]);
+}
+
+template void SimdFloat::VClass<f32>(f32* pa, FfUtils::u32* dest, size_t len);
+template void SimdFloat::VClass<f64>(f64* pa, FfUtils::u32* dest, size_t len);
+
+// Classifies on the integer representation: The magnitude bits are compared against the encodings of the smallest
+// normal number and infinity, which yields the distance "k" of the class from zero (see ClassIndex).
+template <typename FT>
+void SimdFloat::VClass(FT* pa, FfUtils::u32* dest, size_t len) {
+  using UT = typename FfUtils::FloatToUint<FT>::type;
+  constexpr UT kMinBits = std::bit_cast<UT>(nl<FT>::min());
+  size_t ind = 0;
+  while ((ind + fvec<FT>::size()) <= len) {
+    fvec<FT> a;
+    a.copy_from(&pa[ind], stdx::element_aligned);
+
+    auto bits = stdx::__proposed::simd_bit_cast<fbits<FT>>(a);
+    auto mag = VMagnitudeBits<FT>(a);
+    fbits<FT> k = 0;
+    stdx::where(mag != 0, k) += 1;
+    stdx::where(mag >= kMinBits, k) += 1;
+    stdx::where(mag >= kVInfBits<FT>, k) += 1;
+    fbits<FT> index = ClassIndex::kPosZero + k;
+    stdx::where(bits != mag, index) = ClassIndex::kNegZero - k;
+    stdx::where(mag > kVInfBits<FT>, index) = ClassIndex::kSNan;
+    stdx::where(mag >= (kVInfBits<FT> | kVQuietBit<FT>), index) = ClassIndex::kQNan;
+
+    auto res = stdx::static_simd_cast<stdx::rebind_simd_t<FfUtils::u32, fvec<FT>>>(fbits<FT>(1) << index);
+    res.copy_to(&dest[ind], stdx::element_aligned);
+    ind += fvec<FT>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::Class<FT>(pa[ind]);
+}
+
+// Returns a function that packs the result masks, which must be passed in order, into the bits of "dest". The lane bits
+// are selected in the floating-point domain, which avoids mask conversions, and combined with a horizontal OR. They are
+// collected in a 64-bit word that is stored every 64 elements and after element "len" - 1, leaving higher bits unchanged.
+template <typename FT>
+auto VMaskBitsWriter(FfUtils::u8* dest, size_t len) {
+  return [dest, len, word = FfUtils::u64(0)](size_t ind, fmask<FT> m) mutable {
+    using UT = typename FfUtils::FloatToUint<FT>::type;
+    static_assert(fvec<FT>::size() <= 32);
+    const fbits<FT> lane_bits([](auto i) { return static_cast<UT>(static_cast<UT>(1) << i); });
+    fvec<FT> sel(0);
+    stdx::where(m, sel) = stdx::__proposed::simd_bit_cast<fvec<FT>>(lane_bits);
+    auto sel_bits = stdx::__proposed::simd_bit_cast<fbits<FT>>(sel);
+    word |= static_cast<FfUtils::u64>(stdx::reduce(sel_bits, std::bit_or<>())) << (ind % 64);
+
+    size_t end = std::min(ind + fvec<FT>::size(), len);
+    if (end % 64 != 0 && end != len)
+      return;
+    size_t first = (end - 1) / 64 * 64;
+    size_t num_bits = end - first;
+    for (size_t j = 0; j < num_bits / 8; ++j)
+      dest[first / 8 + j] = static_cast<FfUtils::u8>(word >> (8 * j));
+    if (num_bits % 8 != 0) {
+      auto keep = static_cast<FfUtils::u8>((1u << (num_bits % 8)) - 1);
+      FfUtils::u8& last = dest[first / 8 + num_bits / 8];
+      last = static_cast<FfUtils::u8>((last & ~keep) | ((word >> (num_bits / 8 * 8)) & keep));
+    }
+    word = 0;
+  };
+}
+
+// Returns a function that writes the result mask of the chunk at element "ind" as all-ones or all-zeros lanes.
+template <typename FT>
+auto VMaskLanesWriter(typename FfUtils::FloatToUint<FT>::type* dest, size_t len) {
+  return [dest, len](size_t ind, fmask<FT> m) {
+    using UT = typename FfUtils::FloatToUint<FT>::type;
+    fvec<FT> sel(0);
+    stdx::where(m, sel) = stdx::__proposed::simd_bit_cast<fvec<FT>>(fbits<FT>(nl<UT>::max()));
+    auto res = stdx::__proposed::simd_bit_cast<fbits<FT>>(sel);
+    if (ind + fvec<FT>::size() <= len) [[likely]] {
+      res.copy_to(&dest[ind], stdx::element_aligned);
+    } else {
+      for (size_t i = 0; i < len - ind; ++i)
+        dest[ind + i] = res[i];
+    }
+  };
+}
+
+template <typename FT, SimdFloat::CompareOp op, typename EMIT>
+void SimdFloat::VCompare(FT* pa, FT* pb, FT b, size_t len, bool signaling, EMIT emit) {
+  auto compare = [this, signaling](fvec<FT> a, fvec<FT> b) {
+    auto unordered = stdx::isunordered(a, b);
+    if (stdx::any_of(unordered)) [[unlikely]] {
+      if (signaling || stdx::any_of(VIsSnan<FT>(a) || VIsSnan<FT>(b)))
+        SetInvalid();
+    }
+
+    if constexpr (op == kCmpEq)
+      return a == b;
+    else if constexpr (op == kCmpNe)
+      return a != b;
+    else if constexpr (op == kCmpLt)
+      return a < b;
+    else if constexpr (op == kCmpLe)
+      return a <= b;
+    else if constexpr (op == kCmpGt)
+      return a > b;
+    else if constexpr (op == kCmpGe)
+      return a >= b;
+    else if constexpr (op == kCmpOrd)
+      return !unordered;
+    else if constexpr (op == kCmpUnord)
+      return unordered;
+    else
+      static_assert(false, "Using unsupported compare operation");
+  };
+
+  size_t ind = 0;
+  while ((ind + fvec<FT>::size()) <= len) {
+    fvec<FT> va, vb(b);
+    va.copy_from(&pa[ind], stdx::element_aligned);
+    if (pb != nullptr)
+      vb.copy_from(&pb[ind], stdx::element_aligned);
+    emit(ind, compare(va, vb));
+    ind += fvec<FT>::size();
+  }
+
+  // The lanes at positions "len" and above compare zeros (or "b"), which raises no additional flags, and are cleared.
+  if (ind < len) {
+    auto body = VBodyLanes<FT>(ind, 0, len);
+    fvec<FT> va(0), vb(b);
+    stdx::where(body, va).copy_from(&pa[ind], stdx::element_aligned);
+    if (pb != nullptr) {
+      vb = 0;
+      stdx::where(body, vb).copy_from(&pb[ind], stdx::element_aligned);
+    }
+    emit(ind, compare(va, vb) && body);
+  }
+}
+
+template <typename FT, typename EMIT>
+void SimdFloat::VCompare(FT* pa, FT* pb, FT b, size_t len, CompareOp op, bool signaling, EMIT emit) {
+  switch (op) {
+  case kCmpEq:
+    return VCompare<FT, kCmpEq>(pa, pb, b, len, signaling, emit);
+  case kCmpNe:
+    return VCompare<FT, kCmpNe>(pa, pb, b, len, signaling, emit);
+  case kCmpLt:
+    return VCompare<FT, kCmpLt>(pa, pb, b, len, signaling, emit);
+  case kCmpLe:
+    return VCompare<FT, kCmpLe>(pa, pb, b, len, signaling, emit);
+  case kCmpGt:
+    return VCompare<FT, kCmpGt>(pa, pb, b, len, signaling, emit);
+  case kCmpGe:
+    return VCompare<FT, kCmpGe>(pa, pb, b, len, signaling, emit);
+  case kCmpOrd:
+    return VCompare<FT, kCmpOrd>(pa, pb, b, len, signaling, emit);
+  case kCmpUnord:
+    return VCompare<FT, kCmpUnord>(pa, pb, b, len, signaling, emit);
+  default:
+    throw std::runtime_error(std::string("Unknown compare operation"));
+  }
+}
+
+template void SimdFloat::VCompareMask<f32>(f32* pa, f32* pb, FfUtils::u8* dest, size_t len, CompareOp op, bool signaling);
+template void SimdFloat::VCompareMask<f64>(f64* pa, f64* pb, FfUtils::u8* dest, size_t len, CompareOp op, bool signaling);
+template void SimdFloat::VCompareMask<f32>(f32* pa, f32 b, FfUtils::u8* dest, size_t len, CompareOp op, bool signaling);
+template void SimdFloat::VCompareMask<f64>(f64* pa, f64 b, FfUtils::u8* dest, size_t len, CompareOp op, bool signaling);
+
+template <typename FT>
+void SimdFloat::VCompareMask(FT* pa, FT* pb, FfUtils::u8* dest, size_t len, CompareOp op, bool signaling) {
+  VCompare(pa, pb, static_cast<FT>(0.), len, op, signaling, VMaskBitsWriter<FT>(dest, len));
+}
+
+template <typename FT>
+void SimdFloat::VCompareMask(FT* pa, FT b, FfUtils::u8* dest, size_t len, CompareOp op, bool signaling) {
+  VCompare<FT>(pa, nullptr, b, len, op, signaling, VMaskBitsWriter<FT>(dest, len));
+}
+
+template void SimdFloat::VCompareLanes<f32>(f32* pa, f32* pb, FfUtils::u32* dest, size_t len, CompareOp op,
+                                            bool signaling);
+template void SimdFloat::VCompareLanes<f64>(f64* pa, f64* pb, FfUtils::u64* dest, size_t len, CompareOp op,
+                                            bool signaling);
+template void SimdFloat::VCompareLanes<f32>(f32* pa, f32 b, FfUtils::u32* dest, size_t len, CompareOp op,
+                                            bool signaling);
+template void SimdFloat::VCompareLanes<f64>(f64* pa, f64 b, FfUtils::u64* dest, size_t len, CompareOp op,
+                                            bool signaling);
+
+template <typename FT>
+void SimdFloat::VCompareLanes(FT* pa, FT* pb, typename FfUtils::FloatToUint<FT>::type* dest, size_t len, CompareOp op,
+                              bool signaling) {
+  VCompare(pa, pb, static_cast<FT>(0.), len, op, signaling, VMaskLanesWriter<FT>(dest, len));
+}
+
+template <typename FT>
+void SimdFloat::VCompareLanes(FT* pa, FT b, typename FfUtils::FloatToUint<FT>::type* dest, size_t len, CompareOp op,
+                              bool signaling) {
+  VCompare<FT>(pa, nullptr, b, len, op, signaling, VMaskLanesWriter<FT>(dest, len));
+}
+
+// Rounds in the floating-point domain and checks the range of the rounded value, which is an integer and thus compares
+// exactly against the powers of two bounding IT. The in-range lanes are then converted exactly by the host, and the
+// others take the limits of the profile. A partial last chunk is padded with zeros, which convert without flags.
+template <typename FT, typename IT, FloppyFloat::RoundingMode rm>
+void SimdFloat::VFToI(FT* pa, IT* dest, size_t len) {
+  using ivec = stdx::rebind_simd_t<IT, fvec<FT>>;
+  using imask = typename ivec::mask_type;
+  constexpr FT kLower = static_cast<FT>(nl<IT>::min());
+  constexpr FT kUpper = 2 * static_cast<FT>(static_cast<IT>(1) << (nl<IT>::digits - 1));
+  const auto [nan_limit, max_limit, min_limit] = [this] {
+    if constexpr (std::is_same_v<IT, FfUtils::i32>)
+      return std::array{nan_limit_i32_, max_limit_i32_, min_limit_i32_};
+    else if constexpr (std::is_same_v<IT, FfUtils::u32>)
+      return std::array{nan_limit_u32_, max_limit_u32_, min_limit_u32_};
+    else if constexpr (std::is_same_v<IT, FfUtils::i64>)
+      return std::array{nan_limit_i64_, max_limit_i64_, min_limit_i64_};
+    else
+      return std::array{nan_limit_u64_, max_limit_u64_, min_limit_u64_};
+  }();
+
+  auto convert = [&](fvec<FT> a) {
+    fvec<FT> rounded;
+    if constexpr (rm == kRoundTiesToEven)
+      rounded = stdx::nearbyint(a);
+    else if constexpr (rm == kRoundTiesToAway)
+      rounded = stdx::round(a);
+    else if constexpr (rm == kRoundTowardPositive)
+      rounded = stdx::ceil(a);
+    else if constexpr (rm == kRoundTowardNegative)
+      rounded = stdx::floor(a);
+    else
+      rounded = stdx::trunc(a);
+
+    auto in_range = rounded >= kLower && rounded < kUpper;  // False for NaN.
+    if (stdx::any_of(in_range && rounded != a))
+      SetInexact();
+    if (stdx::all_of(in_range)) [[likely]]
+      return stdx::static_simd_cast<ivec>(rounded);
+
+    SetInvalid();
+    auto over = stdx::__proposed::static_simd_cast<imask>(rounded >= kUpper);
+    auto under = stdx::__proposed::static_simd_cast<imask>(rounded < kLower);
+    auto nan = stdx::__proposed::static_simd_cast<imask>(VIsNan(a));
+    stdx::where(!in_range, rounded) = 0;
+    auto res = stdx::static_simd_cast<ivec>(rounded);
+    stdx::where(over, res) = max_limit;
+    stdx::where(under, res) = min_limit;
+    stdx::where(nan, res) = nan_limit;
+    return res;
+  };
+
+  size_t ind = 0;
+  while ((ind + fvec<FT>::size()) <= len) {
+    fvec<FT> a;
+    a.copy_from(&pa[ind], stdx::element_aligned);
+    convert(a).copy_to(&dest[ind], stdx::element_aligned);
+    ind += fvec<FT>::size();
+  }
+
+  if (ind < len) {
+    fvec<FT> a(0);
+    stdx::where(VBodyLanes<FT>(ind, 0, len), a).copy_from(&pa[ind], stdx::element_aligned);
+    auto res = convert(a);
+    for (size_t i = 0; i < len - ind; ++i)
+      dest[ind + i] = res[i];
+  }
+}
+
+template <typename FT, typename IT>
+void SimdFloat::VFToI(FT* pa, IT* dest, size_t len) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return VFToI<FT, IT, kRoundTiesToEven>(pa, dest, len);
+  case kRoundTiesToAway:
+    return VFToI<FT, IT, kRoundTiesToAway>(pa, dest, len);
+  case kRoundTowardPositive:
+    return VFToI<FT, IT, kRoundTowardPositive>(pa, dest, len);
+  case kRoundTowardNegative:
+    return VFToI<FT, IT, kRoundTowardNegative>(pa, dest, len);
+  case kRoundTowardZero:
+    return VFToI<FT, IT, kRoundTowardZero>(pa, dest, len);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+void SimdFloat::VF32ToI32(f32* pa, FfUtils::i32* dest, size_t len) {
+  VFToI(pa, dest, len);
+}
+
+void SimdFloat::VF32ToU32(f32* pa, FfUtils::u32* dest, size_t len) {
+  VFToI(pa, dest, len);
+}
+
+void SimdFloat::VF64ToI32(f64* pa, FfUtils::i32* dest, size_t len) {
+  VFToI(pa, dest, len);
+}
+
+void SimdFloat::VF64ToU32(f64* pa, FfUtils::u32* dest, size_t len) {
+  VFToI(pa, dest, len);
+}
+
+void SimdFloat::VF64ToI64(f64* pa, FfUtils::i64* dest, size_t len) {
+  VFToI(pa, dest, len);
+}
+
+void SimdFloat::VF64ToU64(f64* pa, FfUtils::u64* dest, size_t len) {
+  VFToI(pa, dest, len);
+}
+
+// Splits the integers into halves of 16 bits, which convert exactly, so that their sum is the only rounding step. As
+// the high half is zero or larger in magnitude than the low half, the Fast2Sum residual is (c - hi) - lo.
+template <typename IT, FloppyFloat::RoundingMode rm>
+void SimdFloat::VIToF32(IT* pa, f32* dest, size_t len) {
+  using ivec = stdx::rebind_simd_t<IT, fvec<f32>>;
+  using svec = stdx::rebind_simd_t<FfUtils::i32, fvec<f32>>;
+  auto convert = [&](ivec x) {
+    auto hi = stdx::static_simd_cast<fvec<f32>>(stdx::static_simd_cast<svec>(x >> 16)) * 65536.f;
+    auto lo = stdx::static_simd_cast<fvec<f32>>(stdx::static_simd_cast<svec>(x & 0xffff));
+    fvec<f32> c = hi + lo;
+    fvec<f32> r = (c - hi) - lo;
+    if constexpr (rm == kRoundTiesToEven) {
+      if (stdx::any_of(r != 0))
+        SetInexact();
+    } else {
+      VRoundResult<rm>(c, r, fmask<f32>(false), fmask<f32>(true));
+    }
+    return c;
+  };
+
+  size_t ind = 0;
+  while ((ind + fvec<f32>::size()) <= len) {
+    ivec x;
+    x.copy_from(&pa[ind], stdx::element_aligned);
+    convert(x).copy_to(&dest[ind], stdx::element_aligned);
+    ind += fvec<f32>::size();
+  }
+
+  if (ind < len) {
+    ivec x([&](auto i) { return ind + i < len ? pa[ind + i] : static_cast<IT>(0); });
+    auto res = convert(x);
+    for (size_t i = 0; i < len - ind; ++i)
+      dest[ind + i] = res[i];
+  }
+}
+
+template <typename IT>
+void SimdFloat::VIToF32(IT* pa, f32* dest, size_t len) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return VIToF32<IT, kRoundTiesToEven>(pa, dest, len);
+  case kRoundTiesToAway:
+    return VIToF32<IT, kRoundTiesToAway>(pa, dest, len);
+  case kRoundTowardPositive:
+    return VIToF32<IT, kRoundTowardPositive>(pa, dest, len);
+  case kRoundTowardNegative:
+    return VIToF32<IT, kRoundTowardNegative>(pa, dest, len);
+  case kRoundTowardZero:
+    return VIToF32<IT, kRoundTowardZero>(pa, dest, len);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+void SimdFloat::VI32ToF32(FfUtils::i32* pa, f32* dest, size_t len) {
+  VIToF32(pa, dest, len);
+}
+
+void SimdFloat::VU32ToF32(FfUtils::u32* pa, f32* dest, size_t len) {
+  VIToF32(pa, dest, len);
+}
+
+template f32 SimdFloat::VReduceSum<f32>(f32* pa, size_t len, f32 init, ReduceShape shape);
+template f64 SimdFloat::VReduceSum<f64>(f64* pa, size_t len, f64 init, ReduceShape shape);
+
+template <typename FT>
+FT SimdFloat::VReduceSum(FT* pa, size_t len, FT init, ReduceShape shape) {
+  switch (shape) {
+  case kReduceOrdered:
+    return VReduceOrderedSum<FT>(pa, len, init);
+  case kReducePairwise:
+  case kReduceHalving:
+    return len ? FloppyFloat::Add<FT>(init, VReduceTreeSum<FT>(pa, len, shape)) : init;
+  default:
+    throw std::runtime_error(std::string("Unknown reduction shape"));
+  }
+}
+
+// The sequential chain is evaluated with the host's round to nearest even, which is only bound by the latency of one
+// addition per element. The partial sums of a block are kept, so that the residuals of all its steps can be checked for
+// inexactness and overflow in parallel afterwards. Blocks that end in a NaN are repeated with the scalar version for the
+// NaN handling of the profile. Other rounding modes depend on the rounded partial sum and use the scalar version.
+template <typename FT>
+FT SimdFloat::VReduceOrderedSum(FT* pa, size_t len, FT init) {
+  if (rounding_mode != kRoundTiesToEven) [[unlikely]] {
+    for (size_t i = 0; i < len; ++i)
+      init = FloppyFloat::Add<FT>(init, pa[i]);
+    return init;
+  }
+
+  constexpr size_t kN = fvec<FT>::size();
+  constexpr size_t kBlock = 32 * kN;
+  std::array<FT, kBlock + 1> sums;  // sums[i] is the partial sum before element i of the block.
+  FT acc = init;
+  for (size_t block = 0; block < len; block += kBlock) {
+    const size_t n = std::min(kBlock, len - block);
+    sums[0] = acc;
+    for (size_t i = 0; i < n; ++i) {
+      acc += pa[block + i];
+      sums[i + 1] = acc;
+    }
+
+    if (FfUtils::IsNan(acc)) [[unlikely]] {
+      acc = sums[0];
+      for (size_t i = 0; i < n; ++i)
+        acc = FloppyFloat::Add<FT, kRoundTiesToEven>(acc, pa[block + i]);
+      continue;
+    }
+
+    // Without NaNs, an infinite partial sum stays infinite, so only blocks that start finite can overflow.
+    bool check_overflow = FfUtils::IsInf(acc) && !FfUtils::IsInf(sums[0]);
+    for (size_t i = 0; i < n && (check_overflow || !inexact); i += kN) {
+      fvec<FT> a(0), b(0), c(0);
+      if (i + kN <= n) [[likely]] {
+        a.copy_from(&sums[i], stdx::element_aligned);
+        b.copy_from(&pa[block + i], stdx::element_aligned);
+        c.copy_from(&sums[i + 1], stdx::element_aligned);
+      } else {
+        auto body = VBodyLanes<FT>(i, 0, n);
+        stdx::where(body, a).copy_from(&sums[i], stdx::element_aligned);
+        stdx::where(body, b).copy_from(&pa[block + i], stdx::element_aligned);
+        stdx::where(body, c).copy_from(&sums[i + 1], stdx::element_aligned);
+      }
+      if (check_overflow && stdx::any_of(VIsInf(c) && !VIsInf(a) && !VIsInf(b))) {
         SetOverflow();
         SetInexact();
+        check_overflow = false;
       }
-      if (stdx::any_of(VIsSnan(a) || VIsSnan(b) || VIsSnan(c)))
-        SetInvalid();
-      if (stdx::any_of((VIsNan(d) && !VIsNan(a)) && !VIsNan(b) && !VIsNan(c)))
+      if (!inexact && stdx::any_of(VIsNonZero(VFastTwoSum<fvec<FT>>(a, b, c))))
+        SetInexact();
+    }
+  }
+  return acc;
+}
+
+// Evaluates the tree level by level, so that each level is a single batch addition of up to len / 2 elements. The
+// pairwise shape first separates the even and odd elements of a level. Levels after the first one are kept in "buf",
+// which the halving shape can update in place, as the upper half is never written.
+template <typename FT>
+FT SimdFloat::VReduceTreeSum(FT* pa, size_t len, ReduceShape shape) {
+  constexpr size_t kStackLen = 256;
+  std::array<FT, kStackLen / 2 * 3 + 1> stack_buf;
+  std::vector<FT> heap_buf;
+  FT* buf = stack_buf.data();
+  if (len > kStackLen) [[unlikely]] {
+    heap_buf.resize(len / 2 * 3 + 1);
+    buf = heap_buf.data();
+  }
+  FT* even = buf + (len + 1) / 2;
+  FT* odd = even + len / 2;
+
+  FT* src = pa;
+  for (size_t n = len; n > 1; n = (n + 1) / 2) {
+    const size_t half = (n + 1) / 2;
+    if (shape == kReduceHalving) {
+      VAdd<FT>(src, src + half, buf, n - half);
+      if (n % 2)
+        buf[half - 1] = src[half - 1];
+    } else {
+      for (size_t i = 0; i < n / 2; ++i) {
+        even[i] = src[2 * i];
+        odd[i] = src[2 * i + 1];
+      }
+      VAdd<FT>(even, odd, buf, n / 2);
+      if (n % 2)
+        buf[half - 1] = src[n - 1];
+    }
+    src = buf;
+  }
+  return src[0];
+}
+
+template f32 SimdFloat::VReduceMaxNumber<f32>(f32* pa, size_t len, f32 init);
+template f64 SimdFloat::VReduceMaxNumber<f64>(f64* pa, size_t len, f64 init);
+
+template <typename FT>
+FT SimdFloat::VReduceMaxNumber(FT* pa, size_t len, FT init) {
+  return VReduceMinMaxNumber<FT, true>(pa, len, init);
+}
+
+template f32 SimdFloat::VReduceMinNumber<f32>(f32* pa, size_t len, f32 init);
+template f64 SimdFloat::VReduceMinNumber<f64>(f64* pa, size_t len, f64 init);
+
+template <typename FT>
+FT SimdFloat::VReduceMinNumber(FT* pa, size_t len, FT init) {
+  return VReduceMinMaxNumber<FT, false>(pa, len, init);
+}
+
+// NaN lanes are replaced by the identity (-infinity for the maximum) after raising invalid for signaling NaNs. Equal
+// lanes are merged bitwise, so that +0 wins the maximum (AND) and -0 wins the minimum (OR), which is cheaper than
+// comparing total order keys. The lanes of the accumulator are combined with the scalar version, which also returns the
+// NaN of the profile if all elements are NaNs.
+template <typename FT, bool max>
+FT SimdFloat::VReduceMinMaxNumber(FT* pa, size_t len, FT init) {
+  auto scalar = [this](FT a, FT b) {
+    return max ? FloppyFloat::MaximumNumber<FT>(a, b) : FloppyFloat::MinimumNumber<FT>(a, b);
+  };
+  const FT identity = max ? -nl<FT>::infinity() : nl<FT>::infinity();
+
+  auto merge = [](fvec<FT>& acc, fvec<FT> a) {
+    auto ba = stdx::__proposed::simd_bit_cast<fbits<FT>>(a);
+    auto bacc = stdx::__proposed::simd_bit_cast<fbits<FT>>(acc);
+    auto merged = stdx::__proposed::simd_bit_cast<fvec<FT>>(max ? (ba & bacc) : (ba | bacc));
+    stdx::where(a == acc, acc) = merged;
+    stdx::where(max ? a > acc : a < acc, acc) = a;
+  };
+  bool all_nan = true;
+  auto step = [&](fvec<FT>& acc, size_t ind) {
+    fvec<FT> a;
+    a.copy_from(&pa[ind], stdx::element_aligned);
+    auto nan = VIsNan(a);
+    if (stdx::any_of(nan)) [[unlikely]] {
+      if (stdx::any_of(VIsSnan(a)))
         SetInvalid();
-      stdx::where(d != d, d) = VGetQnan<FT>();
+      if (stdx::all_of(nan))
+        return;
+      stdx::where(nan, a) = identity;
     }
+    all_nan = false;
+    merge(acc, a);
+  };
+
+  // Independent accumulators hide the latency of the compare and select chain.
+  constexpr size_t kN = fvec<FT>::size();
+  constexpr size_t kAccs = 4;
+  std::array<fvec<FT>, kAccs> acc;
+  acc.fill(fvec<FT>(identity));
+  size_t ind = 0;
+  for (; (ind + kAccs * kN) <= len; ind += kAccs * kN) {
+    for (size_t k = 0; k < kAccs; ++k)
+      step(acc[k], ind + k * kN);
+  }
+  for (; (ind + kN) <= len; ind += kN)
+    step(acc[0], ind);
+
+  FT res = init;
+  if (ind > 0) {
+    if (all_nan) {
+      res = scalar(res, pa[0]);
+    } else {
+      for (size_t k = 1; k < kAccs; ++k)
+        merge(acc[0], acc[k]);
+      for (size_t i = 0; i < kN; ++i)
+        res = scalar(res, acc[0][i]);
+    }
+  }
+  for (; ind < len; ++ind)
+    res = scalar(res, pa[ind]);
+  return res;
+}
 
-    if (!inexact) [[unlikely]] {
-      for (size_t i = 0; i < fvec<FT>::size(); ++i)
-        FloppyFloat::Fma(pa[ind + i], pb[ind + i], pc[ind + i]);
+// Rounds to nearest even on the integer representation. Chunks that contain NaNs, infinities,
+// subnormals, or overflow use the scalar version, since these need extra flags or NaN handling.
+void SimdFloat::VF32ToBF16(f32* pa, FfUtils::bf16* dest, size_t len) {
+  using uvec = stdx::rebind_simd_t<FfUtils::u32, fvec<f32>>;
+  if (rounding_mode != kRoundTiesToEven) [[unlikely]] {
+    for (size_t i = 0; i < len; ++i)
+      dest[i] = FloppyFloat::F32ToBF16(pa[i]);
+    return;
+  }
+
+  size_t ind = 0;
+  while ((ind + fvec<f32>::size()) <= len) {
+    fvec<f32> a;
+    a.copy_from(&pa[ind], stdx::element_aligned);
+    uvec ua = stdx::__proposed::simd_bit_cast<uvec>(a);
+    uvec mag = ua & 0x7fffffffu;
+    uvec rounded = mag + 0x7fffu + ((mag >> 16) & 1u);
+
+    if (stdx::any_of((mag != 0u && mag < 0x00800000u) || rounded >= 0x7f800000u)) [[unlikely]] {
+      for (size_t i = 0; i < fvec<f32>::size(); ++i)
+        dest[ind + i] = FloppyFloat::F32ToBF16<kRoundTiesToEven>(pa[ind + i]);
+    } else {
+      if (stdx::any_of((mag & 0xffffu) != 0u))
+        SetInexact();
+      uvec res = ((ua & 0x80000000u) | rounded) >> 16;
+      for (size_t i = 0; i < fvec<f32>::size(); ++i)
+        dest[ind + i] = std::bit_cast<FfUtils::bf16>(static_cast<FfUtils::u16>(res[i]));
     }
-    if (!underflow) {
-      auto is_small = d < VGetMin<FT>() && d > -VGetMin<FT>();
-      if (stdx::any_of(is_small)) {
-        for (size_t i = 0; i < fvec<FT>::size(); ++i)
-          FloppyFloat::Fma(pa[ind + i], pb[ind + i], pc[ind + i]);
+    ind += fvec<f32>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::F32ToBF16<kRoundTiesToEven>(pa[ind]);
+}
+
+// Widening is exact, only chunks with NaNs need the scalar version.
+void SimdFloat::VBF16ToF32(FfUtils::bf16* pa, f32* dest, size_t len) {
+  using uvec = stdx::rebind_simd_t<FfUtils::u32, fvec<f32>>;
+  size_t ind = 0;
+  while ((ind + fvec<f32>::size()) <= len) {
+    uvec ua([&](auto i) { return static_cast<FfUtils::u32>(std::bit_cast<FfUtils::u16>(pa[ind + i])) << 16; });
+
+    if (stdx::any_of((ua & 0x7fffffffu) > 0x7f800000u)) [[unlikely]] {
+      for (size_t i = 0; i < fvec<f32>::size(); ++i)
+        dest[ind + i] = FloppyFloat::BF16ToF32(pa[ind + i]);
+    } else {
+      stdx::__proposed::simd_bit_cast<fvec<f32>>(ua).copy_to(&dest[ind], stdx::element_aligned);
+    }
+    ind += fvec<f32>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::BF16ToF32(pa[ind]);
+}
+
+template void SimdFloat::VF32ToFp8<FfUtils::fp8e4m3, true>(f32* pa, FfUtils::fp8e4m3* dest, size_t len);
+template void SimdFloat::VF32ToFp8<FfUtils::fp8e4m3, false>(f32* pa, FfUtils::fp8e4m3* dest, size_t len);
+template void SimdFloat::VF32ToFp8<FfUtils::fp8e5m2, true>(f32* pa, FfUtils::fp8e5m2* dest, size_t len);
+template void SimdFloat::VF32ToFp8<FfUtils::fp8e5m2, false>(f32* pa, FfUtils::fp8e5m2* dest, size_t len);
+
+template <typename FP8, bool saturate>
+void SimdFloat::VF32ToFp8(f32* pa, FP8* dest, size_t len) {
+  VRoundToMiniFloat<FP8, saturate, false>(pa, nullptr, dest, len);
+}
+
+template void SimdFloat::VF32ToFp8Stochastic<FfUtils::fp8e4m3, true>(f32* pa, FfUtils::u32* random, FfUtils::fp8e4m3* dest,
+                                                                  size_t len);
+template void SimdFloat::VF32ToFp8Stochastic<FfUtils::fp8e4m3, false>(f32* pa, FfUtils::u32* random, FfUtils::fp8e4m3* dest,
+                                                                  size_t len);
+template void SimdFloat::VF32ToFp8Stochastic<FfUtils::fp8e5m2, true>(f32* pa, FfUtils::u32* random, FfUtils::fp8e5m2* dest,
+                                                                  size_t len);
+template void SimdFloat::VF32ToFp8Stochastic<FfUtils::fp8e5m2, false>(f32* pa, FfUtils::u32* random, FfUtils::fp8e5m2* dest,
+                                                                  size_t len);
+
+template <typename FP8, bool saturate>
+void SimdFloat::VF32ToFp8Stochastic(f32* pa, FfUtils::u32* random, FP8* dest, size_t len) {
+  VRoundToMiniFloat<FP8, saturate, true>(pa, random, dest, len);
+}
+
+// The MX block conversions use the saturating variants.
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp8e4m3, true, false>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp8e4m3* dest, size_t len);
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp8e4m3, true, true>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp8e4m3* dest, size_t len);
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp8e5m2, true, false>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp8e5m2* dest, size_t len);
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp8e5m2, true, true>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp8e5m2* dest, size_t len);
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp6e3m2, true, false>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp6e3m2* dest, size_t len);
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp6e3m2, true, true>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp6e3m2* dest, size_t len);
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp6e2m3, true, false>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp6e2m3* dest, size_t len);
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp6e2m3, true, true>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp6e2m3* dest, size_t len);
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp4e2m1, true, false>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp4e2m1* dest, size_t len);
+template void SimdFloat::VRoundToMiniFloat<FfUtils::fp4e2m1, true, true>(f32* pa, FfUtils::u32* random,
+                                                                     FfUtils::fp4e2m1* dest, size_t len);
+
+// Same integer rounding as FloppyFloat::RoundToMiniFloat on all lanes at once. Chunks that contain NaNs,
+// infinities, or need the after-rounding tininess check at the smallest normal use the scalar version.
+template <typename MT, bool saturate, bool stochastic>
+void SimdFloat::VRoundToMiniFloat(f32* pa, FfUtils::u32* random, MT* dest, size_t len) {
+  using uvec = stdx::rebind_simd_t<FfUtils::u32, fvec<f32>>;
+  constexpr int kSigBits = FfUtils::MiniFloatFormat<MT>::kSigBits;
+  constexpr FfUtils::u32 kMinNormalExp = 127 + 1 - FfUtils::MiniFloatFormat<MT>::kBias;
+  // FP8 formats go through the full conversion for NaNs, the MX element formats only see finite values.
+  auto round_scalar = [this](f32 a, FfUtils::u32 r) {
+    if constexpr (FfUtils::MiniFloatFormat<MT>::kNumBits != 8)
+      return MT{FloppyFloat::RoundToMiniFloat<MT, saturate, stochastic>(a, r)};
+    else if constexpr (stochastic)
+      return FloppyFloat::FToFp8Stochastic<MT, saturate, f32>(a, r);
+    else
+      return FloppyFloat::FToFp8<MT, saturate, f32>(a);
+  };
+
+  size_t ind = 0;
+  while ((ind + fvec<f32>::size()) <= len) {
+    fvec<f32> a;
+    a.copy_from(&pa[ind], stdx::element_aligned);
+    uvec ua = stdx::__proposed::simd_bit_cast<uvec>(a);
+    uvec exp = (ua & 0x7fffffffu) >> 23;
+    uvec sig = ua & 0x7fffffu;
+    stdx::where(exp != 0u, sig) |= 0x800000u;
+    uvec shift = 23 - kSigBits;
+    stdx::where(exp < kMinNormalExp, shift) = shift + (kMinNormalExp - exp);
+    uvec kept_shift = stdx::min(shift, uvec(31u));
+    uvec kept = sig >> kept_shift;
+    uvec rem = sig & ((uvec(1u) << kept_shift) - 1u);
+
+    if constexpr (stochastic) {
+      uvec r;
+      r.copy_from(&random[ind], stdx::element_aligned);
+      uvec right = 0u;
+      stdx::where(shift > 32u, right) = stdx::min(shift - 32u, uvec(31u));
+      uvec scaled = (rem << (32u - stdx::min(shift, uvec(32u)))) >> right;
+      stdx::where((scaled + r) < scaled, kept) += 1u;
+    } else {
+      uvec half = uvec(1u) << (kept_shift - 1u);
+      stdx::where(rem > half || (rem == half && (kept & 1u) != 0u), kept) += 1u;
+    }
+
+    uvec code = kept;
+    stdx::where(exp > kMinNormalExp, code) = ((exp - kMinNormalExp) << kSigBits) + kept;
+    auto tiny = (rem != 0u) && (exp < kMinNormalExp);
+
+    bool boundary = false;
+    if constexpr (!stochastic)
+      boundary = !tininess_before_rounding && stdx::any_of(tiny && code == (1u << kSigBits));
+
+    if (stdx::any_of(exp == 0xffu) || boundary) [[unlikely]] {
+      for (size_t i = 0; i < fvec<f32>::size(); ++i)
+        dest[ind + i] = round_scalar(pa[ind + i], stochastic ? random[ind + i] : 0u);
+    } else {
+      if (stdx::any_of(rem != 0u))
+        SetInexact();
+      if (stdx::any_of(tiny))
+        SetUnderflow();
+      auto overflows = code > FfUtils::MiniFloatFormat<MT>::kMaxCode;
+      if (stdx::any_of(overflows)) [[unlikely]] {
+        SetOverflow();
+        SetInexact();
+        stdx::where(overflows, code) =
+            uvec(saturate ? FfUtils::MiniFloatFormat<MT>::kMaxCode : FfUtils::MiniFloatFormat<MT>::kOverflowCode);
       }
+      code |= (ua >> 31) << (FfUtils::MiniFloatFormat<MT>::kNumBits - 1);
+      for (size_t i = 0; i < fvec<f32>::size(); ++i)
+        dest[ind + i] = MT{static_cast<FfUtils::u8>(code[i])};
     }
-    d.copy_to(&dest[ind], stdx::element_aligned);
-    ind += fvec<FT>::size();
+    ind += fvec<f32>::size();
   }
 
   for (; ind < len; ++ind)
-    dest[ind] = FloppyFloat::Fma(pa[ind], pb[ind], pc[ind]);
+    dest[ind] = round_scalar(pa[ind], stochastic ? random[ind] : 0u);
 }
 
-void SimdFloat::SetupToRiscv() {
-  FloppyFloat::SetupToRiscv();
-  SimdFloat::SetQnan<f32>(std::bit_cast<FfUtils::u32>(qnan32_));
-  SimdFloat::SetQnan<f64>(std::bit_cast<FfUtils::u64>(qnan64_));
+template void SimdFloat::VFp8ToF32<FfUtils::fp8e4m3>(FfUtils::fp8e4m3* pa, f32* dest, size_t len);
+template void SimdFloat::VFp8ToF32<FfUtils::fp8e5m2>(FfUtils::fp8e5m2* pa, f32* dest, size_t len);
+
+// Per-lane lookup in the 256-entry decode table.
+template <typename FP8>
+void SimdFloat::VFp8ToF32(FP8* pa, f32* dest, size_t len) {
+  const auto& table = FfUtils::MiniFloatDecodeTable<FP8>();
+  size_t ind = 0;
+  while ((ind + fvec<f32>::size()) <= len) {
+    fvec<f32> r([&](auto i) { return table[pa[ind + i].v]; });
+    if constexpr (std::is_same_v<FP8, FfUtils::fp8e5m2>) {
+      if (stdx::any_of(VIsNan(r))) [[unlikely]] {
+        for (size_t i = 0; i < fvec<f32>::size(); ++i)
+          if ((pa[ind + i].v & 0x7f) == 0x7d)
+            SetInvalid();
+      }
+    }
+    r.copy_to(&dest[ind], stdx::element_aligned);
+    ind += fvec<f32>::size();
+  }
+
+  for (; ind < len; ++ind)
+    dest[ind] = FloppyFloat::Fp8ToF32<FP8>(pa[ind]);
 }
@@ -4,6 +4,8 @@
  * Copyright (c) 2024 chciken/Niko Zurstraßen
  **************************************************************************************************/
 
+#include <array>
+
 #include "floppy_float.h"
 #include "utils.h"
 
@@ -11,9 +13,6 @@ class SimdFloat : public FloppyFloat {
  public:
   SimdFloat();
 
-  template <typename FT>
-  void SetQnan(typename FfUtils::FloatToUint<FT>::type val);
-
   template <typename FT>
   void VAdd(FT* pa, FT* pb, FT* dest, size_t len);
 
@@ -32,9 +31,178 @@ class SimdFloat : public FloppyFloat {
   template <typename FT>
   void VFma(FT* pa, FT* pb, FT* pc, FT* dest, size_t len);
 
-  void SetupToRiscv();
+  template <typename FTIN, typename FTACC>
+  void VFmaWiden(FTIN* pa, FTIN* pb, FTACC* pc, FTACC* dest, size_t len);
+
+  // Tail and mask policies of RVV (see "vta" and "vma" in "vtype"). Agnostic elements are set to all ones.
+  enum RvvPolicy : FfUtils::u8 { kRvvTailAgnostic = 1 << 0, kRvvMaskAgnostic = 1 << 1 };
+
+  // RVV-style masked versions: Element i is active if vstart <= i < vl and bit i of "mask" (v0) is set, or if "mask" is
+  // null. Only active elements raise exception flags. Elements below vstart are never written, inactive body elements
+  // and the tail elements up to vlmax are written according to "policy".
+  template <typename FT>
+  void VAddMasked(FT* pa, FT* pb, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                  FfUtils::u8 policy);
+
+  template <typename FT>
+  void VSubMasked(FT* pa, FT* pb, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                  FfUtils::u8 policy);
+
+  template <typename FT>
+  void VMulMasked(FT* pa, FT* pb, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                  FfUtils::u8 policy);
+
+  template <typename FT>
+  void VDivMasked(FT* pa, FT* pb, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                  FfUtils::u8 policy);
+
+  template <typename FT>
+  void VSqrtMasked(FT* pa, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                   FfUtils::u8 policy);
+
+  template <typename FT>
+  void VFmaMasked(FT* pa, FT* pb, FT* pc, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+                  FfUtils::u8 policy);
+
+  template <typename FT>
+  void VMaximum(FT* pa, FT* pb, FT* dest, size_t len);
+
+  template <typename FT>
+  void VMinimum(FT* pa, FT* pb, FT* dest, size_t len);
+
+  template <typename FT>
+  void VRecipEstimateRiscv(FT* pa, FT* dest, size_t len);
+
+  template <typename FT>
+  void VRsqrtEstimateRiscv(FT* pa, FT* dest, size_t len);
+
+  template <typename FT>
+  void VClass(FT* pa, FfUtils::u32* dest, size_t len);
+
+  // Predicates of the vector compares (see RVV "vmfeq/vmfne/vmflt/vmfle/vmfgt/vmfge", x86 "cmpps/cmppd", and ARM64
+  // "fcmeq/fcmge/fcmgt"). Only kCmpNe and kCmpUnord are true for unordered operands, so the negated x86 predicates
+  // (e.g., "nlt") are the complements of the results. Quiet compares raise invalid for signaling NaNs, signaling
+  // compares for any NaN.
+  enum CompareOp : FfUtils::u8 { kCmpEq, kCmpNe, kCmpLt, kCmpLe, kCmpGt, kCmpGe, kCmpOrd, kCmpUnord };
+
+  // Writes the results to bit i of "dest" (RVV mask layout). Bits at positions len and above are left unchanged.
+  template <typename FT>
+  void VCompareMask(FT* pa, FT* pb, FfUtils::u8* dest, size_t len, CompareOp op, bool signaling);
+  template <typename FT>
+  void VCompareMask(FT* pa, FT b, FfUtils::u8* dest, size_t len, CompareOp op, bool signaling);  // ".vf" version.
+
+  // Writes the results as all-ones or all-zeros lanes (x86 and ARM64 layout).
+  template <typename FT>
+  void VCompareLanes(FT* pa, FT* pb, typename FfUtils::FloatToUint<FT>::type* dest, size_t len, CompareOp op,
+                     bool signaling);
+  template <typename FT>
+  void VCompareLanes(FT* pa, FT b, typename FfUtils::FloatToUint<FT>::type* dest, size_t len, CompareOp op,
+                     bool signaling);  // Versus a scalar, e.g., ARM64 "fcmeq #0.0".
+
+  // Integer conversions (see RVV "vfcvt/vfncvt", x86 "cvtps2dq/cvttpd2dq", and ARM64 "fcvtzs"). NaNs and values whose
+  // rounded result is out of range are replaced by the limits of the profile (e.g., "max_limit_i32_").
+  void VF32ToI32(FfUtils::f32* pa, FfUtils::i32* dest, size_t len);
+  void VF32ToU32(FfUtils::f32* pa, FfUtils::u32* dest, size_t len);
+  void VF64ToI32(FfUtils::f64* pa, FfUtils::i32* dest, size_t len);
+  void VF64ToU32(FfUtils::f64* pa, FfUtils::u32* dest, size_t len);
+  void VF64ToI64(FfUtils::f64* pa, FfUtils::i64* dest, size_t len);
+  void VF64ToU64(FfUtils::f64* pa, FfUtils::u64* dest, size_t len);
+  void VI32ToF32(FfUtils::i32* pa, FfUtils::f32* dest, size_t len);
+  void VU32ToF32(FfUtils::u32* pa, FfUtils::f32* dest, size_t len);
+
+  // Association orders of the sum reductions. kReduceOrdered is the strictly sequential order of RVV "vfredosum" and
+  // ARM64 SVE "fadda". kReducePairwise adds adjacent elements level by level (ARM64 "faddp" and "faddv").
+  // kReduceHalving adds the upper half onto the lower half, like register-folding implementations of RVV "vfredusum"
+  // and x86 horizontal sums. On levels with an odd number of elements, the last (pairwise) or middle (halving) element
+  // is carried to the next level unchanged.
+  enum ReduceShape : FfUtils::u8 { kReduceOrdered, kReducePairwise, kReduceHalving };
+
+  // Returns init + pa[0] + ... + pa[len - 1] in the given order. The tree shapes add "init" to the root of the tree.
+  template <typename FT>
+  FT VReduceSum(FT* pa, size_t len, FT init, ReduceShape shape);
+
+  // Reductions with the semantics of MaximumNumber/MinimumNumber (see RVV "vfredmax/vfredmin"), which do not depend on
+  // the association order.
+  template <typename FT>
+  FT VReduceMaxNumber(FT* pa, size_t len, FT init);
+  template <typename FT>
+  FT VReduceMinNumber(FT* pa, size_t len, FT init);
+
+  void VF32ToBF16(FfUtils::f32* pa, FfUtils::bf16* dest, size_t len);
+  void VBF16ToF32(FfUtils::bf16* pa, FfUtils::f32* dest, size_t len);
+
+  template <typename FP8, bool saturate>
+  void VF32ToFp8(FfUtils::f32* pa, FP8* dest, size_t len);
+
+  template <typename FP8, bool saturate>
+  void VF32ToFp8Stochastic(FfUtils::f32* pa, FfUtils::u32* random, FP8* dest, size_t len);
+
+  template <typename FP8>
+  void VFp8ToF32(FP8* pa, FfUtils::f32* dest, size_t len);
+
+protected:
+  template <typename FT>
+  auto VGetQnan();
+
+  template <typename MT, bool saturate, bool stochastic>
+  void VRoundToMiniFloat(FfUtils::f32* pa, FfUtils::u32* random, MT* dest, size_t len);
 
 private:
-  void SetupToArm();  // Currently not implemented/working.
-  void SetupToX86();  // Currently not implemented/working.
+  template <typename FT, RoundingMode rm>
+  void VAdd(FT* pa, FT* pb, FT* dest, size_t len);
+
+  template <typename FT, RoundingMode rm>
+  void VSub(FT* pa, FT* pb, FT* dest, size_t len);
+
+  template <typename FT, RoundingMode rm>
+  void VMul(FT* pa, FT* pb, FT* dest, size_t len);
+
+  template <typename FT, RoundingMode rm>
+  void VDiv(FT* pa, FT* pb, FT* dest, size_t len);
+
+  template <typename FT, RoundingMode rm>
+  void VSqrt(FT* pa, FT* dest, size_t len);
+
+  template <typename FT, RoundingMode rm>
+  void VFma(FT* pa, FT* pb, FT* pc, FT* dest, size_t len);
+
+  template <RoundingMode rm, typename VT, typename RT, typename MT>
+  void VRoundResult(VT& c, RT r, MT scalar, MT maybe_tie);
+
+  template <typename FT, size_t nargs, typename OP, typename SOP>
+  void VMasked(std::array<FT*, nargs> srcs, FT* dest, const FfUtils::u8* mask, size_t vstart, size_t vl, size_t vlmax,
+               FfUtils::u8 policy, OP op, SOP sop);
+
+  template <typename FT, typename IT, RoundingMode rm>
+  void VFToI(FT* pa, IT* dest, size_t len);
+
+  template <typename FT, typename IT>
+  void VFToI(FT* pa, IT* dest, size_t len);
+
+  template <typename IT, RoundingMode rm>
+  void VIToF32(IT* pa, FfUtils::f32* dest, size_t len);
+
+  template <typename IT>
+  void VIToF32(IT* pa, FfUtils::f32* dest, size_t len);
+
+  template <typename FT>
+  FT VReduceOrderedSum(FT* pa, size_t len, FT init);
+
+  template <typename FT>
+  FT VReduceTreeSum(FT* pa, size_t len, ReduceShape shape);
+
+  template <typename FT, bool max>
+  FT VReduceMinMaxNumber(FT* pa, size_t len, FT init);
+
+  template <typename FT, CompareOp op, typename EMIT>
+  void VCompare(FT* pa, FT* pb, FT b, size_t len, bool signaling, EMIT emit);  // Compares against "b" if "pb" is null.
+
+  template <typename FT, typename EMIT>
+  void VCompare(FT* pa, FT* pb, FT b, size_t len, CompareOp op, bool signaling, EMIT emit);
+
+  template <typename VT>
+  void VPropagateNan(VT& c, VT a, VT b);
+
+  template <typename VT>
+  void VPropagateNan(VT& d, VT a, VT b, VT c);
 };
\ No newline at end of file
@@ -11,7 +11,7 @@ SoftFloat::SoftFloat() : Vfpu() {
 
 template <typename FT, typename UT>
 constexpr UT SoftFloat::NormalizeSubnormal(i32& exp, UT mant) {
-  int shift = NumSignificandBits<FT>() - (NumBits<FT>() - 1 - std::countl_zero(mant));
+  int shift = NumSignificandBits<FT>() - (NumBits<UT>() - 1 - std::countl_zero(mant));
   exp = 1 - shift;
   return mant << shift;
 }
@@ -39,67 +39,111 @@ constexpr FT SoftFloat::Normalize(u32 a_sign, i32 a_exp, UT a_mant1, UT a_mant0)
   return RoundPack<FT>(a_sign, a_exp - shift, a_mant1);
 }
 
-template <typename UT>
-constexpr UT RshiftRnd(UT a, int d) {
-  static_assert(std::is_integral_v<UT>);
-  if (d == 0)
-    return a;
-  if (d >= NumBits<UT>())
-    return !!a;
+// There is no integer type of twice the width of u128, so the 128-bit helpers below work on 64-bit halves
+// (multiplication) or one bit at a time (division and square root).
+constexpr std::pair<u128, u128> Umul128(u128 a, u128 b) {
+  u128 a_lo = static_cast<u64>(a), a_hi = a >> 64;
+  u128 b_lo = static_cast<u64>(b), b_hi = b >> 64;
+  u128 ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+  u128 mid = (ll >> 64) + static_cast<u64>(lh) + static_cast<u64>(hl);
+  u128 lo = (mid << 64) | static_cast<u64>(ll);
+  u128 hi = hh + (lh >> 64) + (hl >> 64) + (mid >> 64);
+  return std::make_pair(lo, hi);
+}
+
+// Requires ah < b, i.e., the quotient fits into 128 bits.
+constexpr std::pair<u128, u128> DivRem128(u128 ah, u128 al, u128 b) {
+  u128 q = 0, r = ah;
+  for (int i = 127; i >= 0; --i) {
+    bool carry = r >> 127;
+    r = (r << 1) | ((al >> i) & 1);
+    q <<= 1;
+    if (carry || r >= b) {
+      r -= b;
+      q |= 1;
+    }
+  }
+  return std::make_pair(q, r);
+}
 
-  UT mask = (1ull << d) - 1ull;
-  return (a >> d) | !!(a & mask);
+// Digit-by-digit square root. Requires ah < 2^126 so that the remainder never overflows.
+constexpr bool Usqrt128(u128& root, u128 ah, u128 al) {
+  u128 s = 0, r = 0;
+  for (int i = 254; i >= 0; i -= 2) {
+    u128 bits = (i >= 128) ? (ah >> (i - 128)) & 3 : (al >> i) & 3;
+    if (r > s || (r == s && bits != 0)) {  // Equivalent to 4r + bits >= 4s + 1.
+      r = ((r - s) << 2) + bits - 1;
+      s = (s << 1) | 1;
+    } else {
+      r = (r << 2) | bits;
+      s <<= 1;
+    }
+  }
+  root = s;
+  return r != 0;
 }
 
 template <typename UT>
 constexpr std::pair<UT, UT> Umul(UT a, UT b) {
   static_assert(std::is_integral_v<UT>);
-  auto ta = static_cast<typename TwiceWidthType<UT>::type>(a);
-  auto tb = static_cast<typename TwiceWidthType<UT>::type>(b);
-  auto r = ta * tb;
-  return std::make_pair(r, r >> NumBits<UT>());
+  if constexpr (std::is_same_v<UT, u128>) {
+    return Umul128(a, b);
+  } else {
+    auto ta = static_cast<typename TwiceWidthType<UT>::type>(a);
+    auto tb = static_cast<typename TwiceWidthType<UT>::type>(b);
+    auto r = ta * tb;
+    return std::make_pair(r, r >> NumBits<UT>());
+  }
 }
 
 template <typename UT>
 constexpr std::pair<UT, UT> DivRem(UT ah, UT al, UT b) {
   static_assert(std::is_integral_v<UT>);
-  using UTT = typename TwiceWidthType<UT>::type;
-  UTT a = static_cast<UTT>(ah) << NumBits<UT>() | al;
-  return std::make_pair(a / b, a % b);
+  if constexpr (std::is_same_v<UT, u128>) {
+    return DivRem128(ah, al, b);
+  } else {
+    using UTT = typename TwiceWidthType<UT>::type;
+    UTT a = static_cast<UTT>(ah) << NumBits<UT>() | al;
+    return std::make_pair(a / b, a % b);
+  }
 }
 
 template <typename UT>
 constexpr bool Usqrt(UT& root, UT ah, UT al) {
   static_assert(std::is_integral_v<UT>);
-  using UTT = typename TwiceWidthType<UT>::type;
-  if (ah == 0 && al == 0) {
-    root = 0;
-    return false;
-  }
+  if constexpr (std::is_same_v<UT, u128>) {
+    return Usqrt128(root, ah, al);
+  } else {
+    using UTT = typename TwiceWidthType<UT>::type;
+    if (ah == 0 && al == 0) {
+      root = 0;
+      return false;
+    }
 
-  int l =
-      ah ? NumBits<UTT>() - std::countl_zero(static_cast<UT>(ah - 1)) : NumBits<UT>() - std::countl_zero(static_cast<UT>(al - 1));
-  UTT u = 1ull << (l + 1) / 2;
-  UTT a = static_cast<UTT>(ah) << NumBits<UT>() | al;
-  UTT s = 0;
+    int l =
+        ah ? NumBits<UTT>() - std::countl_zero(static_cast<UT>(ah - 1)) : NumBits<UT>() - std::countl_zero(static_cast<UT>(al - 1));
+    UTT u = 1ull << (l + 1) / 2;
+    UTT a = static_cast<UTT>(ah) << NumBits<UT>() | al;
+    UTT s = 0;
 
-  do {
-    s = u;
-    u = (a / s + s) / 2;
-  } while (u < s);
+    do {
+      s = u;
+      u = (a / s + s) / 2;
+    } while (u < s);
 
-  root = s;
-  return (a - s * s) != 0;
+    root = s;
+    return (a - s * s) != 0;
+  }
 }
 
 template <typename FT, typename UT>
 constexpr FT SoftFloat::RoundPack(bool a_sign, i32 a_exp, UT a_mant) {
-  u32 addend, rnd_bits;
+  UT addend, rnd_bits;  // Generic formats in a 64-bit container may have more than 32 rounding bits.
   switch (rounding_mode) {
   case kRoundTiesToEven:
     [[fallthrough]];
   case kRoundTiesToAway:
-    addend = 1u << (NumRoundBits<FT>() - 1);
+    addend = static_cast<UT>(1) << (NumRoundBits<FT>() - 1);
     break;
   case kRoundTowardZero:
     addend = 0;
@@ -116,7 +160,7 @@ constexpr FT SoftFloat::RoundPack(bool a_sign, i32 a_exp, UT a_mant) {
   if (a_exp > 0) {
     rnd_bits = a_mant & RoundMask<FT>();
   } else {
-    bool subnormal = a_exp < 0 || (a_mant + addend) < (1ull << (NumBits<FT>() - 1));
+    bool subnormal = a_exp < 0 || (a_mant + addend) < (static_cast<UT>(1) << (NumBits<FT>() - 1));
     subnormal = tininess_before_rounding ? true : subnormal;
     a_mant = RshiftRnd<UT>(a_mant, 1 - a_exp);
     rnd_bits = a_mant & RoundMask<FT>();
@@ -129,7 +173,7 @@ constexpr FT SoftFloat::RoundPack(bool a_sign, i32 a_exp, UT a_mant) {
     SetInexact();
 
   a_mant = (a_mant + addend) >> NumRoundBits<FT>();
-  if (rounding_mode == kRoundTiesToEven && rnd_bits == 1 << (NumRoundBits<FT>() - 1))
+  if (rounding_mode == kRoundTiesToEven && rnd_bits == static_cast<UT>(1) << (NumRoundBits<FT>() - 1))
     a_mant &= ~1;
 
   a_exp += a_mant >> (NumSignificandBits<FT>() + 1);
@@ -201,6 +245,7 @@ FT SoftFloat::Add(FT a, FT b) {
 template f16 SoftFloat::Add<f16>(f16 a, f16 b);
 template f32 SoftFloat::Add<f32>(f32 a, f32 b);
 template f64 SoftFloat::Add<f64>(f64 a, f64 b);
+template f128 SoftFloat::Add<f128>(f128 a, f128 b);
 
 template <typename FT>
 FT SoftFloat::Sub(FT a, FT b) {
@@ -265,6 +310,7 @@ FT SoftFloat::Sub(FT a, FT b) {
 template f16 SoftFloat::Sub<f16>(f16 a, f16 b);
 template f32 SoftFloat::Sub<f32>(f32 a, f32 b);
 template f64 SoftFloat::Sub<f64>(f64 a, f64 b);
+template f128 SoftFloat::Sub<f128>(f128 a, f128 b);
 
 template <typename FT>
 inline FT SoftFloat::Mul(FT a, FT b) {
@@ -327,6 +373,7 @@ inline FT SoftFloat::Mul(FT a, FT b) {
 template f16 SoftFloat::Mul<f16>(f16 a, f16 b);
 template f32 SoftFloat::Mul<f32>(f32 a, f32 b);
 template f64 SoftFloat::Mul<f64>(f64 a, f64 b);
+template f128 SoftFloat::Mul<f128>(f128 a, f128 b);
 
 template <typename FT>
 FT SoftFloat::Div(FT a, FT b) {
@@ -401,6 +448,7 @@ FT SoftFloat::Div(FT a, FT b) {
 template f16 SoftFloat::Div<f16>(f16 a, f16 b);
 template f32 SoftFloat::Div<f32>(f32 a, f32 b);
 template f64 SoftFloat::Div<f64>(f64 a, f64 b);
+template f128 SoftFloat::Div<f128>(f128 a, f128 b);
 
 template <typename FT>
 FT SoftFloat::Sqrt(FT a) {
@@ -463,6 +511,7 @@ FT SoftFloat::Sqrt(FT a) {
 template f16 SoftFloat::Sqrt<f16>(f16 a);
 template f32 SoftFloat::Sqrt<f32>(f32 a);
 template f64 SoftFloat::Sqrt<f64>(f64 a);
+template f128 SoftFloat::Sqrt<f128>(f128 a);
 
 template <typename FT>
 FT SoftFloat::Fma(FT a, FT b, FT c) {
@@ -534,7 +583,7 @@ FT SoftFloat::Fma(FT a, FT b, FT c) {
   i32 r_exp = a_exp + b_exp - (1 << (NumExponentBits<FT>() - 1)) + 3;
   auto [r_mant0, r_mant1] = Umul<UT>(a_mant << NumRoundBits<FT>(), b_mant << NumRoundBits<FT>());
 
-  if (r_mant1 < (1ull << (NumBits<FT>() - 3))) {
+  if (r_mant1 < (static_cast<UT>(1) << (NumBits<FT>() - 3))) {
     r_mant1 = (r_mant1 << 1) | (r_mant0 >> (NumBits<FT>() - 1));
     r_mant0 <<= 1;
     r_exp--;
@@ -581,7 +630,7 @@ FT SoftFloat::Fma(FT a, FT b, FT c) {
     c_mant0 = c_mant1 | (c_mant0 != 0);
     c_mant1 = 0;
   } else if (shift != 0) {
-    UT mask = (1ull << shift) - 1;
+    UT mask = (static_cast<UT>(1) << shift) - 1;
     c_mant0 = (c_mant1 << (NumBits<FT>() - shift)) | (c_mant0 >> shift) | ((c_mant0 & mask) != 0);
     c_mant1 = c_mant1 >> shift;
   }
@@ -604,6 +653,92 @@ FT SoftFloat::Fma(FT a, FT b, FT c) {
 template f16 SoftFloat::Fma<f16>(f16 a, f16 b, f16 c);
 template f32 SoftFloat::Fma<f32>(f32 a, f32 b, f32 c);
 template f64 SoftFloat::Fma<f64>(f64 a, f64 b, f64 c);
+template f128 SoftFloat::Fma<f128>(f128 a, f128 b, f128 c);
+
+template <typename FT>
+FT SoftFloat::RoundToIntegral(FT a, bool exact) {
+  using UT = FloatToUint<FT>::type;
+
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      SetInvalid();
+    return PropagateNan<FT>(a, a);
+  }
+
+  bool a_sign = std::signbit(a);
+  i32 a_exp = GetExponent<FT>(a);
+  UT a_bits = std::bit_cast<UT>(a);
+
+  // Infinities and values without fractional bits are already integral.
+  if (a_exp >= Bias<FT>() + NumSignificandBits<FT>())
+    return a;
+
+  // |a| < 1: The result is either ±0 or ±1.
+  if (a_exp < Bias<FT>()) {
+    if (IsZero(a))
+      return a;
+
+    bool round_up = false;
+    switch (rounding_mode) {
+    case kRoundTiesToEven:
+      round_up = (a_exp == Bias<FT>() - 1) && (GetSignificand<FT>(a) != 0);
+      break;
+    case kRoundTiesToAway:
+      round_up = (a_exp == Bias<FT>() - 1);
+      break;
+    case kRoundTowardPositive:
+      round_up = !a_sign;
+      break;
+    case kRoundTowardNegative:
+      round_up = a_sign;
+      break;
+    case kRoundTowardZero:
+      [[fallthrough]];
+    default:
+      break;
+    }
+
+    if (exact)
+      SetInexact();
+    return FloatFrom3Tuple<FT>(a_sign, round_up ? Bias<FT>() : 0, 0);
+  }
+
+  i32 num_frac_bits = Bias<FT>() + NumSignificandBits<FT>() - a_exp;
+  UT frac_mask = ((UT)1 << num_frac_bits) - 1;
+  if ((a_bits & frac_mask) == 0)
+    return a;
+
+  // A carry out of the significand correctly increments the exponent.
+  UT half = (UT)1 << (num_frac_bits - 1);
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    a_bits += half - 1 + ((a_bits >> num_frac_bits) & 1);
+    break;
+  case kRoundTiesToAway:
+    a_bits += half;
+    break;
+  case kRoundTowardPositive:
+    a_bits += a_sign ? 0 : frac_mask;
+    break;
+  case kRoundTowardNegative:
+    a_bits += a_sign ? frac_mask : 0;
+    break;
+  case kRoundTowardZero:
+    [[fallthrough]];
+  default:
+    break;
+  }
+  a_bits &= ~frac_mask;
+
+  if (exact)
+    SetInexact();
+  return std::bit_cast<FT>(a_bits);
+}
+
+template f16 SoftFloat::RoundToIntegral<f16>(f16 a, bool exact);
+template f32 SoftFloat::RoundToIntegral<f32>(f32 a, bool exact);
+template f64 SoftFloat::RoundToIntegral<f64>(f64 a, bool exact);
+template f128 SoftFloat::RoundToIntegral<f128>(f128 a, bool exact);
 
 f16 SoftFloat::I32ToF16(i32 a) {
   return IToF<i32, f16>(a);
@@ -653,17 +788,35 @@ f64 SoftFloat::U64ToF64(u64 a) {
   return IToF<u64, f64>(a);
 }
 
+f128 SoftFloat::I32ToF128(i32 a) {
+  return IToF<i32, f128>(a);
+}
+
+f128 SoftFloat::U32ToF128(u32 a) {
+  return IToF<u32, f128>(a);
+}
+
+f128 SoftFloat::I64ToF128(i64 a) {
+  return IToF<i64, f128>(a);
+}
+
+f128 SoftFloat::U64ToF128(u64 a) {
+  return IToF<u64, f128>(a);
+}
+
+// Converts between any two formats. Narrowing conversions round, widening ones are exact.
 template <typename TFROM, typename TTO>
 TTO SoftFloat::FToF(TFROM a) {
-  static_assert(std::is_floating_point_v<TFROM>);
-  static_assert(std::is_floating_point_v<TTO>);
-  static_assert(NumBits<TFROM>() > NumBits<TTO>());
+  static_assert(IsFloatType<TFROM>());
+  static_assert(IsFloatType<TTO>());
+  static_assert(!std::is_same_v<TFROM, TTO>);
   using UTFROM = FloatToUint<TFROM>::type;
   using UTTO = FloatToUint<TTO>::type;
+  using UT = std::conditional_t<(NumBits<UTFROM>() > NumBits<UTTO>()), UTFROM, UTTO>;
 
-  UTFROM a_mant = GetSignificand(a);
+  UT a_mant = GetSignificand(a);
   i32 a_exp = GetExponent(a);
-  bool a_sign = std::signbit(a);
+  bool a_sign = GetSign(a);
 
   if (a_exp == MaxExponent<TFROM>()) {
     if (a_mant != 0) {
@@ -678,19 +831,39 @@ TTO SoftFloat::FToF(TFROM a) {
   if (a_exp == 0) {
     if (a_mant == 0)
       return FloatFrom3Tuple<TTO>(a_sign, 0, 0);
-    NormalizeSubnormal<TTO>(a_exp, a_mant);
+    a_mant = NormalizeSubnormal<TFROM>(a_exp, a_mant);
   } else {
-    a_mant |= static_cast<UTFROM>(1) << NumSignificandBits<TFROM>();
+    a_mant |= static_cast<UT>(1) << NumSignificandBits<TFROM>();
   }
 
+  // Aligns the hidden bit with the working position of the target format.
   a_exp = a_exp - Bias<TFROM>() + Bias<TTO>();
-  a_mant = RshiftRnd<UTFROM>(a_mant, NumSignificandBits<TFROM>() - (NumBits<TTO>() - 2));
+  constexpr int kShift = NumSignificandBits<TFROM>() - NumImantBits<TTO>();
+  if constexpr (kShift > 0)
+    a_mant = RshiftRnd<UT>(a_mant, kShift);
+  else
+    a_mant <<= -kShift;
   return Normalize<TTO>(a_sign, a_exp, static_cast<UTTO>(a_mant));
 }
 
 template f16 SoftFloat::FToF<f32, f16>(f32 a);
+template bf16 SoftFloat::FToF<f32, bf16>(f32 a);
 template f16 SoftFloat::FToF<f64, f16>(f64 a);
 template f32 SoftFloat::FToF<f64, f32>(f64 a);
+template tf32 SoftFloat::FToF<f32, tf32>(f32 a);
+template tf32 SoftFloat::FToF<f64, tf32>(f64 a);
+template f32 SoftFloat::FToF<tf32, f32>(tf32 a);
+template f64 SoftFloat::FToF<tf32, f64>(tf32 a);
+template dlf16 SoftFloat::FToF<f32, dlf16>(f32 a);
+template dlf16 SoftFloat::FToF<f64, dlf16>(f64 a);
+template f32 SoftFloat::FToF<dlf16, f32>(dlf16 a);
+template f64 SoftFloat::FToF<dlf16, f64>(dlf16 a);
+template f128 SoftFloat::FToF<f32, f128>(f32 a);
+template f128 SoftFloat::FToF<f64, f128>(f64 a);
+template f32 SoftFloat::FToF<f128, f32>(f128 a);
+template f64 SoftFloat::FToF<f128, f64>(f128 a);
+template tf32 SoftFloat::FToF<f128, tf32>(f128 a);
+template dlf16 SoftFloat::FToF<f128, dlf16>(f128 a);
 
 template <typename TFROM, typename TTO>
 TTO SoftFloat::FToI(TFROM a) {
@@ -796,6 +969,10 @@ template i32 SoftFloat::FToI<f64, i32>(f64 a);
 template i64 SoftFloat::FToI<f64, i64>(f64 a);
 template u32 SoftFloat::FToI<f64, u32>(f64 a);
 template u64 SoftFloat::FToI<f64, u64>(f64 a);
+template i32 SoftFloat::FToI<f128, i32>(f128 a);
+template i64 SoftFloat::FToI<f128, i64>(f128 a);
+template u32 SoftFloat::FToI<f128, u32>(f128 a);
+template u64 SoftFloat::FToI<f128, u64>(f128 a);
 
 template <typename TFROM, typename TTO>
 TTO SoftFloat::IToF(TFROM a) {
@@ -830,6 +1007,10 @@ TTO SoftFloat::IToF(TFROM a) {
 template f16 SoftFloat::IToF<i32, f16>(i32 a);
 template f32 SoftFloat::IToF<i32, f32>(i32 a);
 template f64 SoftFloat::IToF<i32, f64>(i32 a);
+template f128 SoftFloat::IToF<i32, f128>(i32 a);
+template f128 SoftFloat::IToF<i64, f128>(i64 a);
+template f128 SoftFloat::IToF<u32, f128>(u32 a);
+template f128 SoftFloat::IToF<u64, f128>(u64 a);
 
 i32 SoftFloat::F16ToI32(f16 a) {
   return FToI<f16, i32>(a);
@@ -879,10 +1060,30 @@ u64 SoftFloat::F64ToU64(f64 a) {
   return FToI<f64, u64>(a);
 }
 
+i32 SoftFloat::F128ToI32(f128 a) {
+  return FToI<f128, i32>(a);
+}
+
+i64 SoftFloat::F128ToI64(f128 a) {
+  return FToI<f128, i64>(a);
+}
+
+u32 SoftFloat::F128ToU32(f128 a) {
+  return FToI<f128, u32>(a);
+}
+
+u64 SoftFloat::F128ToU64(f128 a) {
+  return FToI<f128, u64>(a);
+}
+
 f16 SoftFloat::F32ToF16(f32 a) {
   return FToF<f32, f16>(a);
 }
 
+bf16 SoftFloat::F32ToBF16(f32 a) {
+  return FToF<f32, bf16>(a);
+}
+
 f16 SoftFloat::F64ToF16(f64 a) {
   return FToF<f64, f16>(a);
 }
@@ -891,19 +1092,36 @@ f32 SoftFloat::F64ToF32(f64 a) {
   return FToF<f64, f32>(a);
 }
 
+f128 SoftFloat::F32ToF128(f32 a) {
+  return FToF<f32, f128>(a);
+}
+
+f128 SoftFloat::F64ToF128(f64 a) {
+  return FToF<f64, f128>(a);
+}
+
+f32 SoftFloat::F128ToF32(f128 a) {
+  return FToF<f128, f32>(a);
+}
+
+f64 SoftFloat::F128ToF64(f128 a) {
+  return FToF<f128, f64>(a);
+}
+
 template<typename TFROM, typename TTO>
 constexpr TTO SoftFloat::PropagateNan(TFROM a) {
-  static_assert(std::is_floating_point_v<TFROM>);
-  static_assert(std::is_floating_point_v<TTO>);
+  static_assert(IsFloatType<TFROM>());
+  static_assert(IsFloatType<TTO>());
   using UTTO = FloatToUint<TTO>::type;
   if (nan_propagation_scheme == kNanPropX86sse) {
     UTTO payload;
-    if constexpr (NumBits<TTO>() > NumBits<TFROM>()) {
+    if constexpr (NumSignificandBits<TTO>() > NumSignificandBits<TFROM>()) {
       payload = static_cast<UTTO>(GetPayload(a)) << (NumSignificandBits<TTO>() - NumSignificandBits<TFROM>());
     } else {
       payload = GetPayload(a) >> (NumSignificandBits<TFROM>() - NumSignificandBits<TTO>());
     }
-    UTTO result = (((UTTO)std::signbit(a)) << (NumBits<TTO>() - 1)) | (ExponentMask<TTO>() | QuietBit<TTO>::u) | payload;
+    payload &= QuietBit<TTO>::u - 1;
+    UTTO result = (GetSign(a) ? SignMask<TTO>() : 0) | (ExponentMask<TTO>() | QuietBit<TTO>::u) | payload;
     return std::bit_cast<TTO>(result);
   } else if (nan_propagation_scheme == kNanPropRiscv) {
     return GetQnan<TTO>();
@@ -26,6 +26,8 @@ class SoftFloat : public Vfpu {
   FT Sqrt(FT a);
   template <typename FT>
   FT Fma(FT a, FT b, FT c);
+  template <typename FT>
+  FT RoundToIntegral(FT a, bool exact);
 
   FfUtils::i32 F16ToI32(FfUtils::f16 a);
   FfUtils::i64 F16ToI64(FfUtils::f16 a);
@@ -33,10 +35,12 @@ class SoftFloat : public Vfpu {
   FfUtils::u64 F16ToU64(FfUtils::f16 a);
 
   FfUtils::f16 F32ToF16(FfUtils::f32 a);
+  FfUtils::bf16 F32ToBF16(FfUtils::f32 a);
   FfUtils::i32 F32ToI32(FfUtils::f32 a);
   FfUtils::i64 F32ToI64(FfUtils::f32 a);
   FfUtils::u32 F32ToU32(FfUtils::f32 a);
   FfUtils::u64 F32ToU64(FfUtils::f32 a);
+  FfUtils::f128 F32ToF128(FfUtils::f32 a);
 
   FfUtils::f16 F64ToF16(FfUtils::f64 a);
   FfUtils::f32 F64ToF32(FfUtils::f64 a);
@@ -44,6 +48,14 @@ class SoftFloat : public Vfpu {
   FfUtils::i64 F64ToI64(FfUtils::f64 a);
   FfUtils::u32 F64ToU32(FfUtils::f64 a);
   FfUtils::u64 F64ToU64(FfUtils::f64 a);
+  FfUtils::f128 F64ToF128(FfUtils::f64 a);
+
+  FfUtils::f32 F128ToF32(FfUtils::f128 a);
+  FfUtils::f64 F128ToF64(FfUtils::f128 a);
+  FfUtils::i32 F128ToI32(FfUtils::f128 a);
+  FfUtils::i64 F128ToI64(FfUtils::f128 a);
+  FfUtils::u32 F128ToU32(FfUtils::f128 a);
+  FfUtils::u64 F128ToU64(FfUtils::f128 a);
 
   FfUtils::f16 I32ToF16(FfUtils::i32 a);
   FfUtils::f32 I32ToF32(FfUtils::i32 a);
@@ -61,6 +73,15 @@ class SoftFloat : public Vfpu {
   FfUtils::f32 U64ToF32(FfUtils::u64 a);
   FfUtils::f64 U64ToF64(FfUtils::u64 a);
 
+  FfUtils::f128 I32ToF128(FfUtils::i32 a);
+  FfUtils::f128 U32ToF128(FfUtils::u32 a);
+  FfUtils::f128 I64ToF128(FfUtils::i64 a);
+  FfUtils::f128 U64ToF128(FfUtils::u64 a);
+
+  // Conversion between any two formats, including generic ones (see FfUtils::FloatFormat).
+  template <typename TFROM, typename TTO>
+  TTO FToF(TFROM a);
+
   protected:
   template <typename FT, typename UT>
   constexpr FT RoundPack(bool a_sign, FfUtils::i32 a_exp, UT a_mant);
@@ -73,8 +94,6 @@ class SoftFloat : public Vfpu {
   template <typename FT, typename UT>
   constexpr FT Normalize(FfUtils::u32 a_sign, FfUtils::i32 a_exp, UT a_mant0, UT a_mant1);
 
-  template<typename TFROM, typename TTO>
-  TTO FToF(TFROM a);
   template<typename TFROM, typename TTO>
   TTO FToI(TFROM a);
   template<typename TFROM, typename TTO>
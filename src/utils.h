@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <bit>
 #include <cmath>
 #include <cstdint>
@@ -52,6 +53,7 @@
 namespace FfUtils {
 
 using f16 = std::float16_t;
+using bf16 = std::bfloat16_t;
 // TODO: I'd prefer std::float*_t, but SimdFloat (or std::simd to be more exact) currently only supports float and double.
 // Although not guaranteed by the C++ standard, float and std::float32_t,
 // and double and std::float64_t should be the same on virtual all non-obscure platforms.
@@ -76,6 +78,159 @@ using u128 = __uint128_t;
 template <typename T>
 using nl = std::numeric_limits<T>;
 
+// OCP 8-bit floating-point formats (see "OCP 8-bit Floating Point Specification (OFP8)") and the
+// sub-byte element formats of "OCP Microscaling Formats (MX) Specification". There is no host type
+// for these, so the encoding is wrapped to keep them apart from plain integers.
+struct fp8e4m3 {
+  u8 v;
+};
+
+struct fp8e5m2 {
+  u8 v;
+};
+
+struct fp6e3m2 {
+  u8 v;
+};
+
+struct fp6e2m3 {
+  u8 v;
+};
+
+struct fp4e2m1 {
+  u8 v;
+};
+
+// MXINT8 element: two's complement with an implicit scale of 2^-6.
+struct mxint8 {
+  i8 v;
+};
+
+// x87 double extended precision (see Intel SDM Vol. 1, "4.2.2 Floating-Point Data Types"). Unlike the IEEE formats,
+// the 64-bit significand has an explicit integer bit (bit 63). This is the memory layout of "FSTP m80fp" and of
+// "long double" on x86 hosts.
+struct f80 {
+  u64 significand;
+  u16 sign_exponent;
+};
+
+template <typename MT>
+struct MiniFloatFormat;
+
+// E4M3 has no infinities and a single NaN encoding per sign (S.1111.111).
+template <>
+struct MiniFloatFormat<fp8e4m3> {
+  static constexpr int kNumBits = 8;
+  static constexpr int kSigBits = 3;
+  static constexpr int kBias = 7;
+  static constexpr u8 kMaxCode = 0x7e;       // 448
+  static constexpr u8 kOverflowCode = 0x7f;  // NaN
+  static constexpr u8 kNanCode = 0x7f;
+};
+
+// E5M2 follows the IEEE 754 conventions for infinities and NaNs.
+template <>
+struct MiniFloatFormat<fp8e5m2> {
+  static constexpr int kNumBits = 8;
+  static constexpr int kSigBits = 2;
+  static constexpr int kBias = 15;
+  static constexpr u8 kMaxCode = 0x7b;       // 57344
+  static constexpr u8 kOverflowCode = 0x7c;  // Infinity
+  static constexpr u8 kNanCode = 0x7e;
+};
+
+// The MX FP6 and FP4 formats have neither infinities nor NaNs, so overflows always saturate.
+template <>
+struct MiniFloatFormat<fp6e3m2> {
+  static constexpr int kNumBits = 6;
+  static constexpr int kSigBits = 2;
+  static constexpr int kBias = 3;
+  static constexpr u8 kMaxCode = 0x1f;  // 28
+  static constexpr u8 kOverflowCode = kMaxCode;
+};
+
+template <>
+struct MiniFloatFormat<fp6e2m3> {
+  static constexpr int kNumBits = 6;
+  static constexpr int kSigBits = 3;
+  static constexpr int kBias = 1;
+  static constexpr u8 kMaxCode = 0x1f;  // 7.5
+  static constexpr u8 kOverflowCode = kMaxCode;
+};
+
+template <>
+struct MiniFloatFormat<fp4e2m1> {
+  static constexpr int kNumBits = 4;
+  static constexpr int kSigBits = 1;
+  static constexpr int kBias = 1;
+  static constexpr u8 kMaxCode = 0x7;  // 6
+  static constexpr u8 kOverflowCode = kMaxCode;
+};
+
+// Generic binary format with "E" exponent and "M" significand bits (hidden bit excluded), e.g., FloatFormat<8, 10>
+// for TF32. Infinities, NaNs, and subnormals follow IEEE 754. The encoding is stored right-aligned in the smallest
+// unsigned integer that fits, which is also the working width of SoftFloat.
+template <int E, int M>
+struct FloatFormat {
+  static_assert(E >= 2 && M >= 1 && 1 + E + M <= 64);
+  using UT = std::conditional_t<(1 + E + M <= 16), u16, std::conditional_t<(1 + E + M <= 32), u32, u64>>;
+  UT v;
+};
+
+using tf32 = FloatFormat<8, 10>;  // NVIDIA TensorFloat-32 (also known as FP19).
+using dlf16 = FloatFormat<6, 9>;  // Layout of IBM DLFloat16 (its saturating special values are not modeled).
+
+template <typename T>
+struct IsFloatFormat : std::false_type {};
+
+template <int E, int M>
+struct IsFloatFormat<FloatFormat<E, M>> : std::true_type {};
+
+// Exponent and significand widths from which all other format properties are derived.
+template <typename FT>
+struct FloatLayout;
+
+template <>
+struct FloatLayout<f16> {
+  static constexpr int kExpBits = 5;
+  static constexpr int kSigBits = 10;
+};
+
+template <>
+struct FloatLayout<bf16> {
+  static constexpr int kExpBits = 8;
+  static constexpr int kSigBits = 7;
+};
+
+template <>
+struct FloatLayout<f32> {
+  static constexpr int kExpBits = 8;
+  static constexpr int kSigBits = 23;
+};
+
+template <>
+struct FloatLayout<f64> {
+  static constexpr int kExpBits = 11;
+  static constexpr int kSigBits = 52;
+};
+
+template <>
+struct FloatLayout<f128> {
+  static constexpr int kExpBits = 15;
+  static constexpr int kSigBits = 112;
+};
+
+template <int E, int M>
+struct FloatLayout<FloatFormat<E, M>> {
+  static constexpr int kExpBits = E;
+  static constexpr int kSigBits = M;
+};
+
+template <typename FT>
+constexpr bool IsFloatType() {
+  return std::is_floating_point_v<FT> || IsFloatFormat<FT>::value;
+}
+
 template <typename T>
 struct TwiceWidthType;
 
@@ -84,6 +239,11 @@ struct TwiceWidthType<f16> {
   using type = f32;
 };
 
+template <>
+struct TwiceWidthType<bf16> {
+  using type = f32;
+};
+
 template <>
 struct TwiceWidthType<f32> {
   using type = f64;
@@ -117,6 +277,10 @@ struct FloatToUint<f16> {
   using type = u16;
 };
 template <>
+struct FloatToUint<bf16> {
+  using type = u16;
+};
+template <>
 struct FloatToUint<f32> {
   using type = u32;
 };
@@ -124,6 +288,14 @@ template <>
 struct FloatToUint<f64> {
   using type = u64;
 };
+template <>
+struct FloatToUint<f128> {
+  using type = u128;
+};
+template <int E, int M>
+struct FloatToUint<FloatFormat<E, M>> {
+  using type = typename FloatFormat<E, M>::UT;
+};
 
 template <typename T>
 struct FloatToInt;
@@ -133,6 +305,10 @@ struct FloatToInt<f16> {
   using type = i16;
 };
 template <>
+struct FloatToInt<bf16> {
+  using type = i16;
+};
+template <>
 struct FloatToInt<f32> {
   using type = i32;
 };
@@ -140,6 +316,10 @@ template <>
 struct FloatToInt<f64> {
   using type = i64;
 };
+template <>
+struct FloatToInt<f128> {
+  using type = i128;
+};
 
 template <typename T>
 struct UintToFloat;
@@ -158,40 +338,20 @@ struct UintToFloat<f64> {
 };
 
 template <typename FT>
-struct QuietBit;
-
-template <>
-struct QuietBit<f16> {
-  static constexpr u16 u = 0x0200u;
-};
-
-template <>
-struct QuietBit<f32> {
-  static constexpr u32 u = 0x00400000u;
-};
-
-template <>
-struct QuietBit<f64> {
-  static constexpr u64 u = 0x0008000000000000ull;
+struct QuietBit {
+  static constexpr typename FloatToUint<FT>::type u = static_cast<typename FloatToUint<FT>::type>(1)
+                                                      << (FloatLayout<FT>::kSigBits - 1);
 };
 
 template <typename FT>
 constexpr int Bias() {
-  static_assert(std::is_floating_point_v<FT>);
-  if constexpr (std::is_same_v<FT, f16>) {
-    return 15;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    return 127;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    return 1023;
-  } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
-  }
+  static_assert(IsFloatType<FT>());
+  return (1 << (FloatLayout<FT>::kExpBits - 1)) - 1;
 }
 
 template <typename T>
 constexpr int NumBits() {
-  if constexpr (std::is_same_v<T, f16> || std::is_same_v<T, u16> || std::is_same_v<T, i16>) {
+  if constexpr (std::is_same_v<T, f16> || std::is_same_v<T, bf16> || std::is_same_v<T, u16> || std::is_same_v<T, i16>) {
     return 16;
   } else if constexpr (std::is_same_v<T, f32> || std::is_same_v<T, u32> || std::is_same_v<T, i32>) {
     return 32;
@@ -199,171 +359,120 @@ constexpr int NumBits() {
     return 64;
   } else if constexpr (std::is_same_v<T, f128> || std::is_same_v<T, u128> || std::is_same_v<T, i128>) {
     return 128;
+  } else if constexpr (IsFloatFormat<T>::value) {
+    return NumBits<typename T::UT>();
   } else {
     static_assert(false, "Unsupported data type");
   }
 }
 
+// Right shift that ORs all shifted out bits into the least significant bit (sticky bit).
+template <typename UT>
+constexpr UT RshiftRnd(UT a, int d) {
+  static_assert(std::is_integral_v<UT>);
+  if (d == 0)
+    return a;
+  if (d >= NumBits<UT>())
+    return !!a;
+
+  UT mask = (static_cast<UT>(1) << d) - 1;
+  return (a >> d) | !!(a & mask);
+}
+
 template <typename FT>
 constexpr int NumSignificandBits() {
-  static_assert(std::is_floating_point_v<FT>);
-  if constexpr (std::is_same_v<FT, f16>) {
-    return 10;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    return 23;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    return 52;
-  } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
-  }
+  static_assert(IsFloatType<FT>());
+  return FloatLayout<FT>::kSigBits;
 }
 
 template <typename FT>
 constexpr int NumImantBits() {
-  static_assert(std::is_floating_point_v<FT>);
-  if constexpr (std::is_same_v<FT, f16>) {
-    return 14;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    return 30;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    return 62;
-  } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
-  }
+  static_assert(IsFloatType<FT>());
+  return NumBits<typename FloatToUint<FT>::type>() - 2;
 }
 
 template <typename FT>
 constexpr int NumExponentBits() {
-  static_assert(std::is_floating_point_v<FT>);
-  if constexpr (std::is_same_v<FT, f16>) {
-    return 5;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    return 8;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    return 11;
-  } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
-  }
+  static_assert(IsFloatType<FT>());
+  return FloatLayout<FT>::kExpBits;
 }
 
 template <typename FT>
 constexpr i32 MaxExponent() {
-  static_assert(std::is_floating_point_v<FT>);
-  if constexpr (std::is_same_v<FT, f16>) {
-    return 31;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    return 255;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    return 2047;
-  } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
-  }
+  static_assert(IsFloatType<FT>());
+  return (1 << FloatLayout<FT>::kExpBits) - 1;
 }
 
 template <typename FT>
 constexpr int NumRoundBits() {
-  static_assert(std::is_floating_point_v<FT>);
+  static_assert(IsFloatType<FT>());
   return NumImantBits<FT>() - NumSignificandBits<FT>();
 }
 
 template <typename FT>
-constexpr u64 RoundMask() {
-  static_assert(std::is_floating_point_v<FT>);
-  return (1ull << NumRoundBits<FT>()) - 1ull;
+constexpr auto RoundMask() {
+  static_assert(IsFloatType<FT>());
+  using UT = typename FloatToUint<FT>::type;
+  return static_cast<UT>((static_cast<UT>(1) << NumRoundBits<FT>()) - 1);
+}
+
+template <typename FT>
+constexpr auto MaxSignificand() {
+  static_assert(IsFloatType<FT>());
+  using UT = typename FloatToUint<FT>::type;
+  return static_cast<UT>((static_cast<UT>(1) << NumSignificandBits<FT>()) - 1);
+}
+
+template <typename FT>
+constexpr auto ExponentMask() {
+  static_assert(IsFloatType<FT>());
+  using UT = typename FloatToUint<FT>::type;
+  return static_cast<UT>(static_cast<UT>(MaxExponent<FT>()) << NumSignificandBits<FT>());
+}
+
+template <typename FT>
+constexpr auto SignMask() {
+  static_assert(IsFloatType<FT>());
+  using UT = typename FloatToUint<FT>::type;
+  return static_cast<UT>(static_cast<UT>(1) << (NumExponentBits<FT>() + NumSignificandBits<FT>()));
 }
 
 template <typename FT>
 constexpr FT ClearSignificand(FT a) {
-  static_assert(std::is_floating_point_v<FT>);
-  auto u = std::bit_cast<typename FloatToUint<FT>::type>(a);
-  if constexpr (std::is_same_v<FT, f16>) {
-    u &= 0xfc00u;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    u &= 0xff800000u;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    u &= 0xfff0000000000000ull;
-  } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
-  }
-  return std::bit_cast<FT>(u);
+  static_assert(IsFloatType<FT>());
+  using UT = typename FloatToUint<FT>::type;
+  return std::bit_cast<FT>(static_cast<UT>(std::bit_cast<UT>(a) & ~static_cast<UT>(MaxSignificand<FT>())));
 }
 
 template <typename FT>
 constexpr FT CreateQnanWithPayload(typename FloatToUint<FT>::type payload) {
   using UT = decltype(payload);
-  UT u;
-  if constexpr (std::is_same_v<FT, f16>) {
-    u = 0x7e00u;
-    assert(payload < 0x200u);
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    u = 0x7fc00000u;
-    assert(payload < 0x400000u);
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    u = 0x7ff8000000000000ull;
-    assert(payload < 0x8000000000000ull);
-  } else {
-    static_assert(false, "Type needs to be f16, f32, float, f64, or double");
-  }
-  return std::bit_cast<FT>((UT)(u | payload));
+  assert(payload < QuietBit<FT>::u);
+  return std::bit_cast<FT>(static_cast<UT>(ExponentMask<FT>() | QuietBit<FT>::u | payload));
 }
 
 template <typename FT>
 constexpr FT CreateSnanWithPayload(typename FloatToUint<FT>::type payload) {
   using UT = decltype(payload);
-  UT u;
-  if constexpr (std::is_same_v<FT, f16>) {
-    u = 0x7c00u;
-    assert(payload < 0x200u);
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    u = 0x7f800000u;
-    assert(payload < 0x400000u);
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    u = 0x7ff0000000000000ull;
-    assert(payload < 0x8000000000000ull);
-  } else {
-    static_assert(false, "Type needs to be f16, f32, float, f64, or double");
-  }
-  return std::bit_cast<FT>((UT)(u | payload));
+  assert(payload < QuietBit<FT>::u);
+  return std::bit_cast<FT>(static_cast<UT>(ExponentMask<FT>() | payload));
 }
 
 template <typename FT>
-constexpr auto FloatFrom3Tuple(bool sign, u32 exponent, u64 significand) {
-  static_assert(std::is_floating_point_v<FT>);
+constexpr auto FloatFrom3Tuple(bool sign, u32 exponent, typename FloatToUint<FT>::type significand) {
+  static_assert(IsFloatType<FT>());
   using UT = typename FloatToUint<FT>::type;
-  UT u = 0;
-  if constexpr (std::is_same_v<FT, f16>) {
-    u |= static_cast<UT>(sign) << 15;
-    u |= static_cast<UT>(exponent) << NumSignificandBits<FT>();
-    u |= static_cast<UT>(significand) & 0x3ffu;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    u |= static_cast<UT>(sign) << 31;
-    u |= static_cast<UT>(exponent) << NumSignificandBits<FT>();
-    u |= static_cast<UT>(significand) & 0x007fffffu;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    u |= static_cast<UT>(sign) << 63;
-    u |= static_cast<UT>(exponent) << NumSignificandBits<FT>();
-    u |= static_cast<UT>(significand) & 0xfffffffffffffull;
-  } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
-  }
+  UT u = static_cast<UT>(sign) << (NumExponentBits<FT>() + NumSignificandBits<FT>());
+  u |= static_cast<UT>(exponent) << NumSignificandBits<FT>();
+  u |= static_cast<UT>(significand) & static_cast<UT>(MaxSignificand<FT>());
   return std::bit_cast<FT>(u);
 }
 
 template <typename FT>
 constexpr auto GetSignificand(FT a) {
-  static_assert(std::is_floating_point_v<FT>);
+  static_assert(IsFloatType<FT>());
   using UT = typename FloatToUint<FT>::type;
-  UT u = std::bit_cast<typename FloatToUint<FT>::type>(a);
-  if constexpr (std::is_same_v<FT, f16>) {
-    u &= 0x3ffu;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    u &= 0x007fffffu;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    u &= 0xfffffffffffffull;
-  } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
-  }
-  return u;
+  return static_cast<UT>(std::bit_cast<UT>(a) & MaxSignificand<FT>());
 }
 
 template <typename FT>
@@ -372,37 +481,56 @@ constexpr auto GetPayload(FT a) {
   UT u;
   if constexpr (std::is_same_v<FT, f16>) {
     u = std::bit_cast<UT>(a) & 0x1ffu;
+  } else if constexpr (std::is_same_v<FT, bf16>) {
+    u = std::bit_cast<UT>(a) & 0x3fu;
   } else if constexpr (std::is_same_v<FT, f32>) {
     u = std::bit_cast<UT>(a) & 0x3fffffu;
   } else if constexpr (std::is_same_v<FT, f64>) {
     u = std::bit_cast<UT>(a) & 0xfffffffffffffull;
+  } else if constexpr (IsFloatFormat<FT>::value || std::is_same_v<FT, f128>) {
+    u = std::bit_cast<UT>(a) & (QuietBit<FT>::u - 1);
   } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+    static_assert(false, "Type needs to be f16, bf16, f32, f64, or f128");
   }
   return u;
 }
 
 template <typename FT>
 constexpr bool GetQuietBit(FT a) {
-  static_assert(std::is_floating_point_v<FT>);
+  static_assert(IsFloatType<FT>());
   return QuietBit<FT>::u & std::bit_cast<typename FloatToUint<FT>::type>(a);
 }
 
 template <typename FT>
 constexpr auto GetExponent(FT a) {
-  static_assert(std::is_floating_point_v<FT>);
+  static_assert(IsFloatType<FT>());
   using UT = typename FloatToUint<FT>::type;
-  UT u = std::bit_cast<typename FloatToUint<FT>::type>(a);
-  if constexpr (std::is_same_v<FT, f16>) {
-    u = (u >> NumSignificandBits<FT>()) & 0x1fu;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    u = (u >> NumSignificandBits<FT>()) & 0xffu;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    u = (u >> NumSignificandBits<FT>()) & 0x7ffull;
-  } else {
-    static_assert(false, "Type needs to be f16, f32, or f64");
+  return static_cast<UT>((std::bit_cast<UT>(a) >> NumSignificandBits<FT>()) & MaxExponent<FT>());
+}
+
+template <typename FT>
+constexpr bool GetSign(FT a) {
+  static_assert(IsFloatType<FT>());
+  using UT = typename FloatToUint<FT>::type;
+  return (std::bit_cast<UT>(a) >> (NumExponentBits<FT>() + NumSignificandBits<FT>())) & 1;
+}
+
+// Exact conversion of any format that fits into f64, including infinities and NaNs (payloads are left-aligned).
+template <typename FT>
+constexpr f64 WidenToF64(FT a) {
+  static_assert(NumExponentBits<FT>() <= 11 && NumSignificandBits<FT>() <= 52);
+  constexpr int kShift = 52 - NumSignificandBits<FT>();
+  u64 sign = static_cast<u64>(GetSign(a)) << 63;
+  u64 exp = GetExponent(a);
+  u64 sig = GetSignificand(a);
+  if (exp == static_cast<u64>(MaxExponent<FT>())) [[unlikely]]
+    return std::bit_cast<f64>(sign | 0x7ff0000000000000ull | (sig << kShift));
+  if (exp == 0) [[unlikely]] {  // Scales in two exact steps as the smallest subnormals may be subnormal in f64.
+    f64 r = static_cast<f64>(sig) * std::bit_cast<f64>(static_cast<u64>(1023 - NumSignificandBits<FT>()) << 52) *
+            std::bit_cast<f64>(static_cast<u64>(1024 - Bias<FT>()) << 52);
+    return std::bit_cast<f64>(sign | std::bit_cast<u64>(r));
   }
-  return u;
+  return std::bit_cast<f64>(sign | ((exp - Bias<FT>() + 1023) << 52) | (sig << kShift));
 }
 
 template <typename FT>
@@ -511,50 +639,138 @@ constexpr FT NextUpNoNegZero(FT a) {
   return std::bit_cast<FT>(au);
 }
 
-template <typename FT>
-constexpr u64 MaxSignificand() {
-  static_assert(std::is_floating_point_v<FT>);
-  return (1ull << NumSignificandBits<FT>()) - 1ull;
-}
-
 template <typename FT>
 constexpr FT SetQuietBit(FT a) {
   auto au = std::bit_cast<typename FloatToUint<FT>::type>(a);
   return std::bit_cast<FT>((decltype(au))(QuietBit<FT>::u | au));
 }
 
-template <typename FT>
-constexpr auto ExponentMask() {
-  static_assert(std::is_floating_point_v<FT>);
-  using UT = typename FloatToUint<FT>::type;
-  UT u;
-  if constexpr (std::is_same_v<FT, f16>) {
-    u = 0x7c00u;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    u = 0x7f800000u;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    u = 0x7ff0000000000000ull;
-  } else {
-    static_assert("Type needs to be f16, f32, or f64");
+// 7-bit reciprocal estimate table of the RISC-V "V" extension (see "vfrec7.v").
+// Entry i holds the 7 fraction bits of 1/x rounded to nearest, where x is the midpoint 1 + (i + 0.5) / 128.
+constexpr std::array<u8, 128> CreateRecip7Table() {
+  std::array<u8, 128> table{};
+  for (int i = 0; i < 128; ++i) {
+    f64 x = 1.0 + (i + 0.5) / 128.0;
+    table[i] = static_cast<u8>(128.0 * (2.0 / x - 1.0) + 0.5);
   }
-  return u;
-};
+  return table;
+}
+
+// 7-bit reciprocal square root estimate table of the RISC-V "V" extension (see "vfrsqrt7.v").
+// Entries 0-63 cover inputs with an odd unbiased exponent (x in [2, 4)), entries 64-127 even ones (x in [1, 2)).
+// Each entry is the number of rounding thresholds 1 + (k - 0.5) / 128 that do not exceed 2 / sqrt(x_mid),
+// which avoids computing a square root at compile time.
+constexpr std::array<u8, 128> CreateRsqrt7Table() {
+  std::array<u8, 128> table{};
+  for (int i = 0; i < 128; ++i) {
+    f64 x = ((i < 64) ? 2.0 : 1.0) * (1.0 + ((i & 63) + 0.5) / 64.0);
+    int k = 0;
+    while (k < 127 && x * (1.0 + (k + 0.5) / 128.0) * (1.0 + (k + 0.5) / 128.0) <= 4.0)
+      ++k;
+    table[i] = static_cast<u8>(k);
+  }
+  return table;
+}
 
-template <typename FT>
-constexpr auto SignMask() {
-  static_assert(std::is_floating_point_v<FT>);
-  using UT = typename FloatToUint<FT>::type;
-  UT u;
-  if constexpr (std::is_same_v<FT, f16>) {
-    u = 1u << 15;
-  } else if constexpr (std::is_same_v<FT, f32>) {
-    u = 1u << 31;
-  } else if constexpr (std::is_same_v<FT, f64>) {
-    u = 1ull << 63;
+// Reciprocal estimate table of ARM64 (see "RecipEstimate" in the Arm ARM).
+// Index is the scaled input in [256, 512) minus 256; entries hold the estimate in [256, 512) minus 256.
+constexpr std::array<u8, 256> CreateArmRecipTable() {
+  std::array<u8, 256> table{};
+  for (int a = 256; a < 512; ++a) {
+    int b = (1 << 19) / (a * 2 + 1);
+    table[a - 256] = static_cast<u8>((b + 1) / 2 - 256);
+  }
+  return table;
+}
+
+// Reciprocal square root estimate table of ARM64 (see "RecipSqrtEstimate" in the Arm ARM).
+// Index is the scaled input in [128, 512) minus 128; entries hold the estimate in [256, 512) minus 256.
+constexpr std::array<u8, 384> CreateArmRsqrtTable() {
+  std::array<u8, 384> table{};
+  for (int a = 128; a < 512; ++a) {
+    int x = (a < 256) ? a * 2 + 1 : (((a >> 1) << 1) + 1) * 2;
+    int b = 512;
+    while (x * (b + 1) * (b + 1) < (1 << 28))
+      ++b;
+    table[a - 128] = static_cast<u8>((b + 1) / 2 - 256);
+  }
+  return table;
+}
+
+inline constexpr std::array<u8, 128> kRecip7Table = CreateRecip7Table();
+inline constexpr std::array<u8, 128> kRsqrt7Table = CreateRsqrt7Table();
+inline constexpr std::array<u8, 256> kArmRecipTable = CreateArmRecipTable();
+inline constexpr std::array<u8, 384> kArmRsqrtTable = CreateArmRsqrtTable();
+
+// Decodes all encodings of a mini float to f32. NaNs decode to a quiet NaN with the sign of the input.
+template <typename MT>
+constexpr std::array<f32, 256> CreateMiniFloatDecodeTable() {
+  constexpr int kNumBits = MiniFloatFormat<MT>::kNumBits;
+  constexpr int kSigBits = MiniFloatFormat<MT>::kSigBits;
+  constexpr int kBias = MiniFloatFormat<MT>::kBias;
+  constexpr u32 kSignBit = 1u << (kNumBits - 1);
+  constexpr u32 kExpMask = (kSignBit - 1) >> kSigBits;
+  std::array<f32, 256> table{};
+  for (u32 c = 0; c < (1u << kNumBits); ++c) {
+    u32 sign = (c & kSignBit) ? 0x80000000u : 0u;
+    u32 exp = (c >> kSigBits) & kExpMask;
+    u32 sig = c & ((1u << kSigBits) - 1);
+    u32 bits;
+    if constexpr (std::is_same_v<MT, fp8e4m3>) {
+      if ((c & 0x7f) == 0x7f) {
+        table[c] = std::bit_cast<f32>(sign | 0x7fc00000u);
+        continue;
+      }
+    } else if constexpr (std::is_same_v<MT, fp8e5m2>) {
+      if (exp == kExpMask) {
+        table[c] = std::bit_cast<f32>(sign | (sig == 0 ? 0x7f800000u : 0x7fc00000u));
+        continue;
+      }
+    }
+    if (exp != 0) {
+      bits = ((exp - kBias + 127) << 23) | (sig << (23 - kSigBits));
+    } else if (sig != 0) {  // Subnormals of mini floats are normal numbers in f32.
+      int msb = std::bit_width(sig) - 1;
+      bits = static_cast<u32>(msb + 1 - kBias - kSigBits + 127) << 23 | ((sig ^ (1u << msb)) << (23 - msb));
+    } else {
+      bits = 0;
+    }
+    table[c] = std::bit_cast<f32>(sign | bits);
+  }
+  return table;
+}
+
+inline constexpr std::array<f32, 256> kFp8E4M3Table = CreateMiniFloatDecodeTable<fp8e4m3>();
+inline constexpr std::array<f32, 256> kFp8E5M2Table = CreateMiniFloatDecodeTable<fp8e5m2>();
+inline constexpr std::array<f32, 256> kFp6E3M2Table = CreateMiniFloatDecodeTable<fp6e3m2>();
+inline constexpr std::array<f32, 256> kFp6E2M3Table = CreateMiniFloatDecodeTable<fp6e2m3>();
+inline constexpr std::array<f32, 256> kFp4E2M1Table = CreateMiniFloatDecodeTable<fp4e2m1>();
+
+template <typename MT>
+constexpr const std::array<f32, 256>& MiniFloatDecodeTable() {
+  if constexpr (std::is_same_v<MT, fp8e4m3>) {
+    return kFp8E4M3Table;
+  } else if constexpr (std::is_same_v<MT, fp8e5m2>) {
+    return kFp8E5M2Table;
+  } else if constexpr (std::is_same_v<MT, fp6e3m2>) {
+    return kFp6E3M2Table;
+  } else if constexpr (std::is_same_v<MT, fp6e2m3>) {
+    return kFp6E2M3Table;
+  } else if constexpr (std::is_same_v<MT, fp4e2m1>) {
+    return kFp4E2M1Table;
   } else {
-    static_assert("Type needs to be f16, f32, or f64");
+    static_assert(false, "Unsupported mini float format");
   }
-  return u;
+}
+
+// Returns the upper 32 bits of a double (see RISC-V Zfa "fmvh.x.d").
+constexpr u32 GetHighBits(f64 a) {
+  return static_cast<u32>(std::bit_cast<u64>(a) >> 32);
+}
+
+// Assembles a double from two 32-bit halves (see RISC-V Zfa "fmvp.d.x").
+constexpr f64 FloatFromHighLowBits(u32 high, u32 low) {
+  return std::bit_cast<f64>((static_cast<u64>(high) << 32) | low);
 }
 
 };  // namespace FfUtils
\ No newline at end of file
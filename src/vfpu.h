@@ -35,6 +35,10 @@ class Vfpu {
     kQNan = 9
   };
 
+  // Bit positions of the comparison results (see ARM64 "NZCV" and x86 "EFLAGS").
+  enum CompareFlagsArm : FfUtils::u8 { kArmV = 1 << 0, kArmC = 1 << 1, kArmZ = 1 << 2, kArmN = 1 << 3 };
+  enum CompareFlagsX86 : FfUtils::u8 { kX86Cf = 1 << 0, kX86Pf = 1 << 2, kX86Zf = 1 << 6 };
+
   // Floating Exception Flags.
   bool invalid;
   bool division_by_zero;
@@ -44,7 +48,12 @@ class Vfpu {
 
   // kNanPropArm64DefaultNan => FPCR.DN = 1
   // kNanPropArm64 => FPCR.DN = 0
-  enum NanPropagationSchemes { kNanPropRiscv, kNanPropX86sse, kNanPropArm64DefaultNan, kNanPropArm64 } nan_propagation_scheme;
+  enum NanPropagationSchemes {
+    kNanPropRiscv,
+    kNanPropX86sse,
+    kNanPropArm64DefaultNan,
+    kNanPropArm64
+  } nan_propagation_scheme = kNanPropRiscv;
   bool tininess_before_rounding = false;
   bool invalid_fma = true;  // If true, FMA raises invalid for "∞ × 0 + qNaN". See IEE 754 ("7.2 Invalid operation").
 
@@ -68,8 +77,10 @@ class Vfpu {
 
  protected:
   FfUtils::f16 qnan16_;
+  FfUtils::bf16 qnanbf16_;
   FfUtils::f32 qnan32_;
   FfUtils::f64 qnan64_;
+  FfUtils::f128 qnan128_;
 
   template <typename T>
   T MaxLimit();
@@ -122,4 +133,22 @@ class Vfpu {
     RmGuard(Vfpu* vfpu, RoundingMode rm);
     ~RmGuard();
   };
-};
\ No newline at end of file
+};
+
+// Generic formats (see FfUtils::FloatFormat) use a quiet NaN with the sign of the 32-bit default NaN.
+template <typename FT>
+FT Vfpu::GetQnan() {
+  static_assert(FfUtils::IsFloatFormat<FT>::value);
+  return FfUtils::FloatFrom3Tuple<FT>(std::signbit(qnan32_), FfUtils::MaxExponent<FT>(), FfUtils::QuietBit<FT>::u);
+}
+
+template <>
+FfUtils::f16 Vfpu::GetQnan<FfUtils::f16>();
+template <>
+FfUtils::bf16 Vfpu::GetQnan<FfUtils::bf16>();
+template <>
+FfUtils::f32 Vfpu::GetQnan<FfUtils::f32>();
+template <>
+FfUtils::f64 Vfpu::GetQnan<FfUtils::f64>();
+template <>
+FfUtils::f128 Vfpu::GetQnan<FfUtils::f128>();
\ No newline at end of file
@@ -0,0 +1,792 @@
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include "x87_float.h"
+
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+using namespace FfUtils;
+
+constexpr i32 kBias80 = 16383;
+constexpr i32 kMaxExp80 = 0x7fff;
+constexpr u64 kIntegerBit = 0x8000000000000000ull;
+constexpr u64 kQuietBit80 = 0x4000000000000000ull;
+constexpr f80 kIndefinite{0xc000000000000000ull, 0xffff};  // Default NaN ("real indefinite").
+
+// On x86 hosts, "long double" is the x87 format. Other hosts (e.g., with a binary128 long double) use the soft path.
+constexpr bool kHostX87 = nl<long double>::digits == 64 && nl<long double>::max_exponent == 16384;
+
+// Operands and host results with exponents in this range are normal and keep all intermediates of the residual
+// computations below normal and finite.
+constexpr i32 kFastMinExp = 128;
+constexpr i32 kFastMaxExp = kMaxExp80 - 1 - 128;
+
+constexpr bool GetSign(f80 a) {
+  return a.sign_exponent >> 15;
+}
+
+constexpr i32 GetExponent(f80 a) {
+  return a.sign_exponent & kMaxExp80;
+}
+
+constexpr bool IsNan(f80 a) {
+  return GetExponent(a) == kMaxExp80 && (a.significand & kIntegerBit) && (a.significand << 1);
+}
+
+constexpr bool IsSnan(f80 a) {
+  return IsNan(a) && !(a.significand & kQuietBit80);
+}
+
+constexpr bool IsInf(f80 a) {
+  return GetExponent(a) == kMaxExp80 && a.significand == kIntegerBit;
+}
+
+constexpr bool IsZero(f80 a) {
+  return GetExponent(a) == 0 && a.significand == 0;
+}
+
+// Includes pseudo-denormals, i.e., denormals with the integer bit set.
+constexpr bool IsDenormal(f80 a) {
+  return GetExponent(a) == 0 && a.significand != 0;
+}
+
+// Unnormals, pseudo-infinities, and pseudo-NaNs have a non-zero exponent but no integer bit.
+// The 387 and later raise invalid for them (see Intel SDM Vol. 1, "8.2.2 Unsupported Double Extended-Precision
+// Floating-Point Encodings and Pseudo-Denormals").
+constexpr bool IsUnsupported(f80 a) {
+  return GetExponent(a) != 0 && !(a.significand & kIntegerBit);
+}
+
+constexpr bool IsFastOperand(f80 a) {
+  return GetExponent(a) >= kFastMinExp && GetExponent(a) <= kFastMaxExp && (a.significand & kIntegerBit);
+}
+
+constexpr f80 Pack(bool sign, i32 exp, u64 sig) {
+  return f80{sig, static_cast<u16>((static_cast<u32>(sign) << 15) | static_cast<u32>(exp))};
+}
+
+constexpr f80 Negate(f80 a) {
+  return f80{a.significand, static_cast<u16>(a.sign_exponent ^ 0x8000u)};
+}
+
+// Exponent and significand of a finite and non-zero operand with the integer bit moved to bit 63.
+constexpr std::pair<i32, u64> Unpack(f80 a) {
+  i32 exp = GetExponent(a) ? GetExponent(a) : 1;
+  int lz = std::countl_zero(a.significand);
+  return std::make_pair(exp - lz, a.significand << lz);
+}
+
+inline long double ToHost(f80 a) {
+  long double r = 0;
+  std::memcpy(&r, &a.significand, sizeof(a.significand));
+  std::memcpy(reinterpret_cast<char*>(&r) + sizeof(a.significand), &a.sign_exponent, sizeof(a.sign_exponent));
+  return r;
+}
+
+inline f80 FromHost(long double a) {
+  f80 r;
+  std::memcpy(&r.significand, &a, sizeof(r.significand));
+  std::memcpy(&r.sign_exponent, reinterpret_cast<char*>(&a) + sizeof(r.significand), sizeof(r.sign_exponent));
+  return r;
+}
+
+// Veltkamp splitting and Dekker's product. The error of the 64-bit product is exact as long as nothing overflows or
+// underflows (see T. J. Dekker, "A floating-point technique for extending the available precision").
+inline long double TwoProductError(long double a, long double b, long double p) {
+  constexpr long double kSplitter = 4294967297.0L;  // 2^32 + 1
+  long double ta = kSplitter * a;
+  long double a_hi = ta - (ta - a);
+  long double a_lo = a - a_hi;
+  long double tb = kSplitter * b;
+  long double b_hi = tb - (tb - b);
+  long double b_lo = b - b_hi;
+  return ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+}
+
+X87Float::X87Float() : Vfpu() {
+  SetupToX86();
+  precision_control = kPrecision64;
+  denormal = false;
+  c1 = false;
+}
+
+u16 X87Float::GetFlagsX87() {
+  return (c1 << 9) | (inexact << 5) | (underflow << 4) | (overflow << 3) | (division_by_zero << 2) | (denormal << 1) |
+         invalid;
+}
+
+void X87Float::ClearFlags() {
+  Vfpu::ClearFlags();
+  denormal = false;
+  c1 = false;
+}
+
+int X87Float::PrecisionBits() {
+  switch (precision_control) {
+  case kPrecision24:
+    return 24;
+  case kPrecision53:
+    return 53;
+  case kPrecision64:
+    return 64;
+  default:
+    throw std::runtime_error(std::string("Unknown precision control"));
+  }
+}
+
+// Rounds sig * 2^(exp - bias - 127) to "precision" bits, where "sig" has its leading bit at bit 127 and a sticky bit
+// at bit 0. Results below the normal range are denormalized first without moving the rounding position, just like the
+// x87 does with a reduced precision (see also "softfloat_roundPackToExtF80" of Berkeley SoftFloat).
+// Returns the biased exponent (0 for denormals) and the rounded significand, still aligned to bit 127.
+template <Vfpu::RoundingMode rm>
+std::pair<i32, u128> X87Float::Round(bool sign, i32 exp, u128 sig, int precision, i32 max_exp) {
+  const int shift = 128 - precision;
+  const u128 round_mask = (static_cast<u128>(1) << shift) - 1;
+  const u128 half = static_cast<u128>(1) << (shift - 1);
+
+  auto round_up = [&](u128 s) {
+    u128 rest = s & round_mask;
+    if constexpr (rm == kRoundTiesToEven)
+      return rest > half || (rest == half && ((s >> shift) & 1));
+    else if constexpr (rm == kRoundTiesToAway)
+      return rest >= half;
+    else if constexpr (rm == kRoundTowardPositive)
+      return !sign && rest;
+    else if constexpr (rm == kRoundTowardNegative)
+      return sign && rest;
+    else
+      return false;
+  };
+
+  bool tiny = false;
+  if (exp < 1) [[unlikely]] {
+    // Tiny after rounding unless rounding with an unbounded exponent range carries into the smallest normal exponent.
+    tiny = tininess_before_rounding || exp < 0 || (sig | round_mask) != ~static_cast<u128>(0) || !round_up(sig);
+    sig = RshiftRnd<u128>(sig, 1 - exp);
+    exp = 0;
+  }
+
+  bool inexact_result = sig & round_mask;
+  bool increment = round_up(sig);
+  sig &= ~round_mask;
+  if (increment) {
+    sig += round_mask + 1;
+    if (sig == 0) {
+      sig = static_cast<u128>(1) << 127;
+      ++exp;
+    }
+  }
+  if (exp == 0 && (sig >> 127))  // A denormal rounded up to the smallest normal.
+    exp = 1;
+
+  if (inexact_result) {
+    SetInexact();
+    c1 = increment;
+    if (tiny)
+      SetUnderflow();
+  }
+
+  if (exp > max_exp) [[unlikely]] {
+    SetOverflow();
+    SetInexact();
+    c1 = rm == kRoundTiesToEven || rm == kRoundTiesToAway || (rm == kRoundTowardPositive && !sign) ||
+         (rm == kRoundTowardNegative && sign);
+    if (c1)
+      return std::make_pair(max_exp + 1, static_cast<u128>(1) << 127);
+    return std::make_pair(max_exp, ~round_mask);
+  }
+
+  return std::make_pair(exp, sig);
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87Float::RoundPack(bool sign, i32 exp, u128 sig) {
+  auto [r_exp, r_sig] = Round<rm>(sign, exp, sig, PrecisionBits(), kMaxExp80 - 1);
+  return Pack(sign, r_exp, static_cast<u64>(r_sig >> 64));
+}
+
+// The host result "r" is rounded to nearest even with 64 bits, and the exact result is r + residual. All rounding
+// positions of the (reduced) precision lie on the 64-bit grid, so only the side of the residual matters.
+// A tie at the 64-bit precision is indistinguishable from a slightly smaller residual, which is why
+// round-ties-to-away is not supported here.
+template <Vfpu::RoundingMode rm>
+f80 X87Float::RoundResidual(f80 r, long double residual) {
+  static_assert(rm != kRoundTiesToAway);
+  bool sign = GetSign(r);
+  i32 exp = GetExponent(r);
+  u128 sig = static_cast<u128>(r.significand) << 64;
+  if (residual != 0) {
+    if (std::signbit(residual) == sign) {
+      sig |= 1;
+    } else {
+      sig -= 1;
+      if (!(sig >> 127)) {
+        sig <<= 1;
+        --exp;
+      }
+    }
+  }
+  return RoundPack<rm>(sign, exp, sig);
+}
+
+// Same as the 8086 specialization of Berkeley SoftFloat: a quiet NaN takes precedence over a signaling one,
+// otherwise the NaN with the larger significand wins.
+f80 X87Float::PropagateNan(f80 a, f80 b) {
+  bool a_snan = IsSnan(a);
+  bool b_snan = IsSnan(b);
+  if (a_snan || b_snan)
+    SetInvalid();
+
+  f80 r;
+  if (!IsNan(b)) {
+    r = a;
+  } else if (!IsNan(a)) {
+    r = b;
+  } else if (a_snan != b_snan) {
+    r = a_snan ? b : a;
+  } else if (a.significand != b.significand) {
+    r = (a.significand > b.significand) ? a : b;
+  } else {
+    r = (a.sign_exponent < b.sign_exponent) ? a : b;
+  }
+  r.significand |= kIntegerBit | kQuietBit80;
+  return r;
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87Float::AddSub(f80 a, f80 b, bool negate_b) {
+  if (IsUnsupported(a) || IsUnsupported(b)) [[unlikely]] {
+    SetInvalid();
+    return kIndefinite;
+  }
+  if (IsNan(a) || IsNan(b)) [[unlikely]]
+    return PropagateNan(a, b);
+
+  if (negate_b)
+    b = Negate(b);
+
+  if (IsInf(a) || IsInf(b)) [[unlikely]] {
+    if (IsInf(a) && IsInf(b) && GetSign(a) != GetSign(b)) {
+      SetInvalid();
+      return kIndefinite;
+    }
+    if (IsDenormal(a) || IsDenormal(b))
+      SetDenormal();
+    return IsInf(a) ? a : b;
+  }
+
+  if (IsDenormal(a) || IsDenormal(b))
+    SetDenormal();
+
+  i32 a_exp = GetExponent(a) ? GetExponent(a) : 1;
+  i32 b_exp = GetExponent(b) ? GetExponent(b) : 1;
+  if (a_exp < b_exp || (a_exp == b_exp && a.significand < b.significand)) {
+    std::swap(a, b);
+    std::swap(a_exp, b_exp);
+  }
+
+  // Two spare bits on top and 62 guard bits below keep the sum exact up to the sticky bit.
+  u128 a_sig = static_cast<u128>(a.significand) << 62;
+  u128 b_sig = RshiftRnd<u128>(static_cast<u128>(b.significand) << 62, a_exp - b_exp);
+  bool sign = GetSign(a);
+  u128 sig = (GetSign(a) == GetSign(b)) ? a_sig + b_sig : a_sig - b_sig;
+
+  if (sig == 0) {
+    if (GetSign(a) != GetSign(b))
+      sign = rm == kRoundTowardNegative;
+    return Pack(sign, 0, 0);
+  }
+
+  int lz = std::countl_zero(sig);
+  return RoundPack<rm>(sign, a_exp + 2 - lz, sig << lz);
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87Float::Add(f80 a, f80 b) {
+  c1 = false;
+  return AddSub<rm>(a, b, false);
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87Float::Sub(f80 a, f80 b) {
+  c1 = false;
+  return AddSub<rm>(a, b, true);
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87Float::Mul(f80 a, f80 b) {
+  c1 = false;
+  if (IsUnsupported(a) || IsUnsupported(b)) [[unlikely]] {
+    SetInvalid();
+    return kIndefinite;
+  }
+  if (IsNan(a) || IsNan(b)) [[unlikely]]
+    return PropagateNan(a, b);
+
+  bool sign = GetSign(a) ^ GetSign(b);
+  if ((IsInf(a) && IsZero(b)) || (IsZero(a) && IsInf(b))) [[unlikely]] {
+    SetInvalid();
+    return kIndefinite;
+  }
+
+  if (IsDenormal(a) || IsDenormal(b))
+    SetDenormal();
+
+  if (IsInf(a) || IsInf(b)) [[unlikely]]
+    return Pack(sign, kMaxExp80, kIntegerBit);
+  if (IsZero(a) || IsZero(b))
+    return Pack(sign, 0, 0);
+
+  auto [a_exp, a_sig] = Unpack(a);
+  auto [b_exp, b_sig] = Unpack(b);
+  u128 sig = static_cast<u128>(a_sig) * b_sig;
+  int lz = std::countl_zero(sig);
+  return RoundPack<rm>(sign, a_exp + b_exp - kBias80 + 1 - lz, sig << lz);
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87Float::Div(f80 a, f80 b) {
+  c1 = false;
+  if (IsUnsupported(a) || IsUnsupported(b)) [[unlikely]] {
+    SetInvalid();
+    return kIndefinite;
+  }
+  if (IsNan(a) || IsNan(b)) [[unlikely]]
+    return PropagateNan(a, b);
+
+  bool sign = GetSign(a) ^ GetSign(b);
+  if ((IsInf(a) && IsInf(b)) || (IsZero(a) && IsZero(b))) [[unlikely]] {
+    SetInvalid();
+    return kIndefinite;
+  }
+  if (IsZero(b) && !IsInf(a)) [[unlikely]] {
+    SetDivisionByZero();
+    return Pack(sign, kMaxExp80, kIntegerBit);
+  }
+
+  if (IsDenormal(a) || IsDenormal(b))
+    SetDenormal();
+
+  if (IsInf(a)) [[unlikely]]
+    return Pack(sign, kMaxExp80, kIntegerBit);
+  if (IsInf(b) || IsZero(a))
+    return Pack(sign, 0, 0);
+
+  // Long division in two 64-bit steps. Both significands are normalized, so the first quotient fits into 64 bits.
+  auto [a_exp, a_sig] = Unpack(a);
+  auto [b_exp, b_sig] = Unpack(b);
+  u128 n = static_cast<u128>(a_sig) << 63;
+  u128 q_hi = n / b_sig;
+  u128 n_lo = (n % b_sig) << 64;
+  u128 q_lo = n_lo / b_sig;
+  u128 sig = (q_hi << 64) | q_lo | ((n_lo % b_sig) != 0);
+  int lz = std::countl_zero(sig);
+  return RoundPack<rm>(sign, a_exp - b_exp + kBias80 - lz, sig << lz);
+}
+
+// Floor of the square root of "a" from a double precision estimate and one Newton step.
+inline u64 Isqrt(u128 a) {
+  f64 estimate = std::sqrt(static_cast<f64>(a));
+  u64 r = (estimate >= 0x1p64) ? ~0ull : static_cast<u64>(estimate);
+  if (r > 0)
+    r = static_cast<u64>((static_cast<u128>(r) + a / r) / 2);
+  while (static_cast<u128>(r) * r > a)
+    --r;
+  while (r != ~0ull && static_cast<u128>(r + 1) * (r + 1) <= a)
+    ++r;
+  return r;
+}
+
+template <Vfpu::RoundingMode rm>
+f80 X87Float::Sqrt(f80 a) {
+  c1 = false;
+  if constexpr (kHostX87 && rm != kRoundTiesToAway) {
+    if (IsFastOperand(a) && !GetSign(a)) [[likely]] {
+      long double ha = ToHost(a);
+      long double hr = std::sqrt(ha);
+      long double p = hr * hr;
+      return RoundResidual<rm>(FromHost(hr), (ha - p) - TwoProductError(hr, hr, p));
+    }
+  }
+
+  if (IsUnsupported(a)) [[unlikely]] {
+    SetInvalid();
+    return kIndefinite;
+  }
+  if (IsNan(a)) [[unlikely]]
+    return PropagateNan(a, a);
+  if (IsZero(a))
+    return a;
+  if (GetSign(a)) [[unlikely]] {
+    SetInvalid();
+    return kIndefinite;
+  }
+  if (IsInf(a)) [[unlikely]]
+    return a;
+
+  if (IsDenormal(a))
+    SetDenormal();
+
+  // Makes the exponent even, then computes 65 bits of the root digit by digit on top of the 64-bit integer root.
+  auto [a_exp, a_sig] = Unpack(a);
+  i32 exp = a_exp - kBias80;
+  u128 n = static_cast<u128>(a_sig) << (63 + (exp & 1));
+  u64 root = Isqrt(n);
+  u128 rem = n - static_cast<u128>(root) * root;
+  bool next_bit = rem > root;
+  u128 next_rem = (rem << 2) - (next_bit ? (static_cast<u128>(root) << 2) + 1 : 0);
+  u128 sig = (((static_cast<u128>(root) << 1) | next_bit) << 63) | (next_rem != 0);
+  return RoundPack<rm>(false, (exp >> 1) + kBias80, sig);
+}
+
+f80 X87Float::Add(f80 a, f80 b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Add<kRoundTiesToEven>(a, b);
+  case kRoundTiesToAway:
+    return Add<kRoundTiesToAway>(a, b);
+  case kRoundTowardPositive:
+    return Add<kRoundTowardPositive>(a, b);
+  case kRoundTowardNegative:
+    return Add<kRoundTowardNegative>(a, b);
+  case kRoundTowardZero:
+    return Add<kRoundTowardZero>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+f80 X87Float::Sub(f80 a, f80 b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Sub<kRoundTiesToEven>(a, b);
+  case kRoundTiesToAway:
+    return Sub<kRoundTiesToAway>(a, b);
+  case kRoundTowardPositive:
+    return Sub<kRoundTowardPositive>(a, b);
+  case kRoundTowardNegative:
+    return Sub<kRoundTowardNegative>(a, b);
+  case kRoundTowardZero:
+    return Sub<kRoundTowardZero>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+f80 X87Float::Mul(f80 a, f80 b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Mul<kRoundTiesToEven>(a, b);
+  case kRoundTiesToAway:
+    return Mul<kRoundTiesToAway>(a, b);
+  case kRoundTowardPositive:
+    return Mul<kRoundTowardPositive>(a, b);
+  case kRoundTowardNegative:
+    return Mul<kRoundTowardNegative>(a, b);
+  case kRoundTowardZero:
+    return Mul<kRoundTowardZero>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+f80 X87Float::Div(f80 a, f80 b) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Div<kRoundTiesToEven>(a, b);
+  case kRoundTiesToAway:
+    return Div<kRoundTiesToAway>(a, b);
+  case kRoundTowardPositive:
+    return Div<kRoundTowardPositive>(a, b);
+  case kRoundTowardNegative:
+    return Div<kRoundTowardNegative>(a, b);
+  case kRoundTowardZero:
+    return Div<kRoundTowardZero>(a, b);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+f80 X87Float::Sqrt(f80 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return Sqrt<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return Sqrt<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return Sqrt<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return Sqrt<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return Sqrt<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f80 X87Float::Add<X87Float::kRoundTiesToEven>(f80 a, f80 b);
+template f80 X87Float::Add<X87Float::kRoundTowardPositive>(f80 a, f80 b);
+template f80 X87Float::Add<X87Float::kRoundTowardNegative>(f80 a, f80 b);
+template f80 X87Float::Add<X87Float::kRoundTowardZero>(f80 a, f80 b);
+template f80 X87Float::Add<X87Float::kRoundTiesToAway>(f80 a, f80 b);
+
+template f80 X87Float::Sub<X87Float::kRoundTiesToEven>(f80 a, f80 b);
+template f80 X87Float::Sub<X87Float::kRoundTowardPositive>(f80 a, f80 b);
+template f80 X87Float::Sub<X87Float::kRoundTowardNegative>(f80 a, f80 b);
+template f80 X87Float::Sub<X87Float::kRoundTowardZero>(f80 a, f80 b);
+template f80 X87Float::Sub<X87Float::kRoundTiesToAway>(f80 a, f80 b);
+
+template f80 X87Float::Mul<X87Float::kRoundTiesToEven>(f80 a, f80 b);
+template f80 X87Float::Mul<X87Float::kRoundTowardPositive>(f80 a, f80 b);
+template f80 X87Float::Mul<X87Float::kRoundTowardNegative>(f80 a, f80 b);
+template f80 X87Float::Mul<X87Float::kRoundTowardZero>(f80 a, f80 b);
+template f80 X87Float::Mul<X87Float::kRoundTiesToAway>(f80 a, f80 b);
+
+template f80 X87Float::Div<X87Float::kRoundTiesToEven>(f80 a, f80 b);
+template f80 X87Float::Div<X87Float::kRoundTowardPositive>(f80 a, f80 b);
+template f80 X87Float::Div<X87Float::kRoundTowardNegative>(f80 a, f80 b);
+template f80 X87Float::Div<X87Float::kRoundTowardZero>(f80 a, f80 b);
+template f80 X87Float::Div<X87Float::kRoundTiesToAway>(f80 a, f80 b);
+
+template f80 X87Float::Sqrt<X87Float::kRoundTiesToEven>(f80 a);
+template f80 X87Float::Sqrt<X87Float::kRoundTowardPositive>(f80 a);
+template f80 X87Float::Sqrt<X87Float::kRoundTowardNegative>(f80 a);
+template f80 X87Float::Sqrt<X87Float::kRoundTowardZero>(f80 a);
+template f80 X87Float::Sqrt<X87Float::kRoundTiesToAway>(f80 a);
+
+template <typename FT>
+f80 X87Float::FToF80(FT a) {
+  c1 = false;
+  bool sign = GetSign(a);
+  u64 sig = static_cast<u64>(GetSignificand(a)) << (63 - NumSignificandBits<FT>());
+  i32 exp = GetExponent(a);
+  if (exp == MaxExponent<FT>()) [[unlikely]] {
+    if (IsSnan(a)) {
+      SetInvalid();
+      sig |= kQuietBit80;
+    }
+    return Pack(sign, kMaxExp80, kIntegerBit | sig);
+  }
+  if (exp == 0) {
+    if (sig == 0)
+      return Pack(sign, 0, 0);
+    SetDenormal();
+    int lz = std::countl_zero(sig);
+    return Pack(sign, 1 - Bias<FT>() + kBias80 - lz, sig << lz);
+  }
+  return Pack(sign, exp - Bias<FT>() + kBias80, kIntegerBit | sig);
+}
+
+f80 X87Float::F32ToF80(f32 a) {
+  return FToF80<f32>(a);
+}
+
+f80 X87Float::F64ToF80(f64 a) {
+  return FToF80<f64>(a);
+}
+
+f80 X87Float::I32ToF80(i32 a) {
+  return I64ToF80(a);
+}
+
+f80 X87Float::I64ToF80(i64 a) {
+  c1 = false;
+  if (a == 0)
+    return Pack(false, 0, 0);
+  u64 mag = (a < 0) ? -static_cast<u64>(a) : static_cast<u64>(a);
+  int lz = std::countl_zero(mag);
+  return Pack(a < 0, kBias80 + 63 - lz, mag << lz);
+}
+
+template <typename FT, Vfpu::RoundingMode rm>
+FT X87Float::F80ToF(f80 a) {
+  c1 = false;
+  using UT = typename FloatToUint<FT>::type;
+  constexpr int kShift = 63 - NumSignificandBits<FT>();
+  bool sign = GetSign(a);
+  if (IsUnsupported(a)) [[unlikely]] {
+    SetInvalid();
+    return FloatFrom3Tuple<FT>(true, MaxExponent<FT>(), QuietBit<FT>::u);
+  }
+  if (IsNan(a)) [[unlikely]] {
+    if (IsSnan(a))
+      SetInvalid();
+    return FloatFrom3Tuple<FT>(sign, MaxExponent<FT>(), static_cast<UT>(a.significand >> kShift) | QuietBit<FT>::u);
+  }
+  if (IsInf(a)) [[unlikely]]
+    return FloatFrom3Tuple<FT>(sign, MaxExponent<FT>(), 0);
+  if (IsZero(a))
+    return FloatFrom3Tuple<FT>(sign, 0, 0);
+
+  auto [a_exp, a_sig] = Unpack(a);
+  auto [exp, sig] = Round<rm>(sign, a_exp - kBias80 + Bias<FT>(), static_cast<u128>(a_sig) << 64,
+                              NumSignificandBits<FT>() + 1, MaxExponent<FT>() - 1);
+  return FloatFrom3Tuple<FT>(sign, exp, static_cast<UT>(sig >> (kShift + 64)));
+}
+
+template <typename IT, Vfpu::RoundingMode rm>
+IT X87Float::F80ToI(f80 a) {
+  c1 = false;
+  if (IsUnsupported(a) || IsNan(a) || IsInf(a)) [[unlikely]] {
+    SetInvalid();
+    return nl<IT>::min();  // Integer indefinite.
+  }
+  if (IsZero(a))
+    return 0;
+
+  bool sign = GetSign(a);
+  auto [a_exp, a_sig] = Unpack(a);
+  i32 exp = a_exp - kBias80;
+  if (exp >= 63) [[unlikely]] {
+    if (exp == 63 && sign && a_sig == kIntegerBit && NumBits<IT>() == 64)
+      return nl<IT>::min();
+    SetInvalid();
+    return nl<IT>::min();
+  }
+
+  // Integer part in the upper and fraction in the lower 64 bits.
+  u128 fixed = RshiftRnd<u128>(static_cast<u128>(a_sig) << 64, 63 - exp);
+  u64 integer = static_cast<u64>(fixed >> 64);
+  u64 fraction = static_cast<u64>(fixed);
+  bool increment;
+  if constexpr (rm == kRoundTiesToEven)
+    increment = fraction > kIntegerBit || (fraction == kIntegerBit && (integer & 1));
+  else if constexpr (rm == kRoundTiesToAway)
+    increment = fraction >= kIntegerBit;
+  else if constexpr (rm == kRoundTowardPositive)
+    increment = !sign && fraction;
+  else if constexpr (rm == kRoundTowardNegative)
+    increment = sign && fraction;
+  else
+    increment = false;
+  integer += increment;
+
+  u64 limit = static_cast<u64>(nl<IT>::max()) + sign;
+  if (integer > limit) [[unlikely]] {
+    SetInvalid();
+    return nl<IT>::min();
+  }
+
+  if (fraction) {
+    SetInexact();
+    c1 = increment;
+  }
+  return static_cast<IT>(sign ? -integer : integer);
+}
+
+template <Vfpu::RoundingMode rm>
+f32 X87Float::F80ToF32(f80 a) {
+  return F80ToF<f32, rm>(a);
+}
+
+template <Vfpu::RoundingMode rm>
+f64 X87Float::F80ToF64(f80 a) {
+  return F80ToF<f64, rm>(a);
+}
+
+template <Vfpu::RoundingMode rm>
+i32 X87Float::F80ToI32(f80 a) {
+  return F80ToI<i32, rm>(a);
+}
+
+template <Vfpu::RoundingMode rm>
+i64 X87Float::F80ToI64(f80 a) {
+  return F80ToI<i64, rm>(a);
+}
+
+f32 X87Float::F80ToF32(f80 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F80ToF32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F80ToF32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F80ToF32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F80ToF32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F80ToF32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+f64 X87Float::F80ToF64(f80 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F80ToF64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F80ToF64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F80ToF64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F80ToF64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F80ToF64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+i32 X87Float::F80ToI32(f80 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F80ToI32<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F80ToI32<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F80ToI32<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F80ToI32<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F80ToI32<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+i64 X87Float::F80ToI64(f80 a) {
+  switch (rounding_mode) {
+  case kRoundTiesToEven:
+    return F80ToI64<kRoundTiesToEven>(a);
+  case kRoundTiesToAway:
+    return F80ToI64<kRoundTiesToAway>(a);
+  case kRoundTowardPositive:
+    return F80ToI64<kRoundTowardPositive>(a);
+  case kRoundTowardNegative:
+    return F80ToI64<kRoundTowardNegative>(a);
+  case kRoundTowardZero:
+    return F80ToI64<kRoundTowardZero>(a);
+  default:
+    throw std::runtime_error(std::string("Unknown rounding mode"));
+  }
+}
+
+template f32 X87Float::F80ToF32<X87Float::kRoundTiesToEven>(f80 a);
+template f32 X87Float::F80ToF32<X87Float::kRoundTowardPositive>(f80 a);
+template f32 X87Float::F80ToF32<X87Float::kRoundTowardNegative>(f80 a);
+template f32 X87Float::F80ToF32<X87Float::kRoundTowardZero>(f80 a);
+template f32 X87Float::F80ToF32<X87Float::kRoundTiesToAway>(f80 a);
+
+template f64 X87Float::F80ToF64<X87Float::kRoundTiesToEven>(f80 a);
+template f64 X87Float::F80ToF64<X87Float::kRoundTowardPositive>(f80 a);
+template f64 X87Float::F80ToF64<X87Float::kRoundTowardNegative>(f80 a);
+template f64 X87Float::F80ToF64<X87Float::kRoundTowardZero>(f80 a);
+template f64 X87Float::F80ToF64<X87Float::kRoundTiesToAway>(f80 a);
+
+template i32 X87Float::F80ToI32<X87Float::kRoundTiesToEven>(f80 a);
+template i32 X87Float::F80ToI32<X87Float::kRoundTowardPositive>(f80 a);
+template i32 X87Float::F80ToI32<X87Float::kRoundTowardNegative>(f80 a);
+template i32 X87Float::F80ToI32<X87Float::kRoundTowardZero>(f80 a);
+template i32 X87Float::F80ToI32<X87Float::kRoundTiesToAway>(f80 a);
+
+template i64 X87Float::F80ToI64<X87Float::kRoundTiesToEven>(f80 a);
+template i64 X87Float::F80ToI64<X87Float::kRoundTowardPositive>(f80 a);
+template i64 X87Float::F80ToI64<X87Float::kRoundTowardNegative>(f80 a);
+template i64 X87Float::F80ToI64<X87Float::kRoundTowardZero>(f80 a);
+template i64 X87Float::F80ToI64<X87Float::kRoundTiesToAway>(f80 a);
@@ -0,0 +1,103 @@
+#pragma once
+/**************************************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ **************************************************************************************************/
+
+#include <utility>
+
+#include "utils.h"
+#include "vfpu.h"
+
+// Arithmetic of the x87 FPU on its 80-bit double extended format (see Intel SDM Vol. 1, Chapter 8).
+// Results are rounded to the precision selected by the PC field of the control word while keeping the 15-bit exponent
+// range. All exceptions are masked, so results are the masked responses. Stack faults are not modeled.
+// Add, Sub, Mul, and Div only use 128-bit integer arithmetic. On x86 hosts, "long double" is the very same format,
+// but host versions of them with exact residuals (TwoSum, Dekker's product) took 1.2 to 2 times as long.
+// Square roots are the exception and use the host as a fast path, which assumes that the host's x87 runs with its
+// default control word, i.e., round to nearest even and 64-bit precision.
+class X87Float : public Vfpu {
+ public:
+  // Encoding of the PC field.
+  enum PrecisionControl { kPrecision24 = 0, kPrecision53 = 2, kPrecision64 = 3 } precision_control;
+
+  bool denormal;  // Denormal operand exception (DE).
+  bool c1;        // Condition code C1: the last inexact result was rounded up in magnitude.
+
+  X87Float();
+
+  FfUtils::u16 GetFlagsX87();  // Exception flags in bits 0 to 5 and C1 in bit 9 of the status word.
+
+  void ClearFlags();
+
+  template <RoundingMode rm>
+  FfUtils::f80 Add(FfUtils::f80 a, FfUtils::f80 b);
+  FfUtils::f80 Add(FfUtils::f80 a, FfUtils::f80 b);
+
+  template <RoundingMode rm>
+  FfUtils::f80 Sub(FfUtils::f80 a, FfUtils::f80 b);
+  FfUtils::f80 Sub(FfUtils::f80 a, FfUtils::f80 b);
+
+  template <RoundingMode rm>
+  FfUtils::f80 Mul(FfUtils::f80 a, FfUtils::f80 b);
+  FfUtils::f80 Mul(FfUtils::f80 a, FfUtils::f80 b);
+
+  template <RoundingMode rm>
+  FfUtils::f80 Div(FfUtils::f80 a, FfUtils::f80 b);
+  FfUtils::f80 Div(FfUtils::f80 a, FfUtils::f80 b);
+
+  template <RoundingMode rm>
+  FfUtils::f80 Sqrt(FfUtils::f80 a);
+  FfUtils::f80 Sqrt(FfUtils::f80 a);
+
+  // Loads (FLD m32fp/m64fp and FILD) are exact.
+  FfUtils::f80 F32ToF80(FfUtils::f32 a);
+  FfUtils::f80 F64ToF80(FfUtils::f64 a);
+  FfUtils::f80 I32ToF80(FfUtils::i32 a);
+  FfUtils::f80 I64ToF80(FfUtils::i64 a);
+
+  // Stores (FST m32fp/m64fp and FIST) round to the destination format. Precision control does not apply.
+  // Storing a value rounded with 64-bit precision to f64 is the classic double rounding of x87 code.
+  template <RoundingMode rm>
+  FfUtils::f32 F80ToF32(FfUtils::f80 a);
+  FfUtils::f32 F80ToF32(FfUtils::f80 a);
+
+  template <RoundingMode rm>
+  FfUtils::f64 F80ToF64(FfUtils::f80 a);
+  FfUtils::f64 F80ToF64(FfUtils::f80 a);
+
+  template <RoundingMode rm>
+  FfUtils::i32 F80ToI32(FfUtils::f80 a);
+  FfUtils::i32 F80ToI32(FfUtils::f80 a);
+
+  template <RoundingMode rm>
+  FfUtils::i64 F80ToI64(FfUtils::f80 a);
+  FfUtils::i64 F80ToI64(FfUtils::f80 a);
+
+ private:
+  constexpr void SetDenormal() {
+    flags_dirty = (denormal == false);
+    denormal = true;
+  }
+
+  int PrecisionBits();
+
+  template <RoundingMode rm>
+  std::pair<FfUtils::i32, FfUtils::u128> Round(bool sign, FfUtils::i32 exp, FfUtils::u128 sig, int precision,
+                                               FfUtils::i32 max_exp);
+  template <RoundingMode rm>
+  FfUtils::f80 RoundPack(bool sign, FfUtils::i32 exp, FfUtils::u128 sig);
+  template <RoundingMode rm>
+  FfUtils::f80 RoundResidual(FfUtils::f80 r, long double residual);
+  template <typename FT, RoundingMode rm>
+  FT F80ToF(FfUtils::f80 a);
+  template <typename IT, RoundingMode rm>
+  IT F80ToI(FfUtils::f80 a);
+  template <typename FT>
+  FfUtils::f80 FToF80(FT a);
+
+  FfUtils::f80 PropagateNan(FfUtils::f80 a, FfUtils::f80 b);
+
+  template <RoundingMode rm>
+  FfUtils::f80 AddSub(FfUtils::f80 a, FfUtils::f80 b, bool negate_b);
+};
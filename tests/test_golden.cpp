@@ -10,9 +10,12 @@
 
 #include <array>
 #include <limits>
+#include <random>
 
 #include "floppy_float.h"
+#include "soft_float.h"
 #include "utils.h"
+#include "x87_float.h"
 
 using namespace FfUtils;
 
@@ -168,6 +171,616 @@ TEST(GoldenTests, MaximumNumberRiscvf64) {
   ASSERT_EQ(fpu.invalid, true);
 }
 
+TEST(GoldenTests, MinimumRiscvf32) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  const f32 qnanff = CreateQnanWithPayload<f32>(0xff);
+  const f32 snanff = CreateSnanWithPayload<f32>(0xff);
+  const f32 infinity = std::numeric_limits<f32>::infinity();
+  ASSERT_EQ(fpu.Minimum<f32>(1.0f32, 0.0f32), 0.f32);
+  ASSERT_EQ(fpu.Minimum<f32>(0.0f32, 1.0f32), 0.f32);
+  ASSERT_EQ(fpu.Minimum<f32>(-1.0f32, 0.0f32), -1.0f32);
+  ASSERT_EQ(fpu.Minimum<f32>(infinity, -infinity), -infinity);
+  ASSERT_EQ(fpu.Minimum<f32>(-infinity, infinity), -infinity);
+  ASSERT_EQ(fpu.Minimum<f32>(-infinity, -infinity), -infinity);
+  ASSERT_EQ(fpu.Minimum<f32>(infinity, infinity), infinity);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Minimum<f32>(-0.0f32, +0.0f32)), std::bit_cast<u32>(-0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Minimum<f32>(+0.0f32, -0.0f32)), std::bit_cast<u32>(-0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Minimum<f32>(-0.0f32, -0.0f32)), std::bit_cast<u32>(-0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Minimum<f32>(+0.0f32, +0.0f32)), std::bit_cast<u32>(+0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Minimum<f32>(qnanff, +5.0f32)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Minimum<f32>(+5.0f32, qnanff)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Minimum<f32>(qnanff, qnanff)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Minimum<f32>(snanff, +5.0f32)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(fpu.invalid, true);
+}
+
+TEST(GoldenTests, MaximumRiscvf32) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  const f32 qnanff = CreateQnanWithPayload<f32>(0xff);
+  const f32 snanff = CreateSnanWithPayload<f32>(0xff);
+  const f32 infinity = std::numeric_limits<f32>::infinity();
+  ASSERT_EQ(fpu.Maximum<f32>(1.0f32, 0.0f32), 1.f32);
+  ASSERT_EQ(fpu.Maximum<f32>(0.0f32, 1.0f32), 1.f32);
+  ASSERT_EQ(fpu.Maximum<f32>(-1.0f32, 0.0f32), 0.0f32);
+  ASSERT_EQ(fpu.Maximum<f32>(infinity, -infinity), infinity);
+  ASSERT_EQ(fpu.Maximum<f32>(-infinity, infinity), infinity);
+  ASSERT_EQ(fpu.Maximum<f32>(-infinity, -infinity), -infinity);
+  ASSERT_EQ(fpu.Maximum<f32>(infinity, infinity), infinity);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Maximum<f32>(-0.0f32, +0.0f32)), std::bit_cast<u32>(+0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Maximum<f32>(+0.0f32, -0.0f32)), std::bit_cast<u32>(+0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Maximum<f32>(-0.0f32, -0.0f32)), std::bit_cast<u32>(-0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Maximum<f32>(+0.0f32, +0.0f32)), std::bit_cast<u32>(+0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Maximum<f32>(qnanff, +5.0f32)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Maximum<f32>(+5.0f32, qnanff)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Maximum<f32>(qnanff, qnanff)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Maximum<f32>(snanff, +5.0f32)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(fpu.invalid, true);
+}
+
+TEST(GoldenTests, MinimumRiscvf64) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  const f64 qnanff = CreateQnanWithPayload<f64>(0xff);
+  const f64 snanff = CreateSnanWithPayload<f64>(0xff);
+  const f64 infinity = std::numeric_limits<f64>::infinity();
+  ASSERT_EQ(fpu.Minimum<f64>(1.0f64, 0.0f64), 0.f64);
+  ASSERT_EQ(fpu.Minimum<f64>(0.0f64, 1.0f64), 0.f64);
+  ASSERT_EQ(fpu.Minimum<f64>(-1.0f64, 0.0f64), -1.0f64);
+  ASSERT_EQ(fpu.Minimum<f64>(infinity, -infinity), -infinity);
+  ASSERT_EQ(fpu.Minimum<f64>(-infinity, infinity), -infinity);
+  ASSERT_EQ(fpu.Minimum<f64>(-infinity, -infinity), -infinity);
+  ASSERT_EQ(fpu.Minimum<f64>(infinity, infinity), infinity);
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Minimum<f64>(-0.0f64, +0.0f64)), std::bit_cast<u64>(-0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Minimum<f64>(+0.0f64, -0.0f64)), std::bit_cast<u64>(-0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Minimum<f64>(-0.0f64, -0.0f64)), std::bit_cast<u64>(-0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Minimum<f64>(+0.0f64, +0.0f64)), std::bit_cast<u64>(+0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Minimum<f64>(qnanff, +5.0f64)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Minimum<f64>(+5.0f64, qnanff)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Minimum<f64>(qnanff, qnanff)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Minimum<f64>(snanff, +5.0f64)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(fpu.invalid, true);
+}
+
+TEST(GoldenTests, MaximumRiscvf64) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  const f64 qnanff = CreateQnanWithPayload<f64>(0xff);
+  const f64 snanff = CreateSnanWithPayload<f64>(0xff);
+  const f64 infinity = std::numeric_limits<f64>::infinity();
+  ASSERT_EQ(fpu.Maximum<f64>(1.0f64, 0.0f64), 1.f64);
+  ASSERT_EQ(fpu.Maximum<f64>(0.0f64, 1.0f64), 1.f64);
+  ASSERT_EQ(fpu.Maximum<f64>(-1.0f64, 0.0f64), 0.0f64);
+  ASSERT_EQ(fpu.Maximum<f64>(infinity, -infinity), infinity);
+  ASSERT_EQ(fpu.Maximum<f64>(-infinity, infinity), infinity);
+  ASSERT_EQ(fpu.Maximum<f64>(-infinity, -infinity), -infinity);
+  ASSERT_EQ(fpu.Maximum<f64>(infinity, infinity), infinity);
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Maximum<f64>(-0.0f64, +0.0f64)), std::bit_cast<u64>(+0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Maximum<f64>(+0.0f64, -0.0f64)), std::bit_cast<u64>(+0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Maximum<f64>(-0.0f64, -0.0f64)), std::bit_cast<u64>(-0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Maximum<f64>(+0.0f64, +0.0f64)), std::bit_cast<u64>(+0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Maximum<f64>(qnanff, +5.0f64)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Maximum<f64>(+5.0f64, qnanff)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Maximum<f64>(qnanff, qnanff)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Maximum<f64>(snanff, +5.0f64)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(fpu.invalid, true);
+}
+
+TEST(GoldenTests, RoundToIntegralRiscvf32) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  const f32 qnanff = CreateQnanWithPayload<f32>(0xff);
+  const f32 snanff = CreateSnanWithPayload<f32>(0xff);
+  const f32 infinity = std::numeric_limits<f32>::infinity();
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToEven, false>(2.5f32)), 2.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToEven, false>(3.5f32)), 4.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToEven, false>(-2.5f32)), -2.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToAway, false>(2.5f32)), 3.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToAway, false>(-2.5f32)), -3.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTowardPositive, false>(2.25f32)), 3.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTowardPositive, false>(-2.25f32)), -2.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTowardNegative, false>(2.25f32)), 2.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTowardNegative, false>(-2.25f32)), -3.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTowardZero, false>(2.75f32)), 2.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTowardZero, false>(-2.75f32)), -2.0f32);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTowardZero, false>(infinity)), infinity);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTowardZero, false>(-infinity)), -infinity);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToEven, false>(-0.25f32)), std::bit_cast<u32>(-0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RoundToIntegral<f32, Vfpu::kRoundTowardPositive, false>(-0.75f32)), std::bit_cast<u32>(-0.0f32));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RoundToIntegral<f32, Vfpu::kRoundTowardNegative, false>(0.75f32)), std::bit_cast<u32>(+0.0f32));
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToEven, true>(4.0f32)), 4.0f32);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ((fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToEven, true>(4.5f32)), 4.0f32);
+  ASSERT_EQ(fpu.inexact, true);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToEven, true>(qnanff)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.RoundToIntegral<f32, Vfpu::kRoundTiesToEven, true>(snanff)), std::bit_cast<u32>(fpu.GetQnan<f32>()));
+  ASSERT_EQ(fpu.invalid, true);
+}
+
+TEST(GoldenTests, RoundToIntegralRiscvf64) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  const f64 qnanff = CreateQnanWithPayload<f64>(0xff);
+  const f64 snanff = CreateSnanWithPayload<f64>(0xff);
+  const f64 infinity = std::numeric_limits<f64>::infinity();
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToEven, false>(2.5f64)), 2.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToEven, false>(3.5f64)), 4.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToEven, false>(-2.5f64)), -2.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToAway, false>(2.5f64)), 3.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToAway, false>(-2.5f64)), -3.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTowardPositive, false>(2.25f64)), 3.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTowardPositive, false>(-2.25f64)), -2.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTowardNegative, false>(2.25f64)), 2.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTowardNegative, false>(-2.25f64)), -3.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTowardZero, false>(2.75f64)), 2.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTowardZero, false>(-2.75f64)), -2.0f64);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTowardZero, false>(infinity)), infinity);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTowardZero, false>(-infinity)), -infinity);
+  ASSERT_EQ(std::bit_cast<u64>(fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToEven, false>(-0.25f64)), std::bit_cast<u64>(-0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.RoundToIntegral<f64, Vfpu::kRoundTowardPositive, false>(-0.75f64)), std::bit_cast<u64>(-0.0f64));
+  ASSERT_EQ(std::bit_cast<u64>(fpu.RoundToIntegral<f64, Vfpu::kRoundTowardNegative, false>(0.75f64)), std::bit_cast<u64>(+0.0f64));
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToEven, true>(4.0f64)), 4.0f64);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ((fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToEven, true>(4.5f64)), 4.0f64);
+  ASSERT_EQ(fpu.inexact, true);
+  ASSERT_EQ(std::bit_cast<u64>(fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToEven, true>(qnanff)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(std::bit_cast<u64>(fpu.RoundToIntegral<f64, Vfpu::kRoundTiesToEven, true>(snanff)), std::bit_cast<u64>(fpu.GetQnan<f64>()));
+  ASSERT_EQ(fpu.invalid, true);
+}
+
+TEST(GoldenTests, FliRiscv) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  ASSERT_EQ(fpu.Fli<f32>(0), -1.0f32);
+  ASSERT_EQ(fpu.Fli<f32>(1), std::numeric_limits<f32>::min());
+  ASSERT_EQ(fpu.Fli<f64>(1), std::numeric_limits<f64>::min());
+  ASSERT_EQ(fpu.Fli<f32>(2), 0x1p-16f32);
+  ASSERT_EQ(fpu.Fli<f64>(9), 0.3125f64);
+  ASSERT_EQ(fpu.Fli<f64>(16), 1.0f64);
+  ASSERT_EQ(fpu.Fli<f64>(29), 65536.0f64);
+  ASSERT_EQ(fpu.Fli<f16>(29), std::numeric_limits<f16>::infinity());
+  ASSERT_EQ(fpu.Fli<f32>(30), std::numeric_limits<f32>::infinity());
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Fli<f32>(31)), 0x7fc00000u);
+  ASSERT_EQ(std::bit_cast<u64>(fpu.Fli<f64>(31)), 0x7ff8000000000000ull);
+  ASSERT_EQ(fpu.Fli<f32>(32), -1.0f32);  // Only the low 5 bits of the index are used.
+  fpu.SetQnan<f32>(0x7fc00001u);
+  ASSERT_EQ(std::bit_cast<u32>(fpu.Fli<f32>(63)), 0x7fc00001u);
+  ASSERT_EQ(fpu.division_by_zero, false);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(fpu.overflow, false);
+  ASSERT_EQ(fpu.underflow, false);
+}
+
+TEST(GoldenTests, F64ToI32ModularRiscv) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  ASSERT_EQ(fpu.F64ToI32Modular(-2147483648.0f64), std::numeric_limits<i32>::min());
+  ASSERT_EQ(fpu.F64ToI32Modular(2147483647.0f64), std::numeric_limits<i32>::max());
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ(fpu.F64ToI32Modular(-1.5f64), -1);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(fpu.inexact, true);
+  fpu.inexact = false;
+  ASSERT_EQ(fpu.F64ToI32Modular(2147483648.5f64), std::numeric_limits<i32>::min());
+  ASSERT_EQ(fpu.invalid, true);
+  ASSERT_EQ(fpu.inexact, false);
+  fpu.invalid = false;
+  ASSERT_EQ(fpu.F64ToI32Modular(0x1p64f64 + 0x1p12f64), 4096);
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.invalid = false;
+  ASSERT_EQ(fpu.F64ToI32Modular(-0x1p63f64 - 2048.0f64), -2048);
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.invalid = false;
+  ASSERT_EQ(fpu.F64ToI32Modular(-0x1p63f64), 0);
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.invalid = false;
+  ASSERT_EQ(fpu.F64ToI32Modular(0x1p63f64 + 0x1p32f64 + 0x1p31f64), std::numeric_limits<i32>::min());
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.invalid = false;
+  ASSERT_EQ(fpu.F64ToI32Modular(std::numeric_limits<f64>::max()), 0);
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.invalid = false;
+  ASSERT_EQ(fpu.F64ToI32Modular(std::numeric_limits<f64>::infinity()), 0);
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.invalid = false;
+  ASSERT_EQ(fpu.F64ToI32Modular(std::numeric_limits<f64>::quiet_NaN()), 0);
+  ASSERT_EQ(fpu.invalid, true);
+  ASSERT_EQ(fpu.inexact, false);
+}
+
+TEST(GoldenTests, CompareArmf32) {
+  FloppyFloat fpu;
+  fpu.SetupToArm();
+  const f32 qnanff = CreateQnanWithPayload<f32>(0xff);
+  const f32 snanff = CreateSnanWithPayload<f32>(0xff);
+  ASSERT_EQ((fpu.CompareArm<f32, false>(1.0f32, 2.0f32)), 0b1000);
+  ASSERT_EQ((fpu.CompareArm<f32, false>(-0.0f32, +0.0f32)), 0b0110);
+  ASSERT_EQ((fpu.CompareArm<f32, false>(2.0f32, 1.0f32)), 0b0010);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ((fpu.CompareArm<f32, false>(qnanff, 1.0f32)), 0b0011);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ((fpu.CompareArm<f32, false>(1.0f32, snanff)), 0b0011);
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.invalid = false;
+  ASSERT_EQ((fpu.CompareArm<f32, true>(qnanff, 1.0f32)), 0b0011);
+  ASSERT_EQ(fpu.invalid, true);
+  ASSERT_EQ(fpu.division_by_zero, false);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ(fpu.overflow, false);
+  ASSERT_EQ(fpu.underflow, false);
+}
+
+TEST(GoldenTests, CompareX86f64) {
+  FloppyFloat fpu;
+  fpu.SetupToX86();
+  const f64 qnanff = CreateQnanWithPayload<f64>(0xff);
+  const f64 snanff = CreateSnanWithPayload<f64>(0xff);
+  ASSERT_EQ((fpu.CompareX86<f64, false>(1.0f64, 2.0f64)), 0x01);
+  ASSERT_EQ((fpu.CompareX86<f64, false>(-0.0f64, +0.0f64)), 0x40);
+  ASSERT_EQ((fpu.CompareX86<f64, false>(2.0f64, 1.0f64)), 0x00);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ((fpu.CompareX86<f64, false>(qnanff, 1.0f64)), 0x45);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ((fpu.CompareX86<f64, false>(1.0f64, snanff)), 0x45);
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.invalid = false;
+  ASSERT_EQ((fpu.CompareX86<f64, true>(qnanff, 1.0f64)), 0x45);
+  ASSERT_EQ(fpu.invalid, true);
+  ASSERT_EQ(fpu.division_by_zero, false);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ(fpu.overflow, false);
+  ASSERT_EQ(fpu.underflow, false);
+}
+
+TEST(GoldenTests, EstimateRiscvf32) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  const f32 infinity = std::numeric_limits<f32>::infinity();
+  ASSERT_EQ(fpu.RecipEstimateRiscv<f32>(1.0f32), 0x1.fep-1f32);
+  ASSERT_EQ(fpu.RecipEstimateRiscv<f32>(-3.0f32), -0x1.54p-2f32);
+  ASSERT_EQ(fpu.RecipEstimateRiscv<f32>(0x1p127f32), 0x1.fep-128f32);
+  ASSERT_EQ(fpu.RecipEstimateRiscv<f32>(-infinity), -0.0f32);
+  ASSERT_EQ(fpu.RsqrtEstimateRiscv<f32>(1.0f32), 0x1.fep-1f32);
+  ASSERT_EQ(fpu.RsqrtEstimateRiscv<f32>(2.0f32), 0x1.68p-1f32);
+  ASSERT_EQ(fpu.RsqrtEstimateRiscv<f32>(infinity), 0.0f32);
+  ASSERT_EQ(fpu.division_by_zero, false);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(fpu.overflow, false);
+  ASSERT_EQ(fpu.underflow, false);
+  ASSERT_EQ(fpu.RecipEstimateRiscv<f32>(-0.0f32), -infinity);
+  ASSERT_EQ(fpu.division_by_zero, true);
+  ASSERT_TRUE(std::isnan(fpu.RsqrtEstimateRiscv<f32>(-1.0f32)));
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.rounding_mode = Vfpu::kRoundTowardZero;
+  ASSERT_EQ(fpu.RecipEstimateRiscv<f32>(0x1p-140f32), std::numeric_limits<f32>::max());
+  ASSERT_EQ(fpu.overflow, true);
+  ASSERT_EQ(fpu.inexact, true);
+}
+
+TEST(GoldenTests, EstimateArmf32) {
+  FloppyFloat fpu;
+  fpu.SetupToArm();
+  ASSERT_EQ(fpu.RecipEstimateArm<f32>(1.0f32), 0x1.ffp-1f32);
+  ASSERT_EQ(fpu.RecipEstimateArm<f32>(3.0f32), 0x1.55p-2f32);
+  ASSERT_EQ(fpu.RsqrtEstimateArm<f32>(2.0f32), 0x1.69p-1f32);
+  ASSERT_EQ(fpu.RsqrtEstimateArm<f32>(4.0f32), 0x1.ffp-2f32);
+  ASSERT_EQ(fpu.RecipExponentArm<f32>(3.0f32), 1.0f32);
+  ASSERT_EQ(fpu.RecipExponentArm<f32>(-0.0f32), -0x1p127f32);
+  ASSERT_EQ(fpu.RecipStepArm<f32>(1.5f32, 0.5f32), 1.25f32);
+  ASSERT_EQ(fpu.RsqrtStepArm<f32>(3.0f32, 1.0f32), 0.0f32);
+  ASSERT_EQ(fpu.RsqrtStepArm<f32>(0.5f32, 0.5f32), 1.375f32);
+  ASSERT_EQ(fpu.RecipStepArm<f32>(std::numeric_limits<f32>::infinity(), 0.0f32), 2.0f32);
+  ASSERT_EQ(fpu.RsqrtStepArm<f32>(-0.0f32, std::numeric_limits<f32>::infinity()), 1.5f32);
+  ASSERT_EQ(fpu.division_by_zero, false);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(fpu.overflow, false);
+  ASSERT_EQ(fpu.underflow, false);
+}
+
+TEST(GoldenTests, BF16Riscv) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16(1.0f32)), 0x3f80u);
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16(-0.0f32)), 0x8000u);
+  ASSERT_EQ(fpu.BF16ToF32(std::bit_cast<bf16>(static_cast<u16>(0xc0a0u))), -5.0f32);
+  ASSERT_EQ(fpu.BF16ToF32(std::bit_cast<bf16>(static_cast<u16>(0x0001u))), 0x1p-133f32);
+  ASSERT_EQ(fpu.FmaBF16(std::bit_cast<bf16>(static_cast<u16>(0x3fc0u)), std::bit_cast<bf16>(static_cast<u16>(0x4040u)), 1.0f32),
+            5.5f32);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16(0x1.018p0f32)), 0x3f81u);
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16(0x1.008p0f32)), 0x3f80u);
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16(0x1.7fp-127f32)), 0x0060u);
+  ASSERT_EQ(fpu.inexact, true);
+  ASSERT_EQ(fpu.underflow, true);
+  fpu.ClearFlags();
+  fpu.rounding_mode = Vfpu::kRoundTowardZero;
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16(std::numeric_limits<f32>::max())), 0x7f7fu);
+  ASSERT_EQ(fpu.overflow, false);
+  fpu.rounding_mode = Vfpu::kRoundTiesToEven;
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16(std::numeric_limits<f32>::max())), 0x7f80u);
+  ASSERT_EQ(fpu.overflow, true);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16(CreateSnanWithPayload<f32>(0xff))), 0x7fc0u);
+  ASSERT_EQ(fpu.invalid, true);
+  fpu.invalid = false;
+  ASSERT_EQ(std::bit_cast<u32>(fpu.BF16ToF32(std::bit_cast<bf16>(static_cast<u16>(0xff81u)))), 0x7fc00000u);
+  ASSERT_EQ(fpu.invalid, true);
+  ASSERT_EQ(fpu.division_by_zero, false);
+}
+
+// The static rounding mode must win over "rounding_mode", also in the cases that fall back to SoftFloat.
+TEST(GoldenTests, BF16StaticRoundingMode) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  fpu.rounding_mode = Vfpu::kRoundTiesToEven;
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16<Vfpu::kRoundTowardZero>(0x1.018p-126f32)), 0x0080u);
+  ASSERT_EQ(fpu.inexact, true);
+  ASSERT_EQ(fpu.underflow, false);
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16<Vfpu::kRoundTowardNegative>(-0x1.008p-126f32)), 0x8081u);
+  ASSERT_EQ(fpu.underflow, false);
+  fpu.ClearFlags();
+  fpu.rounding_mode = Vfpu::kRoundTowardZero;
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16<Vfpu::kRoundTiesToAway>(0x1.01p0f32)), 0x3f81u);
+  ASSERT_EQ(std::bit_cast<u16>(fpu.F32ToBF16<Vfpu::kRoundTiesToEven>(0x1.fffp-127f32)), 0x0080u);
+  ASSERT_EQ(fpu.underflow, false);
+  ASSERT_EQ(fpu.inexact, true);
+}
+
+TEST(GoldenTests, FmaTinyRoundDown) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  fpu.ClearFlags();
+  // -2**-150 + 2**-149 rounds to +0 downward, even though the signs of the product and the addend differ.
+  f32 result = fpu.Fma<f32, Vfpu::kRoundTowardNegative>(-0x1p-140f32, 0x1p-10f32, 0x1p-149f32);
+  ASSERT_EQ(std::bit_cast<u32>(result), 0x00000000u);
+  ASSERT_EQ(fpu.GetFlagsRiscv(), 0x03);
+  result = fpu.Fma<f32, Vfpu::kRoundTowardNegative>(-0x1p-140f32, 0x1p-9f32, 0x1p-149f32);
+  ASSERT_EQ(std::bit_cast<u32>(result), 0x80000000u);
+}
+
+TEST(GoldenTests, FmaWidenRiscv) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  fpu.ClearFlags();
+  f16 a = std::bit_cast<f16>(static_cast<u16>(0x3c01u));  // 1 + 2**-10
+  ASSERT_EQ((fpu.FmaWiden<f16, f32>(1.5f16, 3.0f16, 1.0f32)), 5.5f32);
+  ASSERT_EQ((fpu.FmaWiden<f16, f32>(a, a, -1.0f32)), 0x1.002p-9f32);  // The product is not rounded to f16.
+  ASSERT_EQ((fpu.FmaWiden<f32, f64>(0x1.000002p0f32, 0x1.000002p0f32, -1.0f64)), 0x1p-22f64 + 0x1p-46f64);
+  ASSERT_EQ(fpu.GetFlagsRiscv(), 0x00);
+  ASSERT_EQ((fpu.FmaWiden<f16, f32>(a, a, 0x1p24f32)), 0x1.000002p24f32);
+  ASSERT_EQ(fpu.GetFlagsRiscv(), 0x01);
+  fpu.rounding_mode = Vfpu::kRoundTowardZero;
+  ASSERT_EQ((fpu.FmaWiden<f16, f32>(a, a, 0x1p24f32)), 0x1p24f32);
+  ASSERT_EQ((fpu.FmaWiden<bf16, f32>(std::bit_cast<bf16>(static_cast<u16>(0x7f7fu)),
+                                     std::bit_cast<bf16>(static_cast<u16>(0x7f7fu)), 0.0f32)),
+            std::numeric_limits<f32>::max());
+  ASSERT_EQ(fpu.GetFlagsRiscv(), 0x05);
+  fpu.ClearFlags();
+  fpu.rounding_mode = Vfpu::kRoundTiesToEven;
+  f16 inf = std::numeric_limits<f16>::infinity();
+  ASSERT_EQ(std::bit_cast<u32>(fpu.FmaWiden<f16, f32>(inf, 0.0f16, 1.0f32)), 0x7fc00000u);
+  ASSERT_EQ(fpu.GetFlagsRiscv(), 0x10);
+  fpu.ClearFlags();
+  ASSERT_EQ((fpu.FmaWiden<f16, f32>(inf, 1.0f16, 1.0f32)), std::numeric_limits<f32>::infinity());
+  ASSERT_EQ(fpu.GetFlagsRiscv(), 0x00);
+  f16 snan = std::bit_cast<f16>(static_cast<u16>(0x7d00u));
+  ASSERT_EQ(std::bit_cast<u32>(fpu.FmaWiden<f16, f32>(snan, 1.0f16, 0.0f32)), 0x7fc00000u);
+  ASSERT_EQ(fpu.GetFlagsRiscv(), 0x10);
+}
+
+// The exact product path must match the FMA on widened operands.
+TEST(GoldenTests, FmaWidenX86) {
+  FloppyFloat fpu, ref;
+  fpu.SetupToX86();
+  ref.SetupToX86();
+  std::mt19937 rng(42);
+  for (Vfpu::RoundingMode rm : {Vfpu::kRoundTiesToEven, Vfpu::kRoundTiesToAway, Vfpu::kRoundTowardPositive,
+                                Vfpu::kRoundTowardNegative, Vfpu::kRoundTowardZero}) {
+    fpu.rounding_mode = rm;
+    ref.rounding_mode = rm;
+    for (int i = 0; i < 100000; ++i) {
+      f16 a = std::bit_cast<f16>(static_cast<u16>(rng()));
+      f16 b = std::bit_cast<f16>(static_cast<u16>(rng()));
+      u32 exp = 90 + rng() % 80;  // Around the product exponents.
+      f32 c = std::bit_cast<f32>(static_cast<u32>((rng() & 0x807fffffu) | (exp << 23)));
+      fpu.ClearFlags();
+      ref.ClearFlags();
+      f32 result = fpu.FmaWiden<f16, f32>(a, b, c);
+      f32 ref_result = ref.Fma<f32>(ref.F16ToF32(a), ref.F16ToF32(b), c);
+      ASSERT_EQ(std::bit_cast<u32>(result), std::bit_cast<u32>(ref_result)) << "rm: " << rm << ", i: " << i;
+      ASSERT_EQ(fpu.GetFlagsX86(), ref.GetFlagsX86()) << "rm: " << rm << ", i: " << i;
+    }
+  }
+}
+
+TEST(GoldenTests, Fp8) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  const f32 infinity = std::numeric_limits<f32>::infinity();
+  ASSERT_EQ(fpu.Fp8ToF32(fp8e4m3{0x7e}), 448.0f32);
+  ASSERT_EQ(fpu.Fp8ToF32(fp8e4m3{0x01}), 0x1p-9f32);
+  ASSERT_EQ(fpu.Fp8ToF32(fp8e5m2{0x7b}), 57344.0f32);
+  ASSERT_EQ(fpu.Fp8ToF32(fp8e5m2{0xfc}), -infinity);
+  ASSERT_EQ((fpu.FToFp8<fp8e4m3, true, f32>(1.0f32).v), 0x38u);
+  ASSERT_EQ((fpu.FToFp8<fp8e5m2, true, f16>(-1.5f16).v), 0xbeu);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ((fpu.FToFp8<fp8e4m3, true, f32>(1.0625f32).v), 0x38u);  // Tie to even.
+  ASSERT_EQ((fpu.FToFp8<fp8e4m3, true, f32>(1.1875f32).v), 0x3au);
+  ASSERT_EQ((fpu.FToFp8Stochastic<fp8e4m3, true, f32>(1.0625f32, 0x7fffffffu).v), 0x38u);
+  ASSERT_EQ((fpu.FToFp8Stochastic<fp8e4m3, true, f32>(1.0625f32, 0x80000000u).v), 0x39u);
+  ASSERT_EQ(fpu.inexact, true);
+  ASSERT_EQ(fpu.overflow, false);
+  ASSERT_EQ((fpu.FToFp8<fp8e4m3, true, f32>(500.0f32).v), 0x7eu);
+  ASSERT_EQ((fpu.FToFp8<fp8e4m3, false, f32>(500.0f32).v), 0x7fu);
+  ASSERT_EQ((fpu.FToFp8<fp8e5m2, false, f32>(-65536.0f32).v), 0xfcu);
+  ASSERT_EQ(fpu.overflow, true);
+  ASSERT_EQ((fpu.FToFp8<fp8e5m2, true, f32>(infinity).v), 0x7bu);
+  ASSERT_EQ(fpu.underflow, false);
+  ASSERT_EQ((fpu.FToFp8<fp8e4m3, true, f32>(0x1.8p-10f32).v), 0x01u);
+  ASSERT_EQ(fpu.underflow, true);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ((fpu.FToFp8<fp8e4m3, true, f32>(CreateSnanWithPayload<f32>(0xff)).v), 0x7fu);
+  ASSERT_EQ(fpu.invalid, true);
+  ASSERT_EQ(fpu.division_by_zero, false);
+}
+
+TEST(GoldenTests, Tf32Riscv) {
+  FloppyFloat fpu;
+  fpu.SetupToRiscv();
+  ASSERT_EQ((fpu.FToF<f32, tf32>(1.5f32).v), 0x1fe00u);
+  ASSERT_EQ((fpu.FToF<tf32, f32>(tf32{0x1fe00})), 1.5f32);
+  ASSERT_EQ(fpu.FormatAdd(tf32{0x1fe00}, tf32{0x1fe00}).v, 0x20200u);
+  ASSERT_EQ(fpu.FormatFma(tf32{0x1fe00}, tf32{0x1fe00}, tf32{0x60080}).v, 0x00000u);
+  ASSERT_EQ(fpu.inexact, false);
+  ASSERT_EQ((fpu.FToF<f32, tf32>(0x1.002p0f32).v), 0x1fc00u);  // Tie to even.
+  ASSERT_EQ((fpu.FToF<f32, tf32>(0x1.006p0f32).v), 0x1fc02u);
+  ASSERT_EQ(fpu.FormatMul(tf32{0x1fc01}, tf32{0x1fc01}).v, 0x1fc02u);
+  ASSERT_EQ(fpu.inexact, true);
+  ASSERT_EQ(fpu.FormatDiv(tf32{0x1fc00}, tf32{0x00000}).v, 0x3fc00u);
+  ASSERT_EQ(fpu.division_by_zero, true);
+  ASSERT_EQ(fpu.invalid, false);
+  ASSERT_EQ(fpu.FormatSqrt(tf32{0x5fc00}).v, 0x3fe00u);
+  ASSERT_EQ(fpu.invalid, true);
+}
+
+// Reference for the generic formats: SoftFloat computes in f128, which is exact for all operations except for some sums
+// of tf32 as well as divisions and square roots. These are rounded to odd with 113 bits. SoftFloat::FToF then rounds
+// once to the format. Exact results are computed in the target rounding mode for the sign of zero sums.
+template <typename FT, typename OP>
+FT FormatReference(SoftFloat& sf, Vfpu::RoundingMode rm, OP op) {
+  sf.rounding_mode = Vfpu::kRoundTowardZero;
+  f128 r = op();
+  if (sf.inexact) {
+    r = std::bit_cast<f128>(std::bit_cast<FloatToUint<f128>::type>(r) | 1);
+  } else {
+    sf.rounding_mode = rm;
+    r = op();
+  }
+  sf.inexact = false;
+  sf.rounding_mode = rm;
+  return sf.FToF<f128, FT>(r);
+}
+
+enum FormatOp { kFormatAdd, kFormatSub, kFormatMul, kFormatDiv, kFormatSqrt, kFormatFma };
+
+template <typename FT>
+void CheckFormatOp(Vfpu::RoundingMode rm, FormatOp op, FT a, FT b, FT c) {
+  FloppyFloat ff;
+  SoftFloat sf;
+  ff.SetupToRiscv();
+  sf.SetupToRiscv();
+  ff.rounding_mode = rm;
+  ff.ClearFlags();
+  sf.ClearFlags();
+  constexpr int kM = NumSignificandBits<FT>();
+  constexpr u64 kExpMask = (1ull << NumExponentBits<FT>()) - 1;
+  auto wide = [&sf](FT x) { return sf.F64ToF128(sf.FToF<FT, f64>(x)); };
+  auto is_snan = [](FT x) {
+    return ((x.v >> kM) & kExpMask) == kExpMask && (x.v & ((1ull << kM) - 1)) && !((x.v >> (kM - 1)) & 1);
+  };
+  f128 wa = wide(a);
+  f128 wb = wide(b);
+  f128 wc = wide(c);
+  sf.ClearFlags();  // Widening quiets signaling NaNs, so their invalid flag is added explicitly.
+  bool snan = is_snan(a) || (op != kFormatSqrt && is_snan(b)) || (op == kFormatFma && is_snan(c));
+  FT res, ref;
+  switch (op) {
+  case kFormatAdd:
+    res = ff.FormatAdd<FT>(a, b);
+    ref = FormatReference<FT>(sf, rm, [&] { return sf.Add<f128>(wa, wb); });
+    break;
+  case kFormatSub:
+    res = ff.FormatSub<FT>(a, b);
+    ref = FormatReference<FT>(sf, rm, [&] { return sf.Sub<f128>(wa, wb); });
+    break;
+  case kFormatMul:
+    res = ff.FormatMul<FT>(a, b);
+    ref = FormatReference<FT>(sf, rm, [&] { return sf.Mul<f128>(wa, wb); });
+    break;
+  case kFormatDiv:
+    res = ff.FormatDiv<FT>(a, b);
+    ref = FormatReference<FT>(sf, rm, [&] { return sf.Div<f128>(wa, wb); });
+    break;
+  case kFormatSqrt:
+    res = ff.FormatSqrt<FT>(a);
+    ref = FormatReference<FT>(sf, rm, [&] { return sf.Sqrt<f128>(wa); });
+    break;
+  default:
+    res = ff.FormatFma<FT>(a, b, c);
+    ref = FormatReference<FT>(sf, rm, [&] { return sf.Fma<f128>(wa, wb, wc); });
+    break;
+  }
+  sf.invalid |= snan;
+  ASSERT_EQ(res.v, ref.v) << "Op: " << op << " RM: " << rm << " Operands: " << a.v << " " << b.v << " " << c.v;
+  ASSERT_EQ(ff.GetFlagsRiscv(), sf.GetFlagsRiscv())
+      << "Op: " << op << " RM: " << rm << " Operands: " << a.v << " " << b.v << " " << c.v;
+}
+
+// Random encodings, biased toward zeros, subnormals, the largest exponents, and sums that cancel.
+template <typename FT>
+FT RandomFormatValue(std::mt19937_64& rng) {
+  constexpr int kE = NumExponentBits<FT>();
+  constexpr int kM = NumSignificandBits<FT>();
+  using UT = decltype(FT::v);
+  UT bits = static_cast<UT>(rng() & ((1ull << (1 + kE + kM)) - 1));
+  if (rng() % 4 == 0) {
+    constexpr std::array<u64, 6> kExps = {0, 1, 2, (1ull << kE) - 3, (1ull << kE) - 2, (1ull << kE) - 1};
+    u64 exp = kExps[rng() % kExps.size()];
+    bits = static_cast<UT>((bits & ~(((1ull << kE) - 1) << kM)) | (exp << kM));
+  }
+  return FT{bits};
+}
+
+constexpr std::array<Vfpu::RoundingMode, 5> kFormatRoundingModes = {
+    Vfpu::kRoundTiesToEven, Vfpu::kRoundTiesToAway, Vfpu::kRoundTowardPositive, Vfpu::kRoundTowardNegative,
+    Vfpu::kRoundTowardZero};
+
+// With "enumerate", the first operand runs through all encodings of the format.
+template <typename FT>
+void TestFormatRandom(u64 num_samples, bool enumerate) {
+  using UT = decltype(FT::v);
+  constexpr u64 kSignBit = 1ull << (NumExponentBits<FT>() + NumSignificandBits<FT>());
+  std::mt19937_64 rng(42);
+  FloppyFloat ff;
+  for (Vfpu::RoundingMode rm : kFormatRoundingModes) {
+    for (int op = kFormatAdd; op <= kFormatFma; ++op) {
+      for (u64 i = 0; i < num_samples; ++i) {
+        FT a = enumerate ? FT{static_cast<UT>(i)} : RandomFormatValue<FT>(rng);
+        FT b = RandomFormatValue<FT>(rng);
+        FT c = RandomFormatValue<FT>(rng);
+        if (i % 8 == 0)  // Operands that (nearly) cancel.
+          b = FT{static_cast<UT>((op == kFormatSub ? a.v : a.v ^ kSignBit) ^ (rng() % 4))};
+        if (op == kFormatFma && i % 8 == 1)
+          c = FT{static_cast<UT>(ff.FormatMul<FT>(a, b).v ^ kSignBit ^ (rng() % 4))};
+        CheckFormatOp<FT>(rm, static_cast<FormatOp>(op), a, b, c);
+        if (::testing::Test::HasFatalFailure())
+          return;
+      }
+    }
+  }
+}
+
+TEST(GoldenTests, Dlf16Random) {
+  TestFormatRandom<dlf16>(1ull << 16, true);
+}
+
+TEST(GoldenTests, Tf32Random) {
+  TestFormatRandom<tf32>(1ull << 17, false);
+}
+
 TEST(GoldenTests, ClassRiscvf32) {
   FloppyFloat fpu;
   fpu.SetupToRiscv();
@@ -214,6 +827,72 @@ TEST(GoldenTests, ClassRiscvf64) {
   ASSERT_EQ(fpu.underflow, false);
 }
 
+TEST(GoldenTests, X87) {
+  X87Float fpu;
+  const f80 one{0x8000000000000000ull, 0x3fff};
+  const f80 zero{0, 0};
+  const f80 denorm_min{1, 0};
+  const f80 unnormal{0x4000000000000000ull, 0x3fff};
+  const f80 indefinite{0xc000000000000000ull, 0xffff};
+
+  // Precision control rounds to 53 bits, but keeps the extended exponent range.
+  fpu.precision_control = X87Float::kPrecision53;
+  f80 result = fpu.Add<Vfpu::kRoundTowardPositive>(one, f80{0x8000000000000000ull, 0x3fff - 70});
+  ASSERT_EQ(result.significand, 0x8000000000000800ull);
+  ASSERT_EQ(result.sign_exponent, 0x3fff);
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x220);  // PE and C1 (rounded up)
+  fpu.ClearFlags();
+  fpu.precision_control = X87Float::kPrecision64;
+
+  // Denormal operands raise DE, unless a NaN, invalid, or division by zero takes priority.
+  result = fpu.Add(one, denorm_min);
+  ASSERT_EQ(result.significand, one.significand);
+  ASSERT_EQ(result.sign_exponent, one.sign_exponent);
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x22);  // DE and PE
+  fpu.ClearFlags();
+  result = fpu.Mul(zero, denorm_min);
+  ASSERT_EQ(result.significand, 0);
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x02);  // DE
+  fpu.ClearFlags();
+  result = fpu.Div(denorm_min, zero);
+  ASSERT_EQ(result.significand, 0x8000000000000000ull);
+  ASSERT_EQ(result.sign_exponent, 0x7fff);
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x04);  // ZE
+  fpu.ClearFlags();
+
+  // Loads of denormals raise DE, stores do not.
+  fpu.F64ToF80(std::numeric_limits<f64>::denorm_min());
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x02);  // DE
+  fpu.ClearFlags();
+  ASSERT_EQ(fpu.F80ToF64(denorm_min), 0.0);
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x30);  // UE and PE
+  fpu.ClearFlags();
+
+  // Unsupported encodings are invalid operands.
+  result = fpu.Add(unnormal, one);
+  ASSERT_EQ(result.significand, indefinite.significand);
+  ASSERT_EQ(result.sign_exponent, indefinite.sign_exponent);
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x01);  // IE
+  fpu.ClearFlags();
+
+  // A quiet NaN wins over a signaling one. Otherwise, the larger significand wins and a tie goes to the positive NaN.
+  const f80 snan{0xbfffffffffffffffull, 0x7fff};
+  const f80 qnan{0xc000000000000001ull, 0xffff};
+  result = fpu.Add(snan, qnan);
+  ASSERT_EQ(result.significand, qnan.significand);
+  ASSERT_EQ(result.sign_exponent, qnan.sign_exponent);
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x01);  // IE
+  fpu.ClearFlags();
+  result = fpu.Sub(qnan, f80{0xc000000000000002ull, 0x7fff});
+  ASSERT_EQ(result.significand, 0xc000000000000002ull);
+  ASSERT_EQ(result.sign_exponent, 0x7fff);
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x00);
+  result = fpu.Mul(qnan, f80{qnan.significand, 0x7fff});
+  ASSERT_EQ(result.significand, qnan.significand);
+  ASSERT_EQ(result.sign_exponent, 0x7fff);
+  ASSERT_EQ(fpu.GetFlagsX87(), 0x00);
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <random>
+#include <vector>
+
+#include "floppy_float.h"
+#include "utils.h"
+
+using namespace FfUtils;
+
+constexpr std::array<Vfpu::RoundingMode, 5> kRoundingModes = {
+    Vfpu::kRoundTiesToEven, Vfpu::kRoundTiesToAway, Vfpu::kRoundTowardPositive, Vfpu::kRoundTowardNegative,
+    Vfpu::kRoundTowardZero};
+
+constexpr size_t kNumRandomInputs = 200000;
+
+// Special values and their neighbors followed by random encodings.
+std::vector<u16> F16Inputs() {
+  std::vector<u16> inputs;
+  for (u16 special : {0x0000, 0x0001, 0x03ff, 0x0400, 0x3c00, 0x3bff, 0x3c01, 0x7bff, 0x7c00, 0x7c01, 0x7e00}) {
+    inputs.push_back(special);
+    inputs.push_back(special | 0x8000);
+  }
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<u32> dist(0, 0xffff);
+  for (size_t i = 0; i < kNumRandomInputs; ++i)
+    inputs.push_back(static_cast<u16>(dist(rng)));
+  return inputs;
+}
+
+// Compares every host implementation of the f16 operations with the one without instruction set extensions.
+template <typename FUNC>
+void DoHostTest(FUNC func) {
+  std::vector<u16> inputs = F16Inputs();
+  for (int host = FloppyFloat::kHostF16F16c; host <= FloppyFloat::DetectHostF16(); ++host) {
+    for (bool riscv : {false, true}) {
+      FloppyFloat ff, ref;
+      if (riscv) {
+        ff.SetupToRiscv();
+        ref.SetupToRiscv();
+      } else {
+        ff.SetupToX86();
+        ref.SetupToX86();
+      }
+      ff.SetHostF16(static_cast<FloppyFloat::HostF16>(host));
+      ref.SetHostF16(FloppyFloat::kHostF16None);
+      for (Vfpu::RoundingMode rm : kRoundingModes) {
+        ff.rounding_mode = rm;
+        ref.rounding_mode = rm;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+          f16 a = std::bit_cast<f16>(inputs[i]);
+          f16 b = std::bit_cast<f16>(inputs[(i * 7919) % inputs.size()]);
+          ff.ClearFlags();
+          ref.ClearFlags();
+          auto result = func(ff, a, b);
+          auto ref_result = func(ref, a, b);
+          ASSERT_EQ(result, ref_result) << "Host: " << host << ", rm: " << rm << ", input: " << i;
+          ASSERT_EQ(ff.GetFlagsRiscv(), ref.GetFlagsRiscv()) << "Host: " << host << ", rm: " << rm << ", input: " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(HostF16Tests, Add) {
+  DoHostTest([](FloppyFloat& ff, f16 a, f16 b) { return std::bit_cast<u16>(ff.Add<f16>(a, b)); });
+}
+
+TEST(HostF16Tests, Sub) {
+  DoHostTest([](FloppyFloat& ff, f16 a, f16 b) { return std::bit_cast<u16>(ff.Sub<f16>(a, b)); });
+}
+
+TEST(HostF16Tests, Mul) {
+  DoHostTest([](FloppyFloat& ff, f16 a, f16 b) { return std::bit_cast<u16>(ff.Mul<f16>(a, b)); });
+}
+
+TEST(HostF16Tests, Div) {
+  DoHostTest([](FloppyFloat& ff, f16 a, f16 b) { return std::bit_cast<u16>(ff.Div<f16>(a, b)); });
+}
+
+TEST(HostF16Tests, Sqrt) {
+  DoHostTest([](FloppyFloat& ff, f16 a, f16) { return std::bit_cast<u16>(ff.Sqrt<f16>(a)); });
+}
+
+TEST(HostF16Tests, F16ToF32) {
+  DoHostTest([](FloppyFloat& ff, f16 a, f16) { return std::bit_cast<u32>(ff.F16ToF32(a)); });
+}
+
+// Every other addend is the negated and rounded product, so that the exact residual is all that remains.
+TEST(HostF16Tests, Fma) {
+  DoHostTest([](FloppyFloat& ff, f16 a, f16 b) {
+    u16 bits_a = std::bit_cast<u16>(a);
+    u16 bits_b = std::bit_cast<u16>(b);
+    f16 c = (bits_b & 1u) ? static_cast<f16>(-(static_cast<f32>(a) * static_cast<f32>(b)))
+                          : std::bit_cast<f16>(static_cast<u16>(bits_a ^ (bits_b << 1)));
+    return std::bit_cast<u16>(ff.Fma<f16>(a, b, c));
+  });
+}
+
+// Inputs are f32 values close to f16 values, including the halfway cases.
+TEST(HostF16Tests, F32ToF16) {
+  DoHostTest(
+      [](FloppyFloat& ff, f16 a, f16 b) {
+        u32 offset = (std::bit_cast<u16>(b) & 0x3fffu) - 0x2000u;
+        u32 bits = std::bit_cast<u32>(static_cast<f32>(a)) + offset;
+        return std::bit_cast<u16>(ff.F32ToF16(std::bit_cast<f32>(bits)));
+      });
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -29,6 +29,7 @@ TEST(InvalidTests, RoundingMode) {
   ASSERT_THROW(fpu.Div<f32>(a, b), std::runtime_error);
   ASSERT_THROW(fpu.Sqrt<f32>(a), std::runtime_error);
   ASSERT_THROW(fpu.Fma<f32>(a, b, c), std::runtime_error);
+  ASSERT_THROW((fpu.RoundToIntegral<f32, true>(a)), std::runtime_error);
   ASSERT_NO_THROW(fpu.EqQuiet<f32>(a, b));
   ASSERT_NO_THROW(fpu.LeQuiet<f32>(a, b));
   ASSERT_NO_THROW(fpu.LtQuiet<f32>(a, b));
@@ -37,6 +38,8 @@ TEST(InvalidTests, RoundingMode) {
   ASSERT_NO_THROW(fpu.LtSignaling<f32>(a, b));
   ASSERT_NO_THROW(fpu.MinimumNumber<f32>(a, b));
   ASSERT_NO_THROW(fpu.MaximumNumber<f32>(a, b));
+  ASSERT_NO_THROW(fpu.Minimum<f32>(a, b));
+  ASSERT_NO_THROW(fpu.Maximum<f32>(a, b));
   ASSERT_NO_THROW(fpu.Minx86<f32>(a, b));
   ASSERT_NO_THROW(fpu.Maxx86<f32>(a, b));
   ASSERT_NO_THROW(fpu.F16ToF32((f16)a));
@@ -0,0 +1,249 @@
+/*******************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cmath>
+
+#include "floppy_float.h"
+#include "lut_float.h"
+#include "utils.h"
+
+using namespace FfUtils;
+
+constexpr std::array<Vfpu::RoundingMode, 5> kRoundingModes = {
+    Vfpu::kRoundTiesToEven, Vfpu::kRoundTiesToAway, Vfpu::kRoundTowardPositive, Vfpu::kRoundTowardNegative,
+    Vfpu::kRoundTowardZero};
+
+enum Profile { kArm, kRiscv, kX86 };
+
+template <typename FPU>
+void Setup(FPU& fpu, Profile profile) {
+  switch (profile) {
+  case kArm:
+    fpu.SetupToArm();
+    break;
+  case kRiscv:
+    fpu.SetupToRiscv();
+    break;
+  case kX86:
+    fpu.SetupToX86();
+    break;
+  }
+}
+
+// Compares the table lookups with the computed path for all f16 inputs.
+template <typename LUTFUNC, typename FFFUNC>
+void DoExhaustiveTest(LUTFUNC lut_func, FFFUNC ff_func) {
+  for (Profile profile : {kArm, kRiscv, kX86}) {
+    LutFloat lut;
+    FloppyFloat ff;
+    Setup(lut, profile);
+    Setup(ff, profile);
+    for (Vfpu::RoundingMode rm : kRoundingModes) {
+      lut.rounding_mode = rm;
+      ff.rounding_mode = rm;
+      for (u32 i = 0; i < (1u << 16); ++i) {
+        f16 a = std::bit_cast<f16>(static_cast<u16>(i));
+        lut.ClearFlags();
+        ff.ClearFlags();
+        auto lut_result = lut_func(lut, a);
+        auto ff_result = ff_func(ff, a);
+        ASSERT_EQ(lut_result, ff_result) << "Profile: " << profile << ", rm: " << rm << ", input: " << i;
+        ASSERT_EQ(lut.GetFlagsRiscv(), ff.GetFlagsRiscv())
+          << "Profile: " << profile << ", rm: " << rm << ", input: " << i;
+      }
+    }
+  }
+}
+
+template <typename T>
+auto Bits(T a) {
+  if constexpr (std::is_floating_point_v<T>)
+    return std::bit_cast<typename FloatToUint<T>::type>(a);
+  else
+    return a;
+}
+
+#define LUT_TEST(name, call)                                                                         \
+  TEST(LutFloatTests, name) {                                                                        \
+    DoExhaustiveTest([](LutFloat& fpu, f16 a) { return Bits(fpu.call); },                            \
+                     [](FloppyFloat& fpu, f16 a) { return Bits(fpu.call); });                        \
+  }
+
+LUT_TEST(Sqrtf16, Sqrt<f16>(a))
+LUT_TEST(RecipEstimateRiscvf16, RecipEstimateRiscv<f16>(a))
+LUT_TEST(RsqrtEstimateRiscvf16, RsqrtEstimateRiscv<f16>(a))
+LUT_TEST(RecipEstimateArmf16, RecipEstimateArm<f16>(a))
+LUT_TEST(RsqrtEstimateArmf16, RsqrtEstimateArm<f16>(a))
+LUT_TEST(Classf16, Class<f16>(a))
+LUT_TEST(F16ToF32, F16ToF32(a))
+LUT_TEST(F16ToF64, F16ToF64(a))
+LUT_TEST(F16ToI32, F16ToI32(a))
+LUT_TEST(F16ToI64, F16ToI64(a))
+LUT_TEST(F16ToU32, F16ToU32(a))
+LUT_TEST(F16ToU64, F16ToU64(a))
+
+// Building a table must neither lose nor add flags of the caller.
+TEST(LutFloatTests, FlagsPreserved) {
+  LutFloat lut;
+  lut.SetupToRiscv();
+  lut.ClearFlags();
+  lut.overflow = true;
+  ASSERT_EQ(std::bit_cast<u16>(lut.Sqrt<f16>(4.0f16)), std::bit_cast<u16>(2.0f16));
+  ASSERT_EQ(lut.GetFlagsRiscv(), 0x04);
+  lut.Sqrt<f16>(2.0f16);
+  ASSERT_EQ(lut.GetFlagsRiscv(), 0x05);
+}
+
+// A new profile rebuilds the tables, e.g., with another default NaN.
+TEST(LutFloatTests, ProfileChange) {
+  LutFloat lut;
+  lut.SetupToRiscv();
+  ASSERT_EQ(std::bit_cast<u16>(lut.Sqrt<f16>(-1.0f16)), 0x7e00);
+  lut.SetupToX86();
+  ASSERT_EQ(std::bit_cast<u16>(lut.Sqrt<f16>(-1.0f16)), 0xfe00);
+  lut.SetQnan<f16>(0x7e01);
+  ASSERT_EQ(std::bit_cast<u16>(lut.Sqrt<f16>(-1.0f16)), 0x7e01);
+}
+
+// The rounding mode indexes the tables, so invalid values must throw like in the other classes.
+TEST(LutFloatTests, InvalidRoundingMode) {
+  LutFloat lut;
+  lut.SetupToRiscv();
+  lut.rounding_mode = (Vfpu::RoundingMode)-1;
+  ASSERT_THROW(lut.Sqrt<f16>(2.0f16), std::runtime_error);
+  ASSERT_THROW(lut.RecipEstimateRiscv<f16>(2.0f16), std::runtime_error);
+  ASSERT_THROW(lut.RsqrtEstimateRiscv<f16>(2.0f16), std::runtime_error);
+  ASSERT_THROW(lut.RecipEstimateArm<f16>(2.0f16), std::runtime_error);
+  ASSERT_THROW(lut.RsqrtEstimateArm<f16>(2.0f16), std::runtime_error);
+}
+
+// Reference for the FP8 arithmetic: rounds the exact result to nearest even by searching all encodings.
+template <typename FP8>
+u8 NearestFp8(f64 r, bool saturate) {
+  using Format = MiniFloatFormat<FP8>;
+  FloppyFloat ff;
+  u8 sign = std::signbit(r) ? 0x80 : 0x00;
+  f64 max = ff.Fp8ToF32(FP8{Format::kMaxCode});
+  f64 half_ulp = (max - ff.Fp8ToF32(FP8{static_cast<u8>(Format::kMaxCode - 1)})) / 2;
+  bool max_is_even = (Format::kMaxCode & 1) == 0;
+  if (std::abs(r) > max + half_ulp || (std::abs(r) == max + half_ulp && !max_is_even))
+    return sign | (saturate ? Format::kMaxCode : Format::kOverflowCode);
+  u8 best = 0;
+  for (u8 code = 1; code <= Format::kMaxCode; ++code) {
+    f64 best_error = std::abs(std::abs(r) - ff.Fp8ToF32(FP8{best}));
+    f64 error = std::abs(std::abs(r) - ff.Fp8ToF32(FP8{code}));
+    if (error < best_error || (error == best_error && (code & 1) == 0))
+      best = code;
+  }
+  return sign | best;
+}
+
+template <typename FP8, bool saturate>
+void DoFp8ArithmeticTest() {
+  LutFloat lut;
+  FloppyFloat ff;
+  for (u32 i = 0; i < (1u << 16); ++i) {
+    FP8 a{static_cast<u8>(i >> 8)};
+    FP8 b{static_cast<u8>(i)};
+    f64 fa = ff.Fp8ToF32(a);
+    f64 fb = ff.Fp8ToF32(b);
+    std::array<std::pair<u8, f64>, 3> results;
+    lut.ClearFlags();
+    results[0] = {lut.Fp8Add<FP8, saturate>(a, b).v, fa + fb};
+    results[1] = {lut.Fp8Sub<FP8, saturate>(a, b).v, fa - fb};
+    results[2] = {lut.Fp8Mul<FP8, saturate>(a, b).v, fa * fb};
+    for (auto [result, exact] : results) {
+      if (std::isnan(exact))
+        ASSERT_EQ(result, MiniFloatFormat<FP8>::kNanCode) << "Input: " << i;
+      else
+        ASSERT_EQ(result, NearestFp8<FP8>(exact, saturate)) << "Input: " << i << ", exact: " << exact;
+    }
+  }
+}
+
+TEST(LutFloatTests, Fp8e4m3Arithmetic) {
+  DoFp8ArithmeticTest<fp8e4m3, false>();
+  DoFp8ArithmeticTest<fp8e4m3, true>();
+}
+
+TEST(LutFloatTests, Fp8e5m2Arithmetic) {
+  DoFp8ArithmeticTest<fp8e5m2, false>();
+  DoFp8ArithmeticTest<fp8e5m2, true>();
+}
+
+TEST(LutFloatTests, Fp8Golden) {
+  LutFloat lut;
+  lut.SetupToRiscv();
+  lut.ClearFlags();
+  ASSERT_EQ((lut.Fp8Add<fp8e4m3, false>(fp8e4m3{0x7e}, fp8e4m3{0x7e}).v), 0x7f);  // 448 + 448 = NaN
+  ASSERT_EQ(lut.GetFlagsRiscv(), 0x05);
+  lut.ClearFlags();
+  ASSERT_EQ((lut.Fp8Add<fp8e4m3, true>(fp8e4m3{0x7e}, fp8e4m3{0x7e}).v), 0x7e);  // 448 + 448 = 448
+  ASSERT_EQ(lut.GetFlagsRiscv(), 0x05);
+  lut.ClearFlags();
+  ASSERT_EQ((lut.Fp8Mul<fp8e4m3, false>(fp8e4m3{0x38}, fp8e4m3{0x40}).v), 0x40);  // 1 * 2 = 2
+  ASSERT_EQ(lut.GetFlagsRiscv(), 0x00);
+  ASSERT_EQ((lut.Fp8Sub<fp8e5m2, false>(fp8e5m2{0x7c}, fp8e5m2{0x7c}).v), 0x7e);  // ∞ - ∞ = NaN
+  ASSERT_EQ(lut.GetFlagsRiscv(), 0x10);
+  lut.ClearFlags();
+  ASSERT_EQ(lut.Fp8MaximumNumber<fp8e5m2>(fp8e5m2{0x7e}, fp8e5m2{0xbc}).v, 0xbc);  // max(NaN, -1) = -1
+  ASSERT_EQ(lut.Fp8MinimumNumber<fp8e4m3>(fp8e4m3{0x00}, fp8e4m3{0x80}).v, 0x80);  // min(0, -0) = -0
+  ASSERT_TRUE(lut.Fp8EqQuiet<fp8e4m3>(fp8e4m3{0x00}, fp8e4m3{0x80}));
+  ASSERT_TRUE(lut.Fp8LtQuiet<fp8e4m3>(fp8e4m3{0xb8}, fp8e4m3{0x38}));
+  ASSERT_FALSE(lut.Fp8LeQuiet<fp8e5m2>(fp8e5m2{0x7e}, fp8e5m2{0x3c}));
+  ASSERT_EQ(lut.GetFlagsRiscv(), 0x00);
+  ASSERT_FALSE(lut.Fp8EqQuiet<fp8e5m2>(fp8e5m2{0x7d}, fp8e5m2{0x3c}));  // Signaling NaN.
+  ASSERT_EQ(lut.GetFlagsRiscv(), 0x10);
+}
+
+// The batch versions must match the scalar ones and raise the union of their flags.
+// The batch versions must match the scalar lookups for every available gather path, including the remainders.
+TEST(LutFloatTests, VFp8) {
+  constexpr size_t kLen = 1003;
+  std::array<fp8e4m3, kLen> a, b, dest;
+  for (size_t i = 0; i < kLen; ++i) {
+    a[i].v = static_cast<u8>(i * 37);
+    b[i].v = static_cast<u8>(i * 101 + 7);
+  }
+  a[kLen - 1].v = 0xff;  // The last table entry.
+  b[kLen - 1].v = 0xff;
+  for (int gather = LutFloat::kHostGatherNone; gather <= LutFloat::DetectHostGather(); ++gather) {
+    LutFloat vlut, lut;
+    vlut.SetHostGather(static_cast<LutFloat::HostGather>(gather));
+    ASSERT_EQ(vlut.GetHostGather(), gather);
+    vlut.ClearFlags();
+    lut.ClearFlags();
+    vlut.VFp8Mul<fp8e4m3, false>(a.data(), b.data(), dest.data(), kLen);
+    for (size_t i = 0; i < kLen; ++i)
+      ASSERT_EQ(dest[i].v, (lut.Fp8Mul<fp8e4m3, false>(a[i], b[i]).v)) << "Index: " << i << " Gather: " << gather;
+    ASSERT_EQ(vlut.GetFlagsRiscv(), lut.GetFlagsRiscv());
+    ASSERT_NE(vlut.GetFlagsRiscv(), 0x00);
+    vlut.VFp8MinimumNumber<fp8e4m3>(a.data(), b.data(), dest.data(), kLen);
+    for (size_t i = 0; i < kLen; ++i)
+      ASSERT_EQ(dest[i].v, lut.Fp8MinimumNumber<fp8e4m3>(a[i], b[i]).v) << "Index: " << i << " Gather: " << gather;
+    // Only an invalid E5M2 operation raises a flag, which the OR-reduction must not lose.
+    std::array<fp8e5m2, kLen> c, d, dest2;
+    for (size_t i = 0; i < kLen; ++i) {
+      c[i].v = static_cast<u8>(i % 0x7c);
+      d[i].v = static_cast<u8>(i * 3 % 0x7c);
+    }
+    c[kLen / 2].v = 0x7c;  // ∞ - ∞
+    d[kLen / 2].v = 0x7c;
+    vlut.ClearFlags();
+    vlut.VFp8Sub<fp8e5m2, false>(c.data(), d.data(), dest2.data(), kLen);
+    ASSERT_TRUE(vlut.invalid) << "Gather: " << gather;
+  }
+  LutFloat clamped;
+  clamped.SetHostGather(LutFloat::kHostGatherAvx512);
+  ASSERT_EQ(clamped.GetHostGather(), LutFloat::DetectHostGather());
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mx_float.h"
+#include "utils.h"
+
+using namespace FfUtils;
+
+constexpr i32 kRngSeed = 42;
+constexpr size_t kBlock = MxFloat::kMxBlockSize;
+
+// Exposes the scalar rounding of the FP6 and FP4 elements for the reference.
+class MxTestFloat : public MxFloat {
+ public:
+  using FloppyFloat::RoundToMiniFloat;
+};
+
+template <typename ET>
+constexpr int MaxElementExponent() {
+  if constexpr (std::is_same_v<ET, mxint8>)
+    return 0;
+  else
+    return (MiniFloatFormat<ET>::kMaxCode >> MiniFloatFormat<ET>::kSigBits) - MiniFloatFormat<ET>::kBias;
+}
+
+// Element-by-element reference of one element: Round to nearest even (or stochastically) with saturation.
+template <typename ET, bool stochastic>
+u8 ReferenceElement(MxTestFloat& ff, f32 a, u32 random) {
+  if constexpr (std::is_same_v<ET, mxint8>) {
+    f32 scaled = a * 64.f;
+    f32 q;
+    if constexpr (stochastic) {
+      f32 t = std::trunc(scaled);
+      f64 frac = std::abs(static_cast<f64>(scaled) - t);
+      q = (std::floor(std::ldexp(frac, 32)) + random >= 0x1p32) ? t + std::copysign(1.f, scaled) : t;
+    } else {
+      q = std::nearbyint(scaled);
+    }
+    if (q != scaled)
+      ff.inexact = true;
+    if (std::abs(q) > 127.f) {
+      ff.overflow = true;
+      ff.inexact = true;
+      q = std::copysign(127.f, scaled);
+    }
+    return static_cast<u8>(static_cast<i8>(q));
+  } else if constexpr (std::is_same_v<ET, fp8e4m3> || std::is_same_v<ET, fp8e5m2>) {
+    if constexpr (stochastic)
+      return ff.FToFp8Stochastic<ET, true, f32>(a, random).v;
+    else
+      return ff.FToFp8<ET, true, f32>(a).v;
+  } else {
+    return ff.RoundToMiniFloat<ET, true, stochastic>(a, random);
+  }
+}
+
+// Quantizes like the OCP MX specification (see "6.3 Conversion from vector of scalar floats to MX"), one element at a
+// time. Sets the bits of element i at bit offset i * bits (little-endian packing).
+template <typename ET, bool stochastic>
+void ReferenceQuantize(std::vector<f32>& src, std::vector<u32>& random, std::vector<u8>& scales,
+                       std::vector<u8>& elements, std::vector<u8>& block_flags) {
+  constexpr int kBits = MxFloat::MxElementBits<ET>();
+  std::fill(elements.begin(), elements.end(), 0);
+  for (size_t block = 0; block * kBlock < src.size(); ++block) {
+    MxTestFloat ff;
+    ff.ClearFlags();
+    size_t first = block * kBlock;
+    size_t last = std::min(first + kBlock, src.size());
+    int max_exp = -127;
+    bool special = false;
+    for (size_t i = first; i < last; ++i) {
+      special |= !std::isfinite(src[i]);
+      if (std::isinf(src[i]) || IsSnan(src[i]))
+        ff.invalid = true;
+      max_exp = std::max(max_exp, std::ilogb(src[i] == 0.f ? 0x1p-127f : src[i]));
+    }
+    if (special) {
+      scales[block] = 0xff;
+      block_flags[block] = ff.GetFlagsRiscv();
+      continue;
+    }
+
+    int shared_exp = std::clamp(max_exp - MaxElementExponent<ET>(), -127, 127);
+    scales[block] = static_cast<u8>(shared_exp + 127);
+    for (size_t i = first; i < last; ++i) {
+      f32 scaled = std::ldexp(src[i], -shared_exp);
+      if (src[i] != 0.f && scaled == 0.f) {
+        ff.inexact = true;
+        ff.underflow = true;
+      }
+      u32 code = ReferenceElement<ET, stochastic>(ff, scaled, random[i]) & ((1u << kBits) - 1);
+      for (int b = 0; b < kBits; ++b)
+        elements[(i * kBits + b) / 8] |= static_cast<u8>(((code >> b) & 1) << ((i * kBits + b) % 8));
+    }
+    block_flags[block] = ff.GetFlagsRiscv();
+  }
+}
+
+template <typename ET>
+f32 ReferenceDecode(u8 code) {
+  if constexpr (std::is_same_v<ET, mxint8>)
+    return static_cast<f32>(static_cast<i8>(code)) * 0x1p-6f;
+  else
+    return MiniFloatDecodeTable<ET>()[code];
+}
+
+// Blocks of different magnitudes with one partial last block, a block of zeros, a block with a wide dynamic range whose
+// smallest values vanish, and a block with an infinity.
+std::vector<f32> CreateInput(size_t len) {
+  std::mt19937 engine(kRngSeed);
+  std::normal_distribution<f32> dist(0.f, 1.f);
+  std::vector<f32> src(len);
+  for (size_t i = 0; i < len; ++i)
+    src[i] = std::ldexp(dist(engine), static_cast<int>(i / kBlock) * 9 - 40);
+  std::fill(&src[2 * kBlock], &src[3 * kBlock], 0.f);
+  src[3 * kBlock] = 0x1p100f;
+  src[3 * kBlock + 1] = 0x1p-120f;
+  src[3 * kBlock + 2] = -0x1p-149f;
+  src[4 * kBlock + 5] = -std::numeric_limits<f32>::infinity();
+  return src;
+}
+
+template <typename ET, bool stochastic>
+void TestQuantize() {
+  constexpr size_t kLen = 7 * kBlock + 13;
+  constexpr size_t kNumBlocks = (kLen + kBlock - 1) / kBlock;
+  std::vector<f32> src = CreateInput(kLen);
+  std::vector<u32> random(kLen);
+  std::mt19937 engine(kRngSeed);
+  std::generate(random.begin(), random.end(), engine);
+
+  for (size_t len : {kLen, kBlock, size_t{5}}) {
+    size_t num_blocks = (len + kBlock - 1) / kBlock;
+    std::vector<f32> in(src.begin(), src.begin() + len);
+    std::vector<u8> ref_scales(num_blocks), ref_elements(MxFloat::MxElementBytes<ET>(len)), ref_flags(num_blocks);
+    ReferenceQuantize<ET, stochastic>(in, random, ref_scales, ref_elements, ref_flags);
+
+    MxFloat mx;
+    mx.ClearFlags();
+    mx.division_by_zero = true;  // Flags from before must be kept.
+    std::vector<u8> scales(kNumBlocks, 0xaa), elements(MxFloat::MxElementBytes<ET>(kLen) + 1, 0xaa);
+    std::vector<u8> block_flags(kNumBlocks, 0xaa);
+    mx.MxQuantize<ET, stochastic>(in.data(), scales.data(), elements.data(), len, random.data(), block_flags.data());
+
+    u8 all_flags = 0x08;
+    for (size_t block = 0; block < num_blocks; ++block) {
+      ASSERT_EQ(scales[block], ref_scales[block]) << "Block: " << block << " Len: " << len;
+      ASSERT_EQ(block_flags[block], ref_flags[block]) << "Block: " << block << " Len: " << len;
+      all_flags |= ref_flags[block];
+    }
+    for (size_t i = 0; i < ref_elements.size(); ++i)
+      ASSERT_EQ(elements[i], ref_elements[i]) << "Byte: " << i << " Len: " << len;
+    ASSERT_EQ(elements[ref_elements.size()], 0xaa) << "Len: " << len;
+    ASSERT_EQ(mx.GetFlagsRiscv(), all_flags) << "Len: " << len;
+
+    // Without "block_flags", the same results and the union of the flags.
+    MxFloat mx2;
+    mx2.ClearFlags();
+    std::vector<u8> elements2(elements.size(), 0xaa);
+    mx2.MxQuantize<ET, stochastic>(in.data(), scales.data(), elements2.data(), len, random.data());
+    ASSERT_EQ(elements2, elements) << "Len: " << len;
+    ASSERT_EQ(mx2.GetFlagsRiscv(), all_flags & ~0x08) << "Len: " << len;
+
+    // Dequantization multiplies each element by its scale.
+    std::vector<f32> dest(len);
+    mx.MxDequantize<ET>(scales.data(), elements.data(), dest.data(), len);
+    for (size_t i = 0; i < len; ++i) {
+      constexpr int kBits = MxFloat::MxElementBits<ET>();
+      u8 code = 0;
+      for (int b = 0; b < kBits; ++b)
+        code |= static_cast<u8>(((ref_elements[(i * kBits + b) / 8] >> ((i * kBits + b) % 8)) & 1) << b);
+      if (ref_scales[i / kBlock] == 0xff) {
+        ASSERT_TRUE(std::isnan(dest[i])) << "Index: " << i;
+      } else {
+        f32 ref = std::ldexp(ReferenceDecode<ET>(code), static_cast<int>(ref_scales[i / kBlock]) - 127);
+        ASSERT_EQ(std::bit_cast<u32>(dest[i]), std::bit_cast<u32>(ref)) << "Index: " << i;
+      }
+    }
+  }
+}
+
+// Values that are elements times the block scale survive a round trip exactly, and without flags.
+template <typename ET>
+void TestRoundTrip() {
+  constexpr size_t kLen = 3 * kBlock + 7;
+  std::vector<u8> codes;
+  for (u32 c = 0; c < (1u << MxFloat::MxElementBits<ET>()); ++c) {
+    bool int8_min = std::is_same_v<ET, mxint8> && c == 0x80;  // Saturates to -127, as MXINT8 is symmetric.
+    if (std::isfinite(ReferenceDecode<ET>(static_cast<u8>(c))) && !int8_min)
+      codes.push_back(static_cast<u8>(c));
+  }
+  std::vector<f32> src(kLen);
+  for (size_t i = 0; i < kLen; ++i)
+    src[i] = std::ldexp(ReferenceDecode<ET>(codes[(i * 7) % codes.size()]), static_cast<int>(i / kBlock) * 3 - 4);
+  for (size_t block = 0; block * kBlock < kLen; ++block)  // Makes each block use the largest element exponent.
+    src[block * kBlock] = std::ldexp(0x1p0f, MaxElementExponent<ET>() + static_cast<int>(block) * 3 - 4);
+
+  MxFloat mx;
+  mx.ClearFlags();
+  std::vector<u8> scales(4), elements(MxFloat::MxElementBytes<ET>(kLen));
+  std::vector<f32> dest(kLen);
+  mx.MxQuantize<ET, false>(src.data(), scales.data(), elements.data(), kLen);
+  mx.MxDequantize<ET>(scales.data(), elements.data(), dest.data(), kLen);
+  for (size_t i = 0; i < kLen; ++i)
+    ASSERT_EQ(std::bit_cast<u32>(dest[i]), std::bit_cast<u32>(src[i])) << "Index: " << i;
+  ASSERT_EQ(mx.GetFlagsRiscv(), 0);
+}
+
+template <typename ET>
+void TestMx() {
+  TestQuantize<ET, false>();
+  TestQuantize<ET, true>();
+  TestRoundTrip<ET>();
+}
+
+TEST(MxFloatTests, Fp8E4M3) {
+  TestMx<fp8e4m3>();
+}
+
+TEST(MxFloatTests, Fp8E5M2) {
+  TestMx<fp8e5m2>();
+}
+
+TEST(MxFloatTests, Fp6E3M2) {
+  TestMx<fp6e3m2>();
+}
+
+TEST(MxFloatTests, Fp6E2M3) {
+  TestMx<fp6e2m3>();
+}
+
+TEST(MxFloatTests, Fp4E2M1) {
+  TestMx<fp4e2m1>();
+}
+
+TEST(MxFloatTests, Int8) {
+  TestMx<mxint8>();
+}
+
+// E8M0 scales: 0xff is NaN, and the shared exponent is clamped to [-127, 127].
+TEST(MxFloatTests, Scales) {
+  MxFloat mx;
+  mx.ClearFlags();
+  std::vector<f32> src(2 * kBlock, 0.f);
+  src[0] = std::numeric_limits<f32>::max();
+  src[kBlock] = std::numeric_limits<f32>::quiet_NaN();
+  std::vector<u8> scales(2), elements(2 * kBlock);
+  mx.MxQuantize<fp4e2m1, false>(src.data(), scales.data(), elements.data(), src.size());
+  EXPECT_EQ(scales[0], 127 + 127 - 2);
+  EXPECT_EQ(scales[1], 0xff);
+  EXPECT_FALSE(mx.invalid);  // Quiet NaNs do not raise invalid.
+
+  std::vector<f32> dest(2 * kBlock);
+  mx.MxDequantize<fp4e2m1>(scales.data(), elements.data(), dest.data(), dest.size());
+  EXPECT_EQ(dest[0], 0x1p127f * 1.5f);
+  EXPECT_TRUE(std::isnan(dest[kBlock]));
+
+  std::fill(src.begin(), src.end(), 0.f);
+  mx.MxQuantize<fp8e4m3, false>(src.data(), scales.data(), elements.data(), src.size());
+  EXPECT_EQ(scales[0], 0);  // Shared exponent -127 for a block of zeros.
+  for (u8 e : elements)
+    EXPECT_EQ(e, 0);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,8 @@
 #include <vector>
 
 #include "floppy_float.h"
+#include "lut_float.h"
+#include "simd_float.h"
 #include "utils.h"
 
 extern "C" {
@@ -28,6 +30,7 @@ using namespace FfUtils;
 
 constexpr i32 kNumIterations = 30000000;
 constexpr i32 kRngSeed = 42;
+constexpr size_t kSimdLength = 1000;
 
 template <typename FT>
 class FloatRng {
@@ -114,19 +117,37 @@ std::vector<std::tuple<std::string, f64>> result_vec;
     float_rng.Reset();                                                                        \
   }
 
+// Processes kSimdLength values per call, so the total number of values matches the scalar tests.
+#define PERF_TEST_SIMD(func, ftype, ...)                                                      \
+  {                                                                                           \
+    FloatRng<ftype> float_rng(kRngSeed);                                                      \
+    std::vector<ftype> va(kSimdLength), vb(kSimdLength), vc(kSimdLength), vd(kSimdLength);    \
+    for (size_t i = 0; i < kSimdLength; ++i) {                                                \
+      va[i] = float_rng.Gen();                                                                \
+      vb[i] = float_rng.Gen();                                                                \
+      vc[i] = float_rng.Gen();                                                                \
+    }                                                                                         \
+    [[maybe_unused]] ftype *a = va.data(), *b = vb.data(), *c = vc.data(), *d = vd.data();    \
+    begin = std::chrono::steady_clock::now();                                                 \
+    for (size_t i = 0; i < kNumIterations; i += kSimdLength)                                  \
+      func(__VA_ARGS__, kSimdLength);                                                         \
+    end = std::chrono::steady_clock::now();                                                   \
+    ms_ff_float = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count(); \
+  }
+
 #define PERF_TEST_SF(rm, func, sftype, ftype, ...)                                            \
   {                                                                                           \
     ::softfloat_roundingMode = rm;                                                            \
     FloatRng<ftype> float_rng(kRngSeed);                                                      \
     [[maybe_unused]] sftype a, b, c;                                                          \
-    a.v = std::bit_cast<typename FloatToUint<ftype>::type>(float_rng.Gen());                  \
-    b.v = std::bit_cast<typename FloatToUint<ftype>::type>(float_rng.Gen());                  \
-    c.v = std::bit_cast<typename FloatToUint<ftype>::type>(float_rng.Gen());                  \
+    a = std::bit_cast<sftype>(float_rng.Gen());                                               \
+    b = std::bit_cast<sftype>(float_rng.Gen());                                               \
+    c = std::bit_cast<sftype>(float_rng.Gen());                                               \
     begin = std::chrono::steady_clock::now();                                                 \
     for (size_t i = 0; i < kNumIterations; ++i) {                                             \
       [[maybe_unused]] auto result = func(__VA_ARGS__);                                       \
-      b.v = a.v;                                                                              \
-      a.v = std::bit_cast<typename FloatToUint<ftype>::type>(float_rng.Gen());                \
+      b = a;                                                                                  \
+      a = std::bit_cast<sftype>(float_rng.Gen());                                             \
     }                                                                                         \
     end = std::chrono::steady_clock::now();                                                   \
     ms_sf_float = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count(); \
@@ -136,6 +157,13 @@ std::vector<std::tuple<std::string, f64>> result_vec;
 int main() {
   FloppyFloat ff;
   ff.SetupToX86();
+  LutFloat lut;
+  FloppyFloat ff_no_host_f16;  // Emulates f16 arithmetic in f32 (see FloppyFloat::SetHostF16).
+  ff_no_host_f16.SetupToX86();
+  ff_no_host_f16.SetHostF16(FloppyFloat::kHostF16None);
+  lut.SetupToX86();
+  SimdFloat simd;
+  simd.SetupToRiscv();
 
   ::softfloat_exceptionFlags = 0xff;
   ff.inexact = true;
@@ -143,6 +171,9 @@ int main() {
   ff.invalid = true;
   ff.overflow = true;
   ff.division_by_zero = true;
+  lut.inexact = true;
+  simd.inexact = true;
+  simd.underflow = true;
 
   std::chrono::steady_clock::time_point begin;
   std::chrono::steady_clock::time_point end;
@@ -252,6 +283,50 @@ int main() {
   PERF_TEST_SF(::softfloat_round_near_maxMag, f32_sqrt, float32_t, f32, a)
   result_vec.push_back({"Sqrtf32RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
 
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Sqrt, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_sqrt, float16_t, f16, a)
+  result_vec.push_back({"Sqrtf16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff_no_host_f16.Sqrt, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_sqrt, float16_t, f16, a)
+  result_vec.push_back({"Sqrtf16NoHostF16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Add, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_add, float16_t, f16, a, b)
+  result_vec.push_back({"Addf16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff_no_host_f16.Add, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_add, float16_t, f16, a, b)
+  result_vec.push_back({"Addf16NoHostF16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Mul, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_mul, float16_t, f16, a, b)
+  result_vec.push_back({"Mulf16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff_no_host_f16.Mul, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_mul, float16_t, f16, a, b)
+  result_vec.push_back({"Mulf16NoHostF16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Div, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_div, float16_t, f16, a, b)
+  result_vec.push_back({"Divf16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff_no_host_f16.Div, f16, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_div, float16_t, f16, a, b)
+  result_vec.push_back({"Divf16NoHostF16", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, lut.Sqrt, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_sqrt, float16_t, f16, a)
+  result_vec.push_back({"Sqrtf16Lut", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_0(ff.F16ToI32, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_to_i32, float16_t, f16, a, ::softfloat_round_near_even, true)
+  result_vec.push_back({"F16ToI32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_0(lut.F16ToI32, f16, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f16_to_i32, float16_t, f16, a, ::softfloat_round_near_even, true)
+  result_vec.push_back({"F16ToI32Lut", (f64)ms_sf_float / (f64)ms_ff_float});
+
   PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Fma, f32, a, b, c)
   PERF_TEST_SF(::softfloat_round_near_even, f32_mulAdd, float32_t, f32, a, b, c)
   result_vec.push_back({"Fmaf32", (f64)ms_sf_float / (f64)ms_ff_float});
@@ -616,6 +691,214 @@ int main() {
   PERF_TEST_SF(::softfloat_round_near_maxMag, f64_to_ui64, float64_t, f64, a, ::softfloat_roundingMode, true)
   result_vec.push_back({"F64ToU64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
 
+  PERF_TEST_FF_0(ff.F64ToI32Modular, f64, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f64_to_i32, float64_t, f64, a, ::softfloat_roundingMode, true)
+  result_vec.push_back({"F64ToI32Modular", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_0(ff.LeQuiet<f64>, f64, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f64_le_quiet, float64_t, f64, a, b)
+  result_vec.push_back({"LeQuietf64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_0(ff.LtQuiet<f64>, f64, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f64_lt_quiet, float64_t, f64, a, b)
+  result_vec.push_back({"LtQuietf64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Add, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_add, float128_t, f128, a, b)
+  result_vec.push_back({"Addf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Sub, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_sub, float128_t, f128, a, b)
+  result_vec.push_back({"Subf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Mul, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_mul, float128_t, f128, a, b)
+  result_vec.push_back({"Mulf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_max, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_min, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Div, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_div, float128_t, f128, a, b)
+  result_vec.push_back({"Divf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_max, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_min, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Sqrt, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_sqrt, float128_t, f128, a)
+  result_vec.push_back({"Sqrtf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToEven, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardPositive, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_max, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardNegative, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_min, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTowardZero, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_2(Vfpu::RoundingMode::kRoundTiesToAway, ff.Fma, f128, a, b, c)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_mulAdd, float128_t, f128, a, b, c)
+  result_vec.push_back({"Fmaf128RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_0(ff.F64ToF128, f64, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f64_to_f128, float64_t, f64, a)
+  result_vec.push_back({"F64ToF128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToEven, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardPositive, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_max, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64RoundTowardPositive", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardNegative, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_min, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64RoundTowardNegative", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTowardZero, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_minMag, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64RoundTowardZero", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_1(Vfpu::RoundingMode::kRoundTiesToAway, ff.F128ToF64, f128, a)
+  PERF_TEST_SF(::softfloat_round_near_maxMag, f128_to_f64, float128_t, f128, a)
+  result_vec.push_back({"F128ToF64RoundTiesToAway", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_FF_0(ff.LtQuiet<f128>, f128, a, b)
+  PERF_TEST_SF(::softfloat_round_near_even, f128_lt_quiet, float128_t, f128, a, b)
+  result_vec.push_back({"LtQuietf128", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_SIMD(simd.VAdd<f32>, f32, a, b, d)
+  PERF_TEST_SF(::softfloat_round_near_even, f32_add, float32_t, f32, a, b)
+  result_vec.push_back({"VAddf32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_SIMD(simd.VMul<f32>, f32, a, b, d)
+  PERF_TEST_SF(::softfloat_round_near_even, f32_mul, float32_t, f32, a, b)
+  result_vec.push_back({"VMulf32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_SIMD(simd.VDiv<f32>, f32, a, b, d)
+  PERF_TEST_SF(::softfloat_round_near_even, f32_div, float32_t, f32, a, b)
+  result_vec.push_back({"VDivf32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_SIMD(simd.VFma<f32>, f32, a, b, c, d)
+  PERF_TEST_SF(::softfloat_round_near_even, f32_mulAdd, float32_t, f32, a, b, c)
+  result_vec.push_back({"VFmaf32", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_SIMD(simd.VAdd<f64>, f64, a, b, d)
+  PERF_TEST_SF(::softfloat_round_near_even, f64_add, float64_t, f64, a, b)
+  result_vec.push_back({"VAddf64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  PERF_TEST_SIMD(simd.VMul<f64>, f64, a, b, d)
+  PERF_TEST_SF(::softfloat_round_near_even, f64_mul, float64_t, f64, a, b)
+  result_vec.push_back({"VMulf64", (f64)ms_sf_float / (f64)ms_ff_float});
+
+  // Batch FP8 lookups with the host's gather instructions versus one table load per element.
+  {
+    std::mt19937 engine(kRngSeed);
+    std::vector<fp8e4m3> va(kSimdLength), vb(kSimdLength), vd(kSimdLength);
+    for (size_t i = 0; i < kSimdLength; ++i) {
+      va[i].v = static_cast<u8>(engine());
+      vb[i].v = static_cast<u8>(engine());
+    }
+    LutFloat lut_no_gather;
+    lut_no_gather.SetHostGather(LutFloat::kHostGatherNone);
+    auto measure = [&](LutFloat& l) {
+      begin = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < 10ull * kNumIterations; i += kSimdLength)  // Each lookup takes only about a nanosecond.
+        l.VFp8Mul<fp8e4m3, false>(va.data(), vb.data(), vd.data(), kSimdLength);
+      end = std::chrono::steady_clock::now();
+      return std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+    };
+    lut.VFp8Mul<fp8e4m3, false>(va.data(), vb.data(), vd.data(), kSimdLength);  // Builds the tables.
+    lut_no_gather.VFp8Mul<fp8e4m3, false>(va.data(), vb.data(), vd.data(), kSimdLength);
+    ms_sf_float = measure(lut_no_gather);
+    ms_ff_float = measure(lut);
+    result_vec.push_back({"VFp8Mule4m3Gather", (f64)ms_sf_float / (f64)ms_ff_float});
+  }
+
   // std::reverse(result_vec.begin(), result_vec.end());
   for (auto t : result_vec) {
     std::cout << "(" << std::get<1>(t) << "," << std::get<0>(t) << ")" << std::endl;
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ * Compares the MX block conversions against element-wise scalar conversions.
+ ******************************************************************************/
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "mx_float.h"
+#include "utils.h"
+
+using namespace FfUtils;
+
+constexpr size_t kNumValues = 1 << 16;
+constexpr i32 kNumIterations = 200;
+constexpr i32 kRngSeed = 42;
+
+std::vector<std::tuple<std::string, f64>> result_vec;
+
+// Element-wise reference: scale and convert each value on its own with the scalar FP8 conversion.
+template <typename FP8>
+void ScalarQuantizeFp8(MxFloat& ff, f32* src, u8* scales, u8* elements, size_t len) {
+  constexpr int kEmax = (MiniFloatFormat<FP8>::kMaxCode >> MiniFloatFormat<FP8>::kSigBits) - MiniFloatFormat<FP8>::kBias;
+  for (size_t block = 0; block * MxFloat::kMxBlockSize < len; ++block) {
+    size_t first = block * MxFloat::kMxBlockSize;
+    size_t last = std::min(first + MxFloat::kMxBlockSize, len);
+    int max_exp = 0;
+    for (size_t i = first; i < last; ++i)
+      max_exp = std::max(max_exp, static_cast<int>((std::bit_cast<u32>(src[i]) >> 23) & 0xff));
+    int shared_exp = std::clamp(max_exp - 127 - kEmax, -127, 127);
+    scales[block] = static_cast<u8>(shared_exp + 127);
+    for (size_t i = first; i < last; ++i)
+      elements[i] = ff.FToFp8<FP8, true>(std::ldexp(src[i], -shared_exp)).v;
+  }
+}
+
+template <typename F>
+i64 Measure(F func) {
+  auto begin = std::chrono::steady_clock::now();
+  for (i32 i = 0; i < kNumIterations; ++i)
+    func();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+// Returns false if the block conversion does not match the element-wise reference.
+template <typename ET>
+bool PerfTestMx(MxFloat& ff, std::vector<f32>& src, const std::string& name) {
+  std::vector<u8> scales(src.size() / MxFloat::kMxBlockSize);
+  std::vector<u8> elements(MxFloat::MxElementBytes<ET>(src.size()));
+  std::vector<f32> dest(src.size());
+  std::vector<u32> random(src.size());
+  std::mt19937 engine(kRngSeed);
+  std::generate(random.begin(), random.end(), engine);
+
+  bool match = true;
+  if constexpr (std::is_same_v<ET, fp8e4m3> || std::is_same_v<ET, fp8e5m2>) {
+    std::vector<u8> ref_scales(scales.size());
+    std::vector<u8> ref_elements(src.size());
+    i64 us_scalar =
+        Measure([&] { ScalarQuantizeFp8<ET>(ff, src.data(), ref_scales.data(), ref_elements.data(), src.size()); });
+    i64 us_block = Measure([&] { ff.MxQuantize<ET, false>(src.data(), scales.data(), elements.data(), src.size()); });
+    result_vec.push_back({"MxQuantize" + name, (f64)us_scalar / (f64)us_block});
+    if (scales != ref_scales || elements != ref_elements) {
+      std::cerr << "MxQuantize" << name << " does not match the element-wise reference" << std::endl;
+      match = false;
+    }
+  }
+
+  i64 us_block = Measure([&] { ff.MxQuantize<ET, false>(src.data(), scales.data(), elements.data(), src.size()); });
+  i64 us_stochastic = Measure(
+      [&] { ff.MxQuantize<ET, true>(src.data(), scales.data(), elements.data(), src.size(), random.data()); });
+  i64 us_dequantize = Measure([&] { ff.MxDequantize<ET>(scales.data(), elements.data(), dest.data(), src.size()); });
+  f64 values = (f64)kNumValues * kNumIterations;
+  result_vec.push_back({"MxQuantize" + name + "ValuesPerUs", values / (f64)us_block});
+  result_vec.push_back({"MxQuantizeStochastic" + name + "ValuesPerUs", values / (f64)us_stochastic});
+  result_vec.push_back({"MxDequantize" + name + "ValuesPerUs", values / (f64)us_dequantize});
+  return match;
+}
+
+int main() {
+  MxFloat ff;
+  std::mt19937 engine(kRngSeed);
+  std::normal_distribution<f32> dist(0.f, 1.f);
+  std::vector<f32> src(kNumValues);
+  std::generate(src.begin(), src.end(), [&] { return dist(engine); });
+
+  bool match = PerfTestMx<fp8e4m3>(ff, src, "Fp8E4M3");
+  match &= PerfTestMx<fp8e5m2>(ff, src, "Fp8E5M2");
+  match &= PerfTestMx<fp6e3m2>(ff, src, "Fp6E3M2");
+  match &= PerfTestMx<fp6e2m3>(ff, src, "Fp6E2M3");
+  match &= PerfTestMx<fp4e2m1>(ff, src, "Fp4E2M1");
+  match &= PerfTestMx<mxint8>(ff, src, "Int8");
+
+  for (auto t : result_vec) {
+    std::cout << "(" << std::get<1>(t) << "," << std::get<0>(t) << ")" << std::endl;
+  }
+
+  return match ? 0 : 1;
+}
@@ -8,6 +8,7 @@
 #include <bit>
 #include <cmath>
 #include <functional>
+#include <iomanip>
 #include <iostream>
 #include <type_traits>
 
@@ -48,10 +49,26 @@ template <>
 struct FFloatToSFloat<f64> {
   using type = float64_t;
 };
+template <>
+struct FFloatToSFloat<f128> {
+  using type = float128_t;
+};
+
+// gtest messages cannot stream 128-bit integers, so f128 results are compared via this wrapper.
+struct U128Bits {
+  u128 v;
+  bool operator==(const U128Bits&) const = default;
+  friend std::ostream& operator<<(std::ostream& os, const U128Bits& a) {
+    return os << std::hex << static_cast<u64>(a.v >> 64) << std::setw(16) << std::setfill('0') << static_cast<u64>(a.v)
+              << std::setfill(' ') << std::dec;
+  }
+};
 
 template <typename T>
 auto ToComparableType(T a) {
-  if constexpr (std::is_floating_point<decltype(a)>::value) {
+  if constexpr (std::is_same_v<decltype(a), f128> || std::is_same_v<decltype(a), float128_t>) {
+    return U128Bits{std::bit_cast<u128>(a)};
+  } else if constexpr (std::is_floating_point<decltype(a)>::value) {
     return std::bit_cast<typename FloatToUint<T>::type>(a);
   } else if constexpr (std::is_same_v<decltype(a), float16_t>) {
     return a.v;
@@ -95,12 +112,13 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
   ff.ClearFlags();
 
   FloatRng<FT> float_rng(kRngSeed);
+  using SFT = typename FFloatToSFloat<FT>::type;
   FT valuefa{float_rng.Gen()};
-  typename FFloatToSFloat<FT>::type valuesfa{std::bit_cast<typename FloatToUint<FT>::type>(valuefa)};
+  SFT valuesfa{std::bit_cast<SFT>(valuefa)};
   FT valuefb{float_rng.Gen()};
-  typename FFloatToSFloat<FT>::type valuesfb{std::bit_cast<typename FloatToUint<FT>::type>(valuefb)};
+  SFT valuesfb{std::bit_cast<SFT>(valuefb)};
   FT valuefc{float_rng.Gen()};
-  typename FFloatToSFloat<FT>::type valuesfc{std::bit_cast<typename FloatToUint<FT>::type>(valuefc)};
+  SFT valuesfc{std::bit_cast<SFT>(valuefc)};
 
   for (i32 i = 0; i < kNumIterations; ++i) {
     if constexpr (num_args == 1) {
@@ -133,7 +151,7 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
     valuesfb = valuesfa;
     valuefb = valuefa;
     valuefa = float_rng.Gen();
-    valuesfa.v = std::bit_cast<typename FloatToUint<FT>::type>(valuefa);
+    valuesfa = std::bit_cast<SFT>(valuefa);
   }
 }
 
@@ -222,6 +240,11 @@ TEST_MACRO_2(Addf64, &FloppyFloat::Add<f64>, f64_add, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Addf64, &FloppyFloat::Add<f64>, f64_add, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Addf64, &FloppyFloat::Add<f64>, f64_add, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Addf64, &FloppyFloat::Add<f64>, f64_add, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Addf128, &FloppyFloat::Add<f128>, f128_add, f128, 4, RoundTowardZero)
 
 TEST_MACRO_2(Subf16, &FloppyFloat::Sub<f16>, f16_sub, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Subf16, &FloppyFloat::Sub<f16>, f16_sub, f16, 1, RoundTiesToAway)
@@ -238,6 +261,11 @@ TEST_MACRO_2(Subf64, &FloppyFloat::Sub<f64>, f64_sub, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Subf64, &FloppyFloat::Sub<f64>, f64_sub, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Subf64, &FloppyFloat::Sub<f64>, f64_sub, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Subf64, &FloppyFloat::Sub<f64>, f64_sub, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Subf128, &FloppyFloat::Sub<f128>, f128_sub, f128, 4, RoundTowardZero)
 
 TEST_MACRO_2(Mulf16, &FloppyFloat::Mul<f16>, f16_mul, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Mulf16, &FloppyFloat::Mul<f16>, f16_mul, f16, 1, RoundTiesToAway)
@@ -254,6 +282,11 @@ TEST_MACRO_2(Mulf64, &FloppyFloat::Mul<f64>, f64_mul, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Mulf64, &FloppyFloat::Mul<f64>, f64_mul, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Mulf64, &FloppyFloat::Mul<f64>, f64_mul, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Mulf64, &FloppyFloat::Mul<f64>, f64_mul, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Mulf128, &FloppyFloat::Mul<f128>, f128_mul, f128, 4, RoundTowardZero)
 
 TEST_MACRO_2(Divf16, &FloppyFloat::Div<f16>, f16_div, f16, 0, RoundTiesToEven)
 TEST_MACRO_2(Divf16, &FloppyFloat::Div<f16>, f16_div, f16, 1, RoundTiesToAway)
@@ -270,6 +303,11 @@ TEST_MACRO_2(Divf64, &FloppyFloat::Div<f64>, f64_div, f64, 1, RoundTiesToAway)
 TEST_MACRO_2(Divf64, &FloppyFloat::Div<f64>, f64_div, f64, 2, RoundTowardPositive)
 TEST_MACRO_2(Divf64, &FloppyFloat::Div<f64>, f64_div, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Divf64, &FloppyFloat::Div<f64>, f64_div, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 0, RoundTiesToEven)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 1, RoundTiesToAway)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 2, RoundTowardPositive)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 3, RoundTowardNegative)
+TEST_MACRO_2(Divf128, &FloppyFloat::Div<f128>, f128_div, f128, 4, RoundTowardZero)
 
 TEST_MACRO_1(Sqrtf16, &FloppyFloat::Sqrt<f16>, f16_sqrt, f16, 0, RoundTiesToEven)
 TEST_MACRO_1(Sqrtf16, &FloppyFloat::Sqrt<f16>, f16_sqrt, f16, 1, RoundTiesToAway)
@@ -286,6 +324,11 @@ TEST_MACRO_1(Sqrtf64, &FloppyFloat::Sqrt<f64>, f64_sqrt, f64, 1, RoundTiesToAway
 TEST_MACRO_1(Sqrtf64, &FloppyFloat::Sqrt<f64>, f64_sqrt, f64, 2, RoundTowardPositive)
 TEST_MACRO_1(Sqrtf64, &FloppyFloat::Sqrt<f64>, f64_sqrt, f64, 3, RoundTowardNegative)
 TEST_MACRO_1(Sqrtf64, &FloppyFloat::Sqrt<f64>, f64_sqrt, f64, 4, RoundTowardZero)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 0, RoundTiesToEven)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 1, RoundTiesToAway)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 2, RoundTowardPositive)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 3, RoundTowardNegative)
+TEST_MACRO_1(Sqrtf128, &FloppyFloat::Sqrt<f128>, f128_sqrt, f128, 4, RoundTowardZero)
 
 // Berkeley SoftFloat raises an invalid exception for fma(0,infinity,qNaN).
 // That does not comply with Intel's x86 ISA definition.
@@ -306,6 +349,11 @@ TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAdd, f64, 1, RoundTiesToAway
 TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAdd, f64, 2, RoundTowardPositive)
 TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAdd, f64, 3, RoundTowardNegative)
 TEST_MACRO_3(Fmaf64, &FloppyFloat::Fma<f64>, f64_mulAdd, f64, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAdd, f128, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAdd, f128, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAdd, f128, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAdd, f128, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf128, &FloppyFloat::Fma<f128>, f128_mulAdd, f128, 4, RoundTowardZero)
 #endif
 
 TEST_MACRO_1(F16ToF32, static_cast<f32 (FloppyFloat::*)(f16)>(&FloppyFloat::F16ToF32), f16_to_f32, f16, 0, )
@@ -326,6 +374,18 @@ TEST_MACRO_1(F64ToF32, static_cast<f32 (FloppyFloat::*)(f64)>(&SoftFloat::F64ToF
 TEST_MACRO_1(F64ToF32, static_cast<f32 (FloppyFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 2, RoundTowardPositive)
 TEST_MACRO_1(F64ToF32, static_cast<f32 (FloppyFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 3, RoundTowardNegative)
 TEST_MACRO_1(F64ToF32, static_cast<f32 (FloppyFloat::*)(f64)>(&SoftFloat::F64ToF32), f64_to_f32, f64, 4, RoundTowardZero)
+TEST_MACRO_1(F32ToF128, static_cast<f128 (FloppyFloat::*)(f32)>(&FloppyFloat::F32ToF128), f32_to_f128, f32, 0, )
+TEST_MACRO_1(F64ToF128, static_cast<f128 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToF128), f64_to_f128, f64, 0, )
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 0, RoundTiesToEven)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 1, RoundTiesToAway)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 2, RoundTowardPositive)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 3, RoundTowardNegative)
+TEST_MACRO_1(F128ToF32, static_cast<f32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF32), f128_to_f32, f128, 4, RoundTowardZero)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 0, RoundTiesToEven)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 1, RoundTiesToAway)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 2, RoundTowardPositive)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 3, RoundTowardNegative)
+TEST_MACRO_1(F128ToF64, static_cast<f64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToF64), f128_to_f64, f128, 4, RoundTowardZero)
 
 TEST_MACRO_FTOI(F16ToI32, static_cast<i32 (FloppyFloat::*)(f16)>(&FloppyFloat::F16ToI32), f16_to_i32, f16, 0, RoundTiesToEven)
 TEST_MACRO_FTOI(F16ToI32, static_cast<i32 (FloppyFloat::*)(f16)>(&FloppyFloat::F16ToI32), f16_to_i32, f16, 1, RoundTiesToAway)
@@ -390,26 +450,53 @@ TEST_MACRO_FTOI(F64ToU64, static_cast<u64 (FloppyFloat::*)(f64)>(&FloppyFloat::F
 TEST_MACRO_FTOI(F64ToU64, static_cast<u64 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToU64), f64_to_ui64, f64, 3, RoundTowardNegative)
 TEST_MACRO_FTOI(F64ToU64, static_cast<u64 (FloppyFloat::*)(f64)>(&FloppyFloat::F64ToU64), f64_to_ui64, f64, 4, RoundTowardZero)
 
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToI32, static_cast<i32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI32), f128_to_i32, f128, 4, RoundTowardZero)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToI64, static_cast<i64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToI64), f128_to_i64, f128, 4, RoundTowardZero)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToU32, static_cast<u32 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU32), f128_to_ui32, f128, 4, RoundTowardZero)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 0, RoundTiesToEven)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 1, RoundTiesToAway)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 2, RoundTowardPositive)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 3, RoundTowardNegative)
+TEST_MACRO_FTOI(F128ToU64, static_cast<u64 (FloppyFloat::*)(f128)>(&FloppyFloat::F128ToU64), f128_to_ui64, f128, 4, RoundTowardZero)
+
 TEST_MACRO_2(EqQuietf16, &FloppyFloat::EqQuiet<f16>, f16_eq, f16, 0, )
 TEST_MACRO_2(EqQuietf32, &FloppyFloat::EqQuiet<f32>, f32_eq, f32, 0, )
 TEST_MACRO_2(EqQuietf64, &FloppyFloat::EqQuiet<f64>, f64_eq, f64, 0, )
+TEST_MACRO_2(EqQuietf128, &FloppyFloat::EqQuiet<f128>, f128_eq, f128, 0, )
 TEST_MACRO_2(EqSignalingf16, &FloppyFloat::EqSignaling<f16>, f16_eq_signaling, f16, 0, )
 TEST_MACRO_2(EqSignalingf32, &FloppyFloat::EqSignaling<f32>, f32_eq_signaling, f32, 0, )
 TEST_MACRO_2(EqSignalingf64, &FloppyFloat::EqSignaling<f64>, f64_eq_signaling, f64, 0, )
+TEST_MACRO_2(EqSignalingf128, &FloppyFloat::EqSignaling<f128>, f128_eq_signaling, f128, 0, )
 
 TEST_MACRO_2(LtQuietf16, &FloppyFloat::LtQuiet<f16>, f16_lt_quiet, f16, 0, )
 TEST_MACRO_2(LtQuietf32, &FloppyFloat::LtQuiet<f32>, f32_lt_quiet, f32, 0, )
 TEST_MACRO_2(LtQuietf64, &FloppyFloat::LtQuiet<f64>, f64_lt_quiet, f64, 0, )
+TEST_MACRO_2(LtQuietf128, &FloppyFloat::LtQuiet<f128>, f128_lt_quiet, f128, 0, )
 TEST_MACRO_2(LtSignalingf16, &FloppyFloat::LtSignaling<f16>, f16_lt, f16, 0, )
 TEST_MACRO_2(LtSignalingf32, &FloppyFloat::LtSignaling<f32>, f32_lt, f32, 0, )
 TEST_MACRO_2(LtSignalingf64, &FloppyFloat::LtSignaling<f64>, f64_lt, f64, 0, )
+TEST_MACRO_2(LtSignalingf128, &FloppyFloat::LtSignaling<f128>, f128_lt, f128, 0, )
 
 TEST_MACRO_2(LeQuietf16, &FloppyFloat::LeQuiet<f16>, f16_le_quiet, f16, 0, )
 TEST_MACRO_2(LeQuietf32, &FloppyFloat::LeQuiet<f32>, f32_le_quiet, f32, 0, )
 TEST_MACRO_2(LeQuietf64, &FloppyFloat::LeQuiet<f64>, f64_le_quiet, f64, 0, )
+TEST_MACRO_2(LeQuietf128, &FloppyFloat::LeQuiet<f128>, f128_le_quiet, f128, 0, )
 TEST_MACRO_2(LeSignalingf16, &FloppyFloat::LeSignaling<f16>, f16_le, f16, 0, )
 TEST_MACRO_2(LeSignalingf32, &FloppyFloat::LeSignaling<f32>, f32_le, f32, 0, )
 TEST_MACRO_2(LeSignalingf64, &FloppyFloat::LeSignaling<f64>, f64_le, f64, 0, )
+TEST_MACRO_2(LeSignalingf128, &FloppyFloat::LeSignaling<f128>, f128_le, f128, 0, )
 
 TEST_MACRO_ITOF(I32ToF16, I32ToF16, i32_to_f16, i32, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(I32ToF16, I32ToF16, i32_to_f16, i32, 1, RoundTiesToAway)
@@ -426,6 +513,11 @@ TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(I32ToF64, I32ToF64, i32_to_f64, i32, 4, RoundTowardZero)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(I32ToF128, I32ToF128, i32_to_f128, i32, 4, RoundTowardZero)
 
 TEST_MACRO_ITOF(U32ToF16, U32ToF16, ui32_to_f16, u32, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(U32ToF16, U32ToF16, ui32_to_f16, u32, 1, RoundTiesToAway)
@@ -442,6 +534,11 @@ TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(U32ToF64, U32ToF64, ui32_to_f64, u32, 4, RoundTowardZero)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(U32ToF128, U32ToF128, ui32_to_f128, u32, 4, RoundTowardZero)
 
 TEST_MACRO_ITOF(I64ToF16, I64ToF16, i64_to_f16, i64, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(I64ToF16, I64ToF16, i64_to_f16, i64, 1, RoundTiesToAway)
@@ -458,6 +555,11 @@ TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(I64ToF64, I64ToF64, i64_to_f64, i64, 4, RoundTowardZero)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(I64ToF128, I64ToF128, i64_to_f128, i64, 4, RoundTowardZero)
 
 TEST_MACRO_ITOF(U64ToF16, U64ToF16, ui64_to_f16, u64, 0, RoundTiesToEven)
 TEST_MACRO_ITOF(U64ToF16, U64ToF16, ui64_to_f16, u64, 1, RoundTiesToAway)
@@ -474,6 +576,11 @@ TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 1, RoundTiesToAway)
 TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 2, RoundTowardPositive)
 TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 3, RoundTowardNegative)
 TEST_MACRO_ITOF(U64ToF64, U64ToF64, ui64_to_f64, u64, 4, RoundTowardZero)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 0, RoundTiesToEven)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 1, RoundTiesToAway)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 2, RoundTowardPositive)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 3, RoundTowardNegative)
+TEST_MACRO_ITOF(U64ToF128, U64ToF128, ui64_to_f128, u64, 4, RoundTowardZero)
 
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
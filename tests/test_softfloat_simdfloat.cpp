@@ -9,7 +9,10 @@
 #include <cmath>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <random>
 #include <type_traits>
+#include <vector>
 
 #include "float_rng.h"
 #include "simd_float.h"
@@ -108,9 +111,9 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
 
   for (i32 i = 0; i < kNumIterations; ++i) {
     if constexpr (num_args == 1) {
-      auto ff_result = ff_func(av, bv, kSimdLength);
+      ff_func(&av[0], &dv[0], kSimdLength);
       auto sf_result = sf_func(valuesfa);
-      auto ff_result_u = ToComparableType(ff_result);
+      auto ff_result_u = ToComparableType(dv[0]);
       auto sf_result_u = ToComparableType(sf_result);
       CheckResult(ff_result_u, sf_result_u, i);
     }
@@ -124,9 +127,9 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
       CheckResult(ff_result_u, sf_result_u, i);
     }
     if constexpr (num_args == 3) {
-      auto ff_result = ff_func(av, bv, cv, dv, kSimdLength);
+      ff_func(&av[0], &bv[0], &cv[0], &dv[0], kSimdLength);
       auto sf_result = sf_func(valuesfa, valuesfb, valuesfc);
-      auto ff_result_u = ToComparableType(ff_result);
+      auto ff_result_u = ToComparableType(dv[0]);
       auto sf_result_u = ToComparableType(sf_result);
       CheckResult(ff_result_u, sf_result_u, i);
     }
@@ -157,7 +160,8 @@ void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
   TEST(TEST_SUITE_NAME, name##rm_name) {                                         \
     ::softfloat_roundingMode = rounding_modes[rm].first;                         \
     ff.rounding_mode = rounding_modes[rm].second;                                \
-    auto ff_func = std::bind(ff_op, &ff, _1, _2, _3, _4);                           \
+    auto ff_member = ff_op;                                                      \
+    auto ff_func = [ff_member](auto... args) { (ff.*ff_member)(args...); };      \
     auto sf_func = std::bind(&::sf_op, __VA_ARGS__);                             \
     DoTest<type, decltype(ff_func), decltype(sf_func), nargs>(ff_func, sf_func); \
   }
@@ -194,11 +198,11 @@ TEST_MACRO_2(Mulf32, &SimdFloat::VMul<f32>, f32_mul, f32, 1, RoundTiesToAway)
 TEST_MACRO_2(Mulf32, &SimdFloat::VMul<f32>, f32_mul, f32, 2, RoundTowardPositive)
 TEST_MACRO_2(Mulf32, &SimdFloat::VMul<f32>, f32_mul, f32, 3, RoundTowardNegative)
 TEST_MACRO_2(Mulf32, &SimdFloat::VMul<f32>, f32_mul, f32, 4, RoundTowardZero)
-// TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 0, RoundTiesToEven)
-// TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 1, RoundTiesToAway)
-// TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 2, RoundTowardPositive)
-// TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 3, RoundTowardNegative)
-// TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 4, RoundTowardZero)
+TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 0, RoundTiesToEven)
+TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 1, RoundTiesToAway)
+TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 2, RoundTowardPositive)
+TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 3, RoundTowardNegative)
+TEST_MACRO_2(Mulf64, &SimdFloat::VMul<f64>, f64_mul, f64, 4, RoundTowardZero)
 
 TEST_MACRO_2(Divf32, &SimdFloat::VDiv<f32>, f32_div, f32, 0, RoundTiesToEven)
 TEST_MACRO_2(Divf32, &SimdFloat::VDiv<f32>, f32_div, f32, 1, RoundTiesToAway)
@@ -211,16 +215,564 @@ TEST_MACRO_2(Divf64, &SimdFloat::VDiv<f64>, f64_div, f64, 2, RoundTowardPositive
 TEST_MACRO_2(Divf64, &SimdFloat::VDiv<f64>, f64_div, f64, 3, RoundTowardNegative)
 TEST_MACRO_2(Divf64, &SimdFloat::VDiv<f64>, f64_div, f64, 4, RoundTowardZero)
 
-// TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 0, RoundTiesToEven)
-// TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 1, RoundTiesToAway)
-// TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 2, RoundTowardPositive)
-// TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 3, RoundTowardNegative)
-// TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 4, RoundTowardZero)
-// TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 0, RoundTiesToEven)
-// TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 1, RoundTiesToAway)
-// TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 2, RoundTowardPositive)
-// TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 3, RoundTowardNegative)
-// TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf32, &SimdFloat::VFma<f32>, f32_mulAdd, f32, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf32, &SimdFloat::VFma<f32>, f32_mulAdd, f32, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf32, &SimdFloat::VFma<f32>, f32_mulAdd, f32, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf32, &SimdFloat::VFma<f32>, f32_mulAdd, f32, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf32, &SimdFloat::VFma<f32>, f32_mulAdd, f32, 4, RoundTowardZero)
+TEST_MACRO_3(Fmaf64, &SimdFloat::VFma<f64>, f64_mulAdd, f64, 0, RoundTiesToEven)
+TEST_MACRO_3(Fmaf64, &SimdFloat::VFma<f64>, f64_mulAdd, f64, 1, RoundTiesToAway)
+TEST_MACRO_3(Fmaf64, &SimdFloat::VFma<f64>, f64_mulAdd, f64, 2, RoundTowardPositive)
+TEST_MACRO_3(Fmaf64, &SimdFloat::VFma<f64>, f64_mulAdd, f64, 3, RoundTowardNegative)
+TEST_MACRO_3(Fmaf64, &SimdFloat::VFma<f64>, f64_mulAdd, f64, 4, RoundTowardZero)
+
+TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 0, RoundTiesToEven)
+TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 1, RoundTiesToAway)
+TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 2, RoundTowardPositive)
+TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 3, RoundTowardNegative)
+TEST_MACRO_1(Sqrtf32, &SimdFloat::VSqrt<f32>, f32_sqrt, f32, 4, RoundTowardZero)
+TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 0, RoundTiesToEven)
+TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 1, RoundTiesToAway)
+TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 2, RoundTowardPositive)
+TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 3, RoundTowardNegative)
+TEST_MACRO_1(Sqrtf64, &SimdFloat::VSqrt<f64>, f64_sqrt, f64, 4, RoundTowardZero)
+
+// The directed rounding modes correct the host square root lane by lane, which must match the scalar version bit by
+// bit. The inputs are inexact and exact square roots, subnormals, and special values.
+template <typename FT>
+void TestSqrt() {
+  using UT = typename FloatToUint<FT>::type;
+  const std::vector<FT> specials = {
+      static_cast<FT>(0.), -static_cast<FT>(0.), static_cast<FT>(-1.), std::numeric_limits<FT>::denorm_min(),
+      std::numeric_limits<FT>::min(), std::numeric_limits<FT>::max(), std::numeric_limits<FT>::infinity(),
+      -std::numeric_limits<FT>::infinity(), std::numeric_limits<FT>::quiet_NaN(),
+      std::numeric_limits<FT>::signaling_NaN()};
+  constexpr size_t kLen = 1003;
+  std::vector<FT> a(kLen);
+  std::vector<FT> d(kLen);
+  std::mt19937_64 rng(kRngSeed);
+  std::uniform_real_distribution<FT> dist(static_cast<FT>(1.), static_cast<FT>(2.));
+  for (size_t i = 0; i < kLen; ++i) {
+    if (i % 5 == 0)
+      a[i] = specials[rng() % specials.size()];
+    else if (i % 5 == 1)
+      a[i] = static_cast<FT>((rng() % 4096) * (rng() % 4096));
+    else
+      a[i] = std::ldexp(dist(rng), static_cast<int>(rng() % 300) - 150);
+  }
+
+  for (bool x86 : {false, true}) {
+    for (int rm = 0; rm < 5; ++rm) {
+      for (size_t len : {kLen, size_t{3}}) {
+        SimdFloat sf;
+        FloppyFloat ff;
+        if (x86) {
+          sf.SetupToX86();
+          ff.SetupToX86();
+        } else {
+          sf.SetupToRiscv();
+          ff.SetupToRiscv();
+        }
+        sf.rounding_mode = ff.rounding_mode = static_cast<Vfpu::RoundingMode>(rm);
+        sf.VSqrt<FT>(a.data(), d.data(), len);
+        for (size_t i = 0; i < len; ++i)
+          ASSERT_EQ(std::bit_cast<UT>(d[i]), std::bit_cast<UT>(ff.Sqrt<FT>(a[i])))
+              << "Index: " << i << " Value: " << a[i] << " RM: " << rm;
+        ASSERT_EQ(sf.invalid, ff.invalid) << "RM: " << rm;
+        ASSERT_EQ(sf.inexact, ff.inexact) << "RM: " << rm;
+      }
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, VSqrtf32) {
+  TestSqrt<f32>();
+}
+
+TEST(TEST_SUITE_NAME, VSqrtf64) {
+  TestSqrt<f64>();
+}
+
+// Differently configured instances must not share their default NaNs.
+TEST(TEST_SUITE_NAME, PerInstanceQnan) {
+  SimdFloat sf1, sf2;
+  sf1.SetQnan<f32>(0x7fc00001u);
+  sf2.SetQnan<f32>(0xffc00000u);
+  f32 inf = std::numeric_limits<f32>::infinity();
+  f32 av[kSimdLength], bv[kSimdLength], dv1[kSimdLength], dv2[kSimdLength];
+  std::fill_n(av, kSimdLength, inf);
+  std::fill_n(bv, kSimdLength, -inf);
+  sf1.VAdd<f32>(av, bv, dv1, kSimdLength);
+  sf2.VAdd<f32>(av, bv, dv2, kSimdLength);
+  for (size_t i = 0; i < kSimdLength; ++i) {
+    ASSERT_EQ(std::bit_cast<u32>(dv1[i]), 0x7fc00001u) << "Index: " << i;
+    ASSERT_EQ(std::bit_cast<u32>(dv2[i]), 0xffc00000u) << "Index: " << i;
+  }
+}
+
+// The batch version must match the scalar one and raise the union of its flags.
+TEST(TEST_SUITE_NAME, FmaWiden) {
+  constexpr size_t kLen = 1003;
+  std::vector<f16> a(kLen), b(kLen);
+  std::vector<f32> c(kLen), d(kLen);
+  std::mt19937 rng(kRngSeed);
+  for (size_t i = 0; i < kLen; ++i) {
+    a[i] = std::bit_cast<f16>(static_cast<u16>(rng()));
+    b[i] = std::bit_cast<f16>(static_cast<u16>(rng()));
+    c[i] = (i % 3) ? std::bit_cast<f32>(static_cast<u32>(rng())) : static_cast<f32>(i);
+  }
+  SimdFloat sf;
+  FloppyFloat ref;
+  sf.SetupToRiscv();
+  ref.SetupToRiscv();
+  sf.ClearFlags();
+  ref.ClearFlags();
+  sf.VFmaWiden<f16, f32>(a.data(), b.data(), c.data(), d.data(), kLen);
+  for (size_t i = 0; i < kLen; ++i)
+    ASSERT_EQ(std::bit_cast<u32>(d[i]), std::bit_cast<u32>(ref.FmaWiden<f16, f32>(a[i], b[i], c[i]))) << "Index: " << i;
+  ASSERT_EQ(sf.GetFlagsRiscv(), ref.GetFlagsRiscv());
+}
+
+// x86 propagates the payload of the first NaN operand, which must also hold for the vectorized lanes.
+TEST(TEST_SUITE_NAME, NanPropagationX86) {
+  constexpr size_t kLen = 1003;
+  std::vector<f32> a(kLen), b(kLen), c(kLen), d(kLen);
+  std::mt19937 rng(kRngSeed);
+  auto gen = [&]() {
+    u32 bits = rng();
+    return std::bit_cast<f32>((rng() % 3) ? (bits | 0x7f800000u) : bits);  // Mostly NaNs and infinities.
+  };
+  for (size_t i = 0; i < kLen; ++i) {
+    a[i] = gen();
+    b[i] = (i % 5) ? gen() : 0.f;
+    c[i] = gen();
+  }
+  SimdFloat sf;
+  FloppyFloat ref;
+  sf.SetupToX86();
+  ref.SetupToX86();
+  sf.VAdd<f32>(a.data(), b.data(), d.data(), kLen);
+  for (size_t i = 0; i < kLen; ++i)
+    ASSERT_EQ(std::bit_cast<u32>(d[i]), std::bit_cast<u32>(ref.Add<f32>(a[i], b[i]))) << "Index: " << i;
+  sf.VFma<f32>(a.data(), b.data(), c.data(), d.data(), kLen);
+  for (size_t i = 0; i < kLen; ++i)
+    ASSERT_EQ(std::bit_cast<u32>(d[i]), std::bit_cast<u32>(ref.Fma<f32>(a[i], b[i], c[i]))) << "Index: " << i;
+  sf.VSqrt<f32>(a.data(), d.data(), kLen);
+  for (size_t i = 0; i < kLen; ++i)
+    ASSERT_EQ(std::bit_cast<u32>(d[i]), std::bit_cast<u32>(ref.Sqrt<f32>(a[i]))) << "Index: " << i;
+  ASSERT_EQ(sf.GetFlagsX86(), ref.GetFlagsX86());
+}
+
+enum MaskedOp { kMaskedAdd, kMaskedDiv, kMaskedFma };
+
+// Inactive elements must neither raise flags nor be written, unless the policy is agnostic. Elements before vstart are
+// never written, and nothing is written for vstart >= vl, not even the tail. "dest" may alias the first source.
+template <typename FT>
+void CheckMasked(MaskedOp op, const u8* mask, size_t vstart, size_t vl, bool alias) {
+  using UT = typename FloatToUint<FT>::type;
+  constexpr size_t kVlmax = 80;
+  const FT inf = std::numeric_limits<FT>::infinity();
+  const FT ones = std::bit_cast<FT>(~static_cast<UT>(0));
+  std::vector<FT> a(kVlmax), b(kVlmax), c(kVlmax), old(kVlmax);
+  for (size_t i = 0; i < kVlmax; ++i) {
+    // Odd elements raise invalid (∞ - ∞, ∞ / ∞, ∞ · -∞ + ∞) or division by zero (1 / 0) if they are computed.
+    a[i] = (i % 2) ? ((i % 4 == 1) ? inf : static_cast<FT>(1.)) : static_cast<FT>(i);
+    b[i] = (i % 2) ? ((i % 4 == 1) ? -inf : static_cast<FT>(0.)) : static_cast<FT>(3.);
+    c[i] = (i % 2) ? inf : static_cast<FT>(0.25);
+  }
+  for (u8 policy = 0; policy < 4; ++policy) {
+    SimdFloat sf;
+    FloppyFloat ref;
+    std::vector<FT> d(kVlmax, static_cast<FT>(-1.));
+    std::vector<FT> src_a = a;
+    FT* dest = alias ? src_a.data() : d.data();
+    std::copy(dest, dest + kVlmax, old.begin());
+    switch (op) {
+    case kMaskedAdd:
+      sf.VAddMasked<FT>(src_a.data(), b.data(), dest, mask, vstart, vl, kVlmax, policy);
+      break;
+    case kMaskedDiv:
+      sf.VDivMasked<FT>(src_a.data(), b.data(), dest, mask, vstart, vl, kVlmax, policy);
+      break;
+    case kMaskedFma:
+      sf.VFmaMasked<FT>(src_a.data(), b.data(), c.data(), dest, mask, vstart, vl, kVlmax, policy);
+      break;
+    }
+    for (size_t i = 0; i < kVlmax; ++i) {
+      FT expected = old[i];
+      bool body = vstart < vl && i >= vstart && i < vl;
+      bool tail = vstart < vl && i >= vl;
+      bool active = body && (mask == nullptr || ((mask[i / 8] >> (i % 8)) & 1));
+      if (tail) {
+        expected = (policy & SimdFloat::kRvvTailAgnostic) ? ones : old[i];
+      } else if (body && !active) {
+        expected = (policy & SimdFloat::kRvvMaskAgnostic) ? ones : old[i];
+      } else if (!active) {
+        expected = old[i];
+      } else if (op == kMaskedAdd) {
+        expected = ref.Add<FT>(a[i], b[i]);
+      } else if (op == kMaskedDiv) {
+        expected = ref.Div<FT>(a[i], b[i]);
+      } else {
+        expected = ref.Fma<FT>(a[i], b[i], c[i]);
+      }
+      ASSERT_EQ(std::bit_cast<UT>(dest[i]), std::bit_cast<UT>(expected))
+          << "Index: " << i << " Op: " << op << " Policy: " << +policy << " Vstart: " << vstart << " Vl: " << vl
+          << " Mask: " << (mask != nullptr) << " Alias: " << alias;
+    }
+    ASSERT_EQ(sf.GetFlagsRiscv(), ref.GetFlagsRiscv())
+        << "Op: " << op << " Vstart: " << vstart << " Vl: " << vl << " Mask: " << (mask != nullptr);
+  }
+}
+
+template <typename FT>
+void TestMaskedPolicies() {
+  const std::vector<u8> mask(10, 0x55);  // Even elements are active.
+  // The vector widths are powers of two up to 16 elements, so 16 is on a chunk boundary and 3 and 17 are past one.
+  const std::vector<std::pair<size_t, size_t>> ranges = {{0, 29}, {3, 29}, {16, 29}, {17, 69}, {0, 80},
+                                                         {29, 29}, {40, 29}};
+  for (MaskedOp op : {kMaskedAdd, kMaskedDiv, kMaskedFma}) {
+    for (auto [vstart, vl] : ranges) {
+      for (bool alias : {false, true}) {
+        CheckMasked<FT>(op, mask.data(), vstart, vl, alias);
+        CheckMasked<FT>(op, nullptr, vstart, vl, alias);
+        if (::testing::Test::HasFatalFailure())
+          return;
+      }
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, MaskedPoliciesf32) {
+  TestMaskedPolicies<f32>();
+}
+
+TEST(TEST_SUITE_NAME, MaskedPoliciesf64) {
+  TestMaskedPolicies<f64>();
+}
+
+// The batch version must classify like the scalar one, including the NaN kinds.
+template <typename FT>
+void TestClass() {
+  using UT = typename FloatToUint<FT>::type;
+  const std::vector<FT> specials = {
+      static_cast<FT>(0.), -static_cast<FT>(0.), std::numeric_limits<FT>::min(), -std::numeric_limits<FT>::min(),
+      std::numeric_limits<FT>::denorm_min(), std::numeric_limits<FT>::infinity(),
+      -std::numeric_limits<FT>::infinity(), std::numeric_limits<FT>::quiet_NaN(),
+      std::numeric_limits<FT>::signaling_NaN(), std::bit_cast<FT>(std::bit_cast<UT>(std::numeric_limits<FT>::infinity()) | 1),
+      std::numeric_limits<FT>::max(), std::nextafter(std::numeric_limits<FT>::min(), static_cast<FT>(0.))};
+  constexpr size_t kLen = 1003;
+  std::vector<FT> a(kLen);
+  std::vector<u32> d(kLen);
+  std::mt19937_64 rng(kRngSeed);
+  for (size_t i = 0; i < kLen; ++i) {
+    a[i] = (i % 2) ? std::bit_cast<FT>(static_cast<UT>(rng())) : specials[i / 2 % specials.size()];
+    if (i % 4 == 0)
+      a[i] = -a[i];
+  }
+  SimdFloat sf;
+  sf.VClass<FT>(a.data(), d.data(), kLen);
+  for (size_t i = 0; i < kLen; ++i)
+    ASSERT_EQ(d[i], sf.Class<FT>(a[i])) << "Index: " << i;
+}
+
+TEST(TEST_SUITE_NAME, Classf32) {
+  TestClass<f32>();
+}
+
+TEST(TEST_SUITE_NAME, Classf64) {
+  TestClass<f64>();
+}
+
+// Both result layouts must match the scalar compares, including the invalid flag of quiet and signaling compares.
+template <typename FT>
+void TestCompare() {
+  using UT = typename FloatToUint<FT>::type;
+  const std::vector<FT> specials = {
+      static_cast<FT>(0.), -static_cast<FT>(0.), static_cast<FT>(1.), std::numeric_limits<FT>::denorm_min(),
+      std::numeric_limits<FT>::infinity(), -std::numeric_limits<FT>::infinity(), std::numeric_limits<FT>::quiet_NaN(),
+      std::numeric_limits<FT>::signaling_NaN()};
+  constexpr size_t kLen = 1003;
+  std::vector<FT> a(kLen), b(kLen);
+  std::mt19937_64 rng(kRngSeed);
+  for (size_t i = 0; i < kLen; ++i) {
+    a[i] = specials[rng() % specials.size()];
+    b[i] = specials[rng() % specials.size()];
+    if (i % 3 == 0)
+      a[i] = std::bit_cast<FT>(static_cast<UT>(rng()));
+  }
+
+  SimdFloat sf;
+  FloppyFloat ff;
+  auto reference = [&ff](FT x, FT y, SimdFloat::CompareOp op, bool signaling) {
+    bool eq = signaling ? ff.EqSignaling<FT>(x, y) : ff.EqQuiet<FT>(x, y);
+    bool unordered = std::isnan(x) || std::isnan(y);
+    switch (op) {
+    case SimdFloat::kCmpEq:
+      return eq;
+    case SimdFloat::kCmpNe:
+      return !eq;
+    case SimdFloat::kCmpLt:
+      return !unordered && x < y;
+    case SimdFloat::kCmpLe:
+      return !unordered && x <= y;
+    case SimdFloat::kCmpGt:
+      return !unordered && x > y;
+    case SimdFloat::kCmpGe:
+      return !unordered && x >= y;
+    case SimdFloat::kCmpOrd:
+      return !unordered;
+    default:
+      return unordered;
+    }
+  };
+
+  for (int op = SimdFloat::kCmpEq; op <= SimdFloat::kCmpUnord; ++op) {
+    for (bool signaling : {false, true}) {
+      for (size_t len : {kLen, size_t{64}, size_t{5}}) {
+        auto cmp = static_cast<SimdFloat::CompareOp>(op);
+        std::vector<u8> mask(kLen / 8 + 1, 0xa5);
+        std::vector<UT> lanes(kLen);
+        sf.ClearFlags();
+        ff.ClearFlags();
+        sf.VCompareMask<FT>(a.data(), b.data(), mask.data(), len, cmp, signaling);
+        sf.VCompareLanes<FT>(a.data(), b.data(), lanes.data(), len, cmp, signaling);
+        for (size_t i = 0; i < kLen; ++i) {
+          bool bit = (mask[i / 8] >> (i % 8)) & 1;
+          if (i < len) {
+            bool ref = reference(a[i], b[i], cmp, signaling);
+            ASSERT_EQ(bit, ref) << "Index: " << i << " Op: " << op;
+            ASSERT_EQ(lanes[i], ref ? std::numeric_limits<UT>::max() : 0) << "Index: " << i << " Op: " << op;
+          } else {
+            ASSERT_EQ(bit, (0xa5 >> (i % 8)) & 1) << "Index: " << i << " Op: " << op;
+          }
+        }
+        ASSERT_EQ(sf.invalid, ff.invalid) << "Op: " << op;
+
+        sf.VCompareMask<FT>(a.data(), b[1], mask.data(), len, cmp, signaling);
+        for (size_t i = 0; i < len; ++i)
+          ASSERT_EQ((mask[i / 8] >> (i % 8)) & 1, reference(a[i], b[1], cmp, signaling)) << "Index: " << i;
+      }
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, Comparef32) {
+  TestCompare<f32>();
+}
+
+TEST(TEST_SUITE_NAME, Comparef64) {
+  TestCompare<f64>();
+}
+
+// The batch conversions must match the scalar ones for all rounding modes, including values next to the integer bounds
+// and the limits of the x86 profile.
+template <typename FT, typename IT>
+void TestFToI(void (SimdFloat::*vfunc)(FT*, IT*, size_t), IT (FloppyFloat::*func)(FT)) {
+  const FT upper = 2 * static_cast<FT>(static_cast<IT>(1) << (std::numeric_limits<IT>::digits - 1));
+  const FT lower = static_cast<FT>(std::numeric_limits<IT>::min());
+  const std::vector<FT> specials = {
+      static_cast<FT>(0.), -static_cast<FT>(0.), static_cast<FT>(0.5), static_cast<FT>(-0.5), static_cast<FT>(1.5),
+      static_cast<FT>(-2.5), upper, std::nextafter(upper, static_cast<FT>(0.)), upper - static_cast<FT>(0.5),
+      upper - static_cast<FT>(1.5), lower, std::nextafter(lower, -upper), lower - static_cast<FT>(0.5),
+      lower - static_cast<FT>(1.), std::numeric_limits<FT>::infinity(), -std::numeric_limits<FT>::infinity(),
+      std::numeric_limits<FT>::quiet_NaN(), std::numeric_limits<FT>::signaling_NaN()};
+  constexpr size_t kLen = 1003;
+  std::vector<FT> a(kLen);
+  std::vector<IT> d(kLen);
+  std::mt19937_64 rng(kRngSeed);
+  std::uniform_real_distribution<FT> dist(static_cast<FT>(-1.), static_cast<FT>(1.));
+  for (size_t i = 0; i < kLen; ++i) {
+    if (i % 2)
+      a[i] = specials[rng() % specials.size()];
+    else
+      a[i] = std::ldexp(dist(rng), static_cast<int>(rng() % (std::numeric_limits<IT>::digits + 3)));
+  }
+
+  for (bool x86 : {false, true}) {
+    for (int rm = 0; rm < 5; ++rm) {
+      for (size_t len : {kLen, size_t{3}}) {
+        SimdFloat sf;
+        FloppyFloat ff;
+        if (x86) {
+          sf.SetupToX86();
+          ff.SetupToX86();
+        } else {
+          sf.SetupToRiscv();
+          ff.SetupToRiscv();
+        }
+        sf.rounding_mode = ff.rounding_mode = static_cast<Vfpu::RoundingMode>(rm);
+        (sf.*vfunc)(a.data(), d.data(), len);
+        for (size_t i = 0; i < len; ++i)
+          ASSERT_EQ(d[i], (ff.*func)(a[i])) << "Index: " << i << " Value: " << a[i] << " RM: " << rm;
+        ASSERT_EQ(sf.invalid, ff.invalid) << "RM: " << rm;
+        ASSERT_EQ(sf.inexact, ff.inexact) << "RM: " << rm;
+      }
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, F32ToI32) {
+  TestFToI<f32, i32>(&SimdFloat::VF32ToI32, &FloppyFloat::F32ToI32);
+}
+
+TEST(TEST_SUITE_NAME, F32ToU32) {
+  TestFToI<f32, u32>(&SimdFloat::VF32ToU32, &FloppyFloat::F32ToU32);
+}
+
+TEST(TEST_SUITE_NAME, F64ToI32) {
+  TestFToI<f64, i32>(&SimdFloat::VF64ToI32, &FloppyFloat::F64ToI32);
+}
+
+TEST(TEST_SUITE_NAME, F64ToU32) {
+  TestFToI<f64, u32>(&SimdFloat::VF64ToU32, &FloppyFloat::F64ToU32);
+}
+
+TEST(TEST_SUITE_NAME, F64ToI64) {
+  TestFToI<f64, i64>(&SimdFloat::VF64ToI64, &FloppyFloat::F64ToI64);
+}
+
+TEST(TEST_SUITE_NAME, F64ToU64) {
+  TestFToI<f64, u64>(&SimdFloat::VF64ToU64, &FloppyFloat::F64ToU64);
+}
+
+template <typename IT>
+void TestIToF32(void (SimdFloat::*vfunc)(IT*, f32*, size_t), f32 (FloppyFloat::*func)(IT)) {
+  constexpr size_t kLen = 1003;
+  std::vector<IT> a(kLen);
+  std::vector<f32> d(kLen);
+  std::mt19937_64 rng(kRngSeed);
+  for (size_t i = 0; i < kLen; ++i)
+    a[i] = static_cast<IT>(rng() >> (rng() % 64));
+  a[0] = std::numeric_limits<IT>::max();
+  a[1] = std::numeric_limits<IT>::min();
+  a[2] = static_cast<IT>(0x1000001);  // Tie for round to nearest.
+
+  for (int rm = 0; rm < 5; ++rm) {
+    SimdFloat sf;
+    FloppyFloat ff;
+    sf.rounding_mode = ff.rounding_mode = static_cast<Vfpu::RoundingMode>(rm);
+    (sf.*vfunc)(a.data(), d.data(), kLen);
+    for (size_t i = 0; i < kLen; ++i)
+      ASSERT_EQ(std::bit_cast<u32>(d[i]), std::bit_cast<u32>((ff.*func)(a[i]))) << "Index: " << i << " RM: " << rm;
+    ASSERT_EQ(sf.inexact, ff.inexact) << "RM: " << rm;
+  }
+}
+
+TEST(TEST_SUITE_NAME, I32ToF32) {
+  TestIToF32<i32>(&SimdFloat::VI32ToF32, &FloppyFloat::I32ToF32);
+}
+
+TEST(TEST_SUITE_NAME, U32ToF32) {
+  TestIToF32<u32>(&SimdFloat::VU32ToF32, &FloppyFloat::U32ToF32);
+}
+
+// Scalar model of the reduction shapes (see SimdFloat::ReduceShape).
+template <typename FT>
+FT ReduceSumReference(FloppyFloat& ff, std::vector<FT> v, FT init, SimdFloat::ReduceShape shape) {
+  if (shape == SimdFloat::kReduceOrdered) {
+    for (FT x : v)
+      init = ff.Add<FT>(init, x);
+    return init;
+  }
+  if (v.empty())
+    return init;
+  while (v.size() > 1) {
+    size_t half = (v.size() + 1) / 2;
+    std::vector<FT> next(half);
+    for (size_t i = 0; i < v.size() / 2; ++i)
+      next[i] = shape == SimdFloat::kReducePairwise ? ff.Add<FT>(v[2 * i], v[2 * i + 1]) : ff.Add<FT>(v[i], v[i + half]);
+    if (v.size() % 2)
+      next[half - 1] = shape == SimdFloat::kReducePairwise ? v.back() : v[half - 1];
+    v = next;
+  }
+  return ff.Add<FT>(init, v[0]);
+}
+
+// The reductions must match the scalar model bit by bit, including the flags, for all shapes, rounding modes and
+// profiles. The inputs are mostly inexact sums, optionally with exact ones, overflows, infinities, or NaNs.
+template <typename FT>
+void TestReduce() {
+  using UT = typename FloatToUint<FT>::type;
+  constexpr size_t kLen = 1003;
+  std::mt19937_64 rng(kRngSeed);
+  std::uniform_real_distribution<FT> dist(static_cast<FT>(-1.), static_cast<FT>(1.));
+  std::vector<std::vector<FT>> inputs(5, std::vector<FT>(kLen));
+  for (size_t i = 0; i < kLen; ++i) {
+    inputs[0][i] = std::ldexp(dist(rng), static_cast<int>(rng() % 40) - 20);
+    inputs[1][i] = static_cast<FT>(static_cast<int>(rng() % 201) - 100);
+    inputs[2][i] = (i % 7) ? std::numeric_limits<FT>::max() / 4 : static_cast<FT>(i % 2 ? 0. : -0.);
+    inputs[3][i] = inputs[0][i];
+    inputs[4][i] = inputs[1][i];
+  }
+  inputs[3][500] = std::numeric_limits<FT>::infinity();
+  inputs[3][900] = -std::numeric_limits<FT>::infinity();
+  inputs[4][5] = std::numeric_limits<FT>::signaling_NaN();
+  inputs[4][800] = std::numeric_limits<FT>::quiet_NaN();
+
+  for (bool x86 : {false, true}) {
+    for (int rm = 0; rm < 5; ++rm) {
+      for (const auto& in : inputs) {
+        for (size_t len : {kLen, size_t{64}, size_t{5}, size_t{1}, size_t{0}}) {
+          for (int shape = SimdFloat::kReduceOrdered; shape <= SimdFloat::kReduceHalving; ++shape) {
+            SimdFloat sf;
+            FloppyFloat ff;
+            if (x86) {
+              sf.SetupToX86();
+              ff.SetupToX86();
+            } else {
+              sf.SetupToRiscv();
+              ff.SetupToRiscv();
+            }
+            sf.rounding_mode = ff.rounding_mode = static_cast<Vfpu::RoundingMode>(rm);
+            auto s = static_cast<SimdFloat::ReduceShape>(shape);
+            std::vector<FT> a(in.begin(), in.begin() + len);
+            FT init = static_cast<FT>(0.25);
+            FT res = sf.VReduceSum<FT>(a.data(), len, init, s);
+            FT ref = ReduceSumReference<FT>(ff, a, init, s);
+            ASSERT_EQ(std::bit_cast<UT>(res), std::bit_cast<UT>(ref)) << "Shape: " << shape << " RM: " << rm;
+            ASSERT_EQ(sf.inexact, ff.inexact) << "Shape: " << shape << " RM: " << rm << " Len: " << len;
+            ASSERT_EQ(sf.overflow, ff.overflow) << "Shape: " << shape << " RM: " << rm << " Len: " << len;
+            ASSERT_EQ(sf.invalid, ff.invalid) << "Shape: " << shape << " RM: " << rm << " Len: " << len;
+          }
+        }
+      }
+    }
+  }
+
+  // Maximum and minimum, with -0/+0 and NaNs at every position of a chunk.
+  std::vector<FT> a = inputs[1];
+  for (size_t i = 0; i < kLen; i += 11)
+    a[i] = (i % 3) ? std::numeric_limits<FT>::quiet_NaN() : -static_cast<FT>(0.);
+  a[77] = std::numeric_limits<FT>::signaling_NaN();
+  std::vector<FT> nans(kLen, std::numeric_limits<FT>::quiet_NaN());
+  for (const auto& in : {a, nans, inputs[0]}) {
+    for (size_t len : {kLen, size_t{64}, size_t{5}, size_t{0}}) {
+      for (FT init : {static_cast<FT>(0.), std::numeric_limits<FT>::quiet_NaN()}) {
+        SimdFloat sf;
+        FloppyFloat ff;
+        FT max = init;
+        FT min = init;
+        for (size_t i = 0; i < len; ++i) {
+          max = ff.MaximumNumber<FT>(max, in[i]);
+          min = ff.MinimumNumber<FT>(min, in[i]);
+        }
+        std::vector<FT> b(in);
+        ASSERT_EQ(std::bit_cast<UT>(sf.VReduceMaxNumber<FT>(b.data(), len, init)), std::bit_cast<UT>(max));
+        ASSERT_EQ(std::bit_cast<UT>(sf.VReduceMinNumber<FT>(b.data(), len, init)), std::bit_cast<UT>(min));
+        ASSERT_EQ(sf.invalid, ff.invalid);
+      }
+    }
+  }
+}
+
+TEST(TEST_SUITE_NAME, Reducef32) {
+  TestReduce<f32>();
+}
+
+TEST(TEST_SUITE_NAME, Reducef64) {
+  TestReduce<f64>();
+}
 
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
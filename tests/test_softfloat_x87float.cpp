@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * Apache License, Version 2.0
+ * Copyright (c) 2025 chciken/Niko Zurstraßen
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "float_rng.h"
+#include "x87_float.h"
+
+extern "C" {
+#include "softfloat.h"
+}
+
+using namespace std::placeholders;
+using namespace FfUtils;
+
+constexpr i32 kNumIterations = 100000;
+constexpr i32 kRngSeed = 42;
+
+X87Float ff;
+
+std::array<std::pair<uint_fast8_t, Vfpu::RoundingMode>, 5> rounding_modes{
+    {{::softfloat_round_near_even, Vfpu::RoundingMode::kRoundTiesToEven},
+     {::softfloat_round_near_maxMag, Vfpu::RoundingMode::kRoundTiesToAway},
+     {::softfloat_round_max, Vfpu::RoundingMode::kRoundTowardPositive},
+     {::softfloat_round_min, Vfpu::RoundingMode::kRoundTowardNegative},
+     {::softfloat_round_minMag, Vfpu::RoundingMode::kRoundTowardZero}}};
+
+std::array<std::pair<uint_fast8_t, X87Float::PrecisionControl>, 3> precisions{
+    {{32, X87Float::kPrecision24}, {64, X87Float::kPrecision53}, {80, X87Float::kPrecision64}}};
+
+// Generates valid x87 encodings, i.e., the integer bit is set iff the exponent is non-zero.
+// Berkeley SoftFloat does not reject unnormals, pseudo-infinities, and pseudo-NaNs like the x87 does.
+class F80Rng {
+ public:
+  F80Rng(int seed) : index_(0), engine_(seed), values_() {
+    constexpr u64 kI = 0x8000000000000000ull;
+    for (u16 sign : {0, 0x8000}) {
+      values_.push_back({0, sign});                            // Zero
+      values_.push_back({kI, static_cast<u16>(sign | 0x7fff)});  // Infinity
+      values_.push_back({0xc000000000000000ull, static_cast<u16>(sign | 0x7fff)});  // qNaN
+      values_.push_back({0xa000000000000000ull, static_cast<u16>(sign | 0x7fff)});  // sNaN
+      values_.push_back({kI, static_cast<u16>(sign | 0x3fff)});                     // 1.0
+      values_.push_back({~0ull, static_cast<u16>(sign | 0x7ffe)});                  // Max
+      values_.push_back({kI, static_cast<u16>(sign | 0x0001)});                     // Min normal
+      values_.push_back({1, sign});                                                 // Min denormal
+      values_.push_back({kI, static_cast<u16>(sign | (0x3fff + 31))});              // 2^31
+      values_.push_back({kI, static_cast<u16>(sign | (0x3fff + 63))});              // 2^63
+    }
+  }
+
+  f80 Gen() {
+    if (index_ < values_.size())
+      return values_[index_++];
+    u16 sign = (engine_() & 1) ? 0x8000 : 0;
+    u64 sig = engine_();
+    i32 exp;
+    switch (engine_() % 8) {
+    case 0:
+      exp = 0;  // Denormal
+      break;
+    case 1:
+      exp = engine_() % 80;  // Results around the denormal range
+      break;
+    case 2:
+      exp = 0x7ffe - (engine_() % 80);  // Results around overflow
+      break;
+    case 3:
+      exp = 0x3fff - 24 + (engine_() % 48);  // Integer conversions
+      break;
+    case 4:
+      sig &= ~((1ull << (engine_() % 64)) - 1);  // Few significant bits, exact results
+      [[fallthrough]];
+    default:
+      exp = 0x3fff - 64 + (engine_() % 128);
+      break;
+    }
+    if (exp == 0)
+      sig &= ~0x8000000000000000ull;
+    else
+      sig |= 0x8000000000000000ull;
+    return {sig, static_cast<u16>(sign | exp)};
+  }
+
+ private:
+  size_t index_;
+  std::mt19937_64 engine_;
+  std::vector<f80> values_;
+};
+
+struct F80Bits {
+  u64 significand;
+  u16 sign_exponent;
+  bool operator==(const F80Bits&) const = default;
+  friend std::ostream& operator<<(std::ostream& os, const F80Bits& a) {
+    return os << std::hex << a.sign_exponent << ":" << std::setw(16) << std::setfill('0') << a.significand
+              << std::setfill(' ') << std::dec;
+  }
+};
+
+template <typename T>
+auto ToComparableType(T a) {
+  if constexpr (std::is_same_v<decltype(a), f80>) {
+    return F80Bits{a.significand, a.sign_exponent};
+  } else if constexpr (std::is_same_v<decltype(a), extFloat80_t>) {
+    return F80Bits{a.signif, a.signExp};
+  } else if constexpr (std::is_floating_point<decltype(a)>::value) {
+    return std::bit_cast<typename FloatToUint<T>::type>(a);
+  } else if constexpr (std::is_same_v<decltype(a), float32_t>) {
+    return a.v;
+  } else if constexpr (std::is_same_v<decltype(a), float64_t>) {
+    return a.v;
+  } else {
+    return a;
+  }
+}
+
+extFloat80_t ToSf(f80 a) {
+  extFloat80_t r;
+  r.signif = a.significand;
+  r.signExp = a.sign_exponent;
+  return r;
+}
+
+template <typename T1, typename T2>
+void CheckResult(T1 ff_result_u, T2 sf_result_u, size_t i) {
+  ASSERT_EQ(ff_result_u, sf_result_u)
+    << "Iteration: " << i << ", FF result:" << ff_result_u << ", SF result:" << sf_result_u;
+  ASSERT_EQ(ff.invalid, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_invalid))
+    << "Iteration: " << i << ", FF result:" << ff_result_u << ", SF result:" << sf_result_u;
+  ASSERT_EQ(ff.division_by_zero, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_infinite))
+    << "Iteration: " << i << ", FF result:" << ff_result_u << ", SF result:" << sf_result_u;
+  ASSERT_EQ(ff.overflow, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_overflow))
+    << "Iteration: " << i << ", FF result:" << ff_result_u << ", SF result:" << sf_result_u;
+  ASSERT_EQ(ff.underflow, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_underflow))
+    << "Iteration: " << i << ", FF result:" << ff_result_u << ", SF result:" << sf_result_u;
+  ASSERT_EQ(ff.inexact, static_cast<bool>(::softfloat_exceptionFlags & ::softfloat_flag_inexact))
+    << "Iteration: " << i << ", FF result:" << ff_result_u << ", SF result:" << sf_result_u;
+}
+
+// Berkeley SoftFloat does not model the denormal operand exception and C1; they are covered by the golden tests.
+template <typename FFFUNC, typename SFFUNC, int num_args>
+void DoTest(FFFUNC ff_func, SFFUNC sf_func) {
+  ::softfloat_exceptionFlags = 0;
+  ff.ClearFlags();
+
+  F80Rng f80_rng(kRngSeed);
+  f80 valuefa{f80_rng.Gen()};
+  f80 valuefb{f80_rng.Gen()};
+
+  for (i32 i = 0; i < kNumIterations; ++i) {
+    if constexpr (num_args == 1) {
+      auto ff_result = ff_func(valuefa);
+      auto sf_result = sf_func(ToSf(valuefa));
+      CheckResult(ToComparableType(ff_result), ToComparableType(sf_result), i);
+    }
+    if constexpr (num_args == 2) {
+      auto ff_result = ff_func(valuefa, valuefb);
+      auto sf_result = sf_func(ToSf(valuefa), ToSf(valuefb));
+      CheckResult(ToComparableType(ff_result), ToComparableType(sf_result), i);
+    }
+
+    ::softfloat_exceptionFlags = 0;
+    ff.ClearFlags();
+
+    valuefb = valuefa;
+    valuefa = f80_rng.Gen();
+  }
+}
+
+template <typename FT, typename SFT, typename FFFUNC, typename SFFUNC>
+void DoTestToF80(FFFUNC ff_func, SFFUNC sf_func) {
+  ::softfloat_exceptionFlags = 0;
+  ff.ClearFlags();
+
+  FloatRng<FT> float_rng(kRngSeed);
+  for (i32 i = 0; i < kNumIterations; ++i) {
+    FT a = float_rng.Gen();
+    auto ff_result = ff_func(a);
+    auto sf_result = sf_func(std::bit_cast<SFT>(a));
+    CheckResult(ToComparableType(ff_result), ToComparableType(sf_result), i);
+    ::softfloat_exceptionFlags = 0;
+    ff.ClearFlags();
+  }
+}
+
+#define TEST_SUITE_NAME SoftFloatX87FloatTests
+
+#define TEST_MACRO_BASE(name, ff_op, sf_op, rm, rm_name, pc, pc_name, nargs, ...) \
+  TEST(TEST_SUITE_NAME, name##rm_name##pc_name) {                                 \
+    ff.SetupToX86();                                                              \
+    ::softfloat_roundingMode = rounding_modes[rm].first;                          \
+    ff.rounding_mode = rounding_modes[rm].second;                                 \
+    ::extF80_roundingPrecision = precisions[pc].first;                            \
+    ff.precision_control = precisions[pc].second;                                 \
+    auto ff_func = std::bind(ff_op, &ff, __VA_ARGS__);                            \
+    auto sf_func = std::bind(&::sf_op, __VA_ARGS__);                              \
+    DoTest<decltype(ff_func), decltype(sf_func), nargs>(ff_func, sf_func);        \
+  }
+
+#define TEST_MACRO_1(name, ff_op, sf_op, rm, rm_name, pc, pc_name) \
+  TEST_MACRO_BASE(name, ff_op, sf_op, rm, rm_name, pc, pc_name, 1, _1)
+#define TEST_MACRO_2(name, ff_op, sf_op, rm, rm_name, pc, pc_name) \
+  TEST_MACRO_BASE(name, ff_op, sf_op, rm, rm_name, pc, pc_name, 2, _1, _2)
+
+#define TEST_MACRO_ALL_RM(macro, name, ff_op, sf_op, pc, pc_name)   \
+  macro(name, ff_op, sf_op, 0, RoundTiesToEven, pc, pc_name)        \
+  macro(name, ff_op, sf_op, 1, RoundTiesToAway, pc, pc_name)        \
+  macro(name, ff_op, sf_op, 2, RoundTowardPositive, pc, pc_name)    \
+  macro(name, ff_op, sf_op, 3, RoundTowardNegative, pc, pc_name)    \
+  macro(name, ff_op, sf_op, 4, RoundTowardZero, pc, pc_name)
+
+#define TEST_MACRO_ALL(macro, name, ff_op, sf_op)                 \
+  TEST_MACRO_ALL_RM(macro, name, ff_op, sf_op, 0, Precision24)    \
+  TEST_MACRO_ALL_RM(macro, name, ff_op, sf_op, 1, Precision53)    \
+  TEST_MACRO_ALL_RM(macro, name, ff_op, sf_op, 2, Precision64)
+
+TEST_MACRO_ALL(TEST_MACRO_2, Addf80, static_cast<f80 (X87Float::*)(f80, f80)>(&X87Float::Add), extF80_add)
+TEST_MACRO_ALL(TEST_MACRO_2, Subf80, static_cast<f80 (X87Float::*)(f80, f80)>(&X87Float::Sub), extF80_sub)
+TEST_MACRO_ALL(TEST_MACRO_2, Mulf80, static_cast<f80 (X87Float::*)(f80, f80)>(&X87Float::Mul), extF80_mul)
+TEST_MACRO_ALL(TEST_MACRO_2, Divf80, static_cast<f80 (X87Float::*)(f80, f80)>(&X87Float::Div), extF80_div)
+TEST_MACRO_ALL(TEST_MACRO_1, Sqrtf80, static_cast<f80 (X87Float::*)(f80)>(&X87Float::Sqrt), extF80_sqrt)
+
+// Stores round to the destination format, so precision control does not matter.
+TEST_MACRO_ALL_RM(TEST_MACRO_1, F80ToF32, static_cast<f32 (X87Float::*)(f80)>(&X87Float::F80ToF32), extF80_to_f32,
+                  2, Precision64)
+TEST_MACRO_ALL_RM(TEST_MACRO_1, F80ToF64, static_cast<f64 (X87Float::*)(f80)>(&X87Float::F80ToF64), extF80_to_f64,
+                  2, Precision64)
+
+#define TEST_MACRO_FTOI(name, ff_op, sf_op, rm, rm_name, pc, pc_name)                                  \
+  TEST(TEST_SUITE_NAME, name##rm_name) {                                                               \
+    ff.SetupToX86();                                                                                   \
+    ::softfloat_roundingMode = rounding_modes[rm].first;                                               \
+    ff.rounding_mode = rounding_modes[rm].second;                                                      \
+    auto ff_func = std::bind(ff_op, &ff, _1);                                                          \
+    auto sf_func = std::bind(&::sf_op, _1, ::softfloat_roundingMode, true);                            \
+    DoTest<decltype(ff_func), decltype(sf_func), 1>(ff_func, sf_func);                                 \
+  }
+
+TEST_MACRO_ALL_RM(TEST_MACRO_FTOI, F80ToI32, static_cast<i32 (X87Float::*)(f80)>(&X87Float::F80ToI32), extF80_to_i32,
+                  2, Precision64)
+TEST_MACRO_ALL_RM(TEST_MACRO_FTOI, F80ToI64, static_cast<i64 (X87Float::*)(f80)>(&X87Float::F80ToI64), extF80_to_i64,
+                  2, Precision64)
+
+TEST(TEST_SUITE_NAME, F32ToF80) {
+  ff.SetupToX86();
+  DoTestToF80<f32, float32_t>(std::bind(&X87Float::F32ToF80, &ff, _1), &::f32_to_extF80);
+}
+
+TEST(TEST_SUITE_NAME, F64ToF80) {
+  ff.SetupToX86();
+  DoTestToF80<f64, float64_t>(std::bind(&X87Float::F64ToF80, &ff, _1), &::f64_to_extF80);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}